@@ -138,6 +138,12 @@ static uint32_t get_cpu_features_real()
    if (out[1] & 1<<18) feat |= CPU_FEAT_RDSEED;
    if (out[1] & 1<<19) feat |= CPU_FEAT_ADX;
    if (out[1] & 1<<29) feat |= CPU_FEAT_SHA;
+   /* opmask and upper zmm state must be enabled too */
+   if ((xcr0 & 0xE6) == 0xE6)
+   {
+    if (out[1] & 1<<16) feat |= CPU_FEAT_AVX512F;
+    if (out[1] & 1<<21) feat |= CPU_FEAT_AVX512IFMA;
+   }
   }
  }
 #elif defined(FEATURES_DEF)
@@ -22,6 +22,8 @@ enum
  CPU_FEAT_RDSEED    = 0x00002000,
  CPU_FEAT_ADX       = 0x00004000,
  CPU_FEAT_SHA       = 0x00008000,
+ CPU_FEAT_AVX512F   = 0x00010000,
+ CPU_FEAT_AVX512IFMA = 0x00020000,
  /* arm */
  CPU_FEAT_UMAAL     = 0x00100000,
  CPU_FEAT_EDSP      = 0x00200000,
@@ -1,7 +1,11 @@
 #include "curves_wei.h"
+#include "ec_weij.h"
+#include "ec_wei_fe.h"
 #include <crypto/oid_const.h>
 #include <platform/endian.h>
+#include <utils/mutex.h>
 #include <string.h>
+#include <vector>
 
 using namespace oid;
 
@@ -195,6 +199,51 @@ static const uint8_t secp256k1_n[] =
  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
 };
 
+// secp256k1 endomorphism: beta^3 = 1 mod p,
+// lattice basis (a1, -b1), (a2, a1), g1 = round(2^384*a1/n), g2 = round(2^384*b1/n)
+static const uint8_t secp256k1_glv_beta[] =
+{
+ 0xEE, 0x01, 0x95, 0x71, 0x28, 0x6C, 0x39, 0xC1,
+ 0x95, 0x89, 0xF5, 0x12, 0x75, 0x49, 0xF0, 0x9C,
+ 0xE9, 0x34, 0x34, 0xAC, 0x9E, 0x47, 0x64, 0x6E,
+ 0x10, 0x07, 0x7C, 0x65, 0x2B, 0x6A, 0xE9, 0x7A
+};
+
+static const uint8_t secp256k1_glv_a1[] =
+{
+ 0x15, 0xEB, 0x84, 0x92, 0xE4, 0x90, 0x6C, 0xE8,
+ 0xCD, 0x6B, 0xD4, 0xA7, 0x21, 0xD2, 0x86, 0x30
+};
+
+static const uint8_t secp256k1_glv_b1[] =
+{
+ 0xC3, 0xE4, 0xBF, 0x0A, 0xA9, 0x7F, 0x54, 0x6F,
+ 0x28, 0x88, 0x0E, 0x01, 0xD6, 0x7E, 0x43, 0xE4
+};
+
+static const uint8_t secp256k1_glv_a2[] =
+{
+ 0xD8, 0xCF, 0x44, 0x9D, 0x8D, 0x10, 0xC1, 0x57,
+ 0xF6, 0xF3, 0xE2, 0xA8, 0xF7, 0x50, 0xCA, 0x14,
+ 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+static const uint8_t secp256k1_glv_g1[] =
+{
+ 0x31, 0xB0, 0xDB, 0x45, 0x9A, 0x20, 0x93, 0xE8,
+ 0x7F, 0xCA, 0xE8, 0x71, 0x14, 0x8A, 0xAA, 0x3D,
+ 0x15, 0xEB, 0x84, 0x92, 0xE4, 0x90, 0x6C, 0xE8,
+ 0xCD, 0x6B, 0xD4, 0xA7, 0x21, 0xD2, 0x86, 0x30
+};
+
+static const uint8_t secp256k1_glv_g2[] =
+{
+ 0x71, 0x7F, 0xC4, 0x8A, 0xAE, 0xB4, 0x71, 0x15,
+ 0xC6, 0x06, 0xF5, 0x9D, 0xAC, 0x08, 0x12, 0x22,
+ 0xC4, 0xE4, 0xBF, 0x0A, 0xA9, 0x7F, 0x54, 0x6F,
+ 0x28, 0x88, 0x0E, 0x01, 0xD6, 0x7E, 0x43, 0xE4
+};
+
 // secp256r1 aka prime256v1 aka NIST P-256
 static const uint8_t secp256r1_p[] =
 {
@@ -419,3 +468,435 @@ void init_curve(ec_wei_def_t *def, ec_point_t *g, bigint_t *pn, const curve_wei
   ec_wei_def_init_small_a(def, p, params->a_small, b);
  ec_wei_point_init_values(g, def, x, y);
 }
+
+static ec_glv_def_t *create_glv(const curve_context *ctx)
+{
+ if (ctx->params->id != ID_SECP256K1) return nullptr;
+ ec_glv_def_t *glv = new ec_glv_def_t;
+ glv->n = bigint_create(0);
+ bigint_copy(glv->n, ctx->order);
+ glv->beta = create_static_bigint(secp256k1_glv_beta, sizeof(secp256k1_glv_beta));
+ glv->a1 = create_static_bigint(secp256k1_glv_a1, sizeof(secp256k1_glv_a1));
+ glv->b1 = create_static_bigint(secp256k1_glv_b1, sizeof(secp256k1_glv_b1));
+ bigint_set_sign(glv->b1, 1);
+ glv->a2 = create_static_bigint(secp256k1_glv_a2, sizeof(secp256k1_glv_a2));
+ glv->b2 = create_static_bigint(secp256k1_glv_a1, sizeof(secp256k1_glv_a1));
+ glv->g1 = create_static_bigint(secp256k1_glv_g1, sizeof(secp256k1_glv_g1));
+ glv->g2 = create_static_bigint(secp256k1_glv_g2, sizeof(secp256k1_glv_g2));
+ glv->shift = 384;
+ return glv;
+}
+
+static void destroy_glv(ec_glv_def_t *glv)
+{
+ bigint_destroy(glv->n);
+ bigint_destroy(glv->beta);
+ bigint_destroy(glv->a1);
+ bigint_destroy(glv->b1);
+ bigint_destroy(glv->a2);
+ bigint_destroy(glv->b2);
+ bigint_destroy(glv->g1);
+ bigint_destroy(glv->g2);
+ delete glv;
+}
+
+// Montgomery parameters of the Koblitz primes: n0 = -1/p mod 2^64, r2 = 2^(128N) mod p
+struct secp192k1_mont
+{
+ enum { N = 3 };
+ static const uint64_t n0 = 0xF27AE55B7446D879;
+ static const uint64_t *p()
+ {
+  static const uint64_t v[N] = { 0xFFFFFFFEFFFFEE37, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF };
+  return v;
+ }
+ static const uint64_t *r2()
+ {
+  static const uint64_t v[N] = { 0x00002392013C4FD1, 0x0000000000000001, 0x0000000000000000 };
+  return v;
+ }
+};
+
+struct secp224k1_mont
+{
+ enum { N = 4 };
+ static const uint64_t n0 = 0x5A92A00A198D139B;
+ static const uint64_t *p()
+ {
+  static const uint64_t v[N] = { 0xFFFFFFFEFFFFE56D, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0x00000000FFFFFFFF };
+  return v;
+ }
+ static const uint64_t *r2()
+ {
+  static const uint64_t v[N] = { 0x0000000000000000, 0x0000352602C23069, 0x0000000000000001, 0x0000000000000000 };
+  return v;
+ }
+};
+
+struct secp256k1_mont
+{
+ enum { N = 4 };
+ static const uint64_t n0 = 0xD838091DD2253531;
+ static const uint64_t *p()
+ {
+  static const uint64_t v[N] = { 0xFFFFFFFEFFFFFC2F, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF };
+  return v;
+ }
+ static const uint64_t *r2()
+ {
+  static const uint64_t v[N] = { 0x000007A2000E90A1, 0x0000000000000001, 0x0000000000000000, 0x0000000000000000 };
+  return v;
+ }
+};
+
+template<class R, int A>
+struct fast_curve
+{
+ typedef ec_fe::field<R> F;
+ typedef ec_fe::curve<F, A> C;
+
+ static bool mul_base_ct(bigint_t x, bigint_t y, const bigint_t k, const curve_context *ctx)
+ {
+  typename C::point g, r;
+  typename F::elem ax, ay;
+  uint64_t limbs[F::N];
+  if (bigint_get_sign(k) || !F::get_limbs(limbs, k)) return false;
+  if (!C::load_affine(g, &ctx->gen)) return false;
+  C::mul_ct(r, g, limbs, bigint_get_bit_count(ctx->order));
+  memset(limbs, 0, sizeof(limbs));
+  if (!C::to_affine(ax, ay, r)) return false;
+  F::store(x, ax);
+  if (y) F::store(y, ay);
+  return true;
+ }
+
+ static bool mul_base_ct_batch(ec_point_t *r, const bigint_t *k, size_t count, const curve_context *ctx)
+ {
+  typename C::point g;
+  typename F::elem zi, zi2, t;
+  uint64_t limbs[F::N];
+  bool result = false;
+  if (!count) return true;
+  if (!C::load_affine(g, &ctx->gen)) return false;
+  typename C::point *p = new typename C::point[count];
+  // c[i] = z[0]*...*z[i]
+  typename F::elem *c = new typename F::elem[count];
+  size_t i;
+  for (i = 0; i < count; i++)
+  {
+   if (bigint_get_sign(k[i]) || !F::get_limbs(limbs, k[i])) break;
+   C::mul_ct(p[i], g, limbs, bigint_get_bit_count(ctx->order));
+   if (i) F::mul(c[i], c[i-1], p[i].z); else c[0] = p[0].z;
+  }
+  memset(limbs, 0, sizeof(limbs));
+  if (i == count && !F::is_zero(c[count-1]))
+  {
+   F::inv(zi, c[count-1]);
+   for (i = count-1; ; i--)
+   {
+    if (i) F::mul(t, zi, c[i-1]); else t = zi;
+    F::mul(zi, zi, p[i].z);
+    F::sqr(zi2, t);
+    F::mul(p[i].x, p[i].x, zi2);
+    F::mul(zi2, zi2, t);
+    F::mul(p[i].y, p[i].y, zi2);
+    F::store(r[i].x, p[i].x);
+    F::store(r[i].y, p[i].y);
+    bigint_set_word(r[i].z, 1);
+    if (!i) break;
+   }
+   result = true;
+  }
+  memset(p, 0, count*sizeof(p[0]));
+  memset(c, 0, count*sizeof(c[0]));
+  delete[] c;
+  delete[] p;
+  return result;
+ }
+
+ static bool store(ec_point_t *r, const typename C::point &a)
+ {
+  if (F::is_zero(a.z)) return false;
+  F::store(r->x, a.x);
+  F::store(r->y, a.y);
+  F::store(r->z, a.z);
+  return true;
+ }
+
+ static bool mul2(ec_point_t *res, const bigint_t u1, const ec_point_t *q, const bigint_t u2, const curve_context *ctx)
+ {
+  typename C::point g, pq, r;
+  uint64_t k1[F::N], k2[F::N];
+  if (bigint_get_sign(u1) || bigint_get_sign(u2)) return false;
+  if (!(F::get_limbs(k1, u1) && F::get_limbs(k2, u2))) return false;
+  if (!(C::load_affine(g, &ctx->gen) && C::load_affine(pq, q))) return false;
+  C::mul2(r, g, k1, pq, k2);
+  return store(res, r);
+ }
+
+ static const curve_fast_ops ops;
+};
+
+template<class R, int A>
+const curve_fast_ops fast_curve<R, A>::ops = { mul_base_ct, mul_base_ct_batch, mul2 };
+
+// Curves with the GLV endomorphism (ctx->glv) split both scalars of mul2
+// into half-size parts, so the four products share half as many doublings
+template<class R>
+struct fast_curve_glv: public fast_curve<R, 0>
+{
+ typedef typename fast_curve<R, 0>::F F;
+ typedef typename fast_curve<R, 0>::C C;
+
+ // k*a[0] = k1*a[0] + k2*phi(a[0]); sets a[1] = phi(a[0]), |k1| and |k2|
+ // go to the limbs and their signs to the points
+ static bool split(typename C::point *a, uint64_t *k1, uint64_t *k2, const bigint_t k,
+                   const typename F::elem &beta, const ec_glv_def_t *glv, ec_scratch_t *s)
+ {
+  bigint_t v1 = s->v[4], v2 = s->v[5]; // ec_wei_glv_split uses v[0..3]
+  ec_wei_glv_split(v1, v2, k, glv, s);
+  if (!(F::get_limbs(k1, v1) && F::get_limbs(k2, v2))) return false;
+  F::mul(a[1].x, a[0].x, beta);
+  a[1].y = a[0].y;
+  a[1].z = a[0].z;
+  if (bigint_get_sign(v1)) F::neg(a[0].y, a[0].y);
+  if (bigint_get_sign(v2)) F::neg(a[1].y, a[1].y);
+  return true;
+ }
+
+ static bool mul2(ec_point_t *res, const bigint_t u1, const ec_point_t *q, const bigint_t u2, const curve_context *ctx)
+ {
+  typename C::point a[4], r;
+  typename F::elem beta;
+  uint64_t k[4][F::N];
+  const uint64_t *kp[4] = { k[0], k[1], k[2], k[3] };
+  if (bigint_get_sign(u1) || bigint_get_sign(u2)) return false;
+  if (bigint_cmp(u1, ctx->order) >= 0 || bigint_cmp(u2, ctx->order) >= 0) return false;
+  if (!(C::load_affine(a[0], &ctx->gen) && C::load_affine(a[2], q) && F::load(beta, ctx->glv->beta))) return false;
+  wei_scratch scratch(ctx);
+  if (!(split(a, k[0], k[1], u1, beta, ctx->glv, scratch.get()) &&
+        split(a + 2, k[2], k[3], u2, beta, ctx->glv, scratch.get()))) return false;
+  C::mul_multi(r, a, kp, 4);
+  return fast_curve<R, 0>::store(res, r);
+ }
+
+ static const curve_fast_ops ops;
+};
+
+template<class R>
+const curve_fast_ops fast_curve_glv<R>::ops = { fast_curve<R, 0>::mul_base_ct, fast_curve<R, 0>::mul_base_ct_batch, mul2 };
+
+// P-256 has its own code in ec_p256.c. CRYPTO_EC_GENERIC leaves only the
+// bigint code for the other curves, to compare the two implementations.
+static const curve_fast_ops *get_fast_ops(int id)
+{
+ #ifndef CRYPTO_EC_GENERIC
+ switch (id)
+ {
+  case ID_SECP192K1: return &fast_curve<ec_fe::mont_reduce<secp192k1_mont>, 0>::ops;
+  case ID_SECP192R1: return &fast_curve<ec_fe::p192_reduce, -3>::ops;
+  case ID_SECP224K1: return &fast_curve<ec_fe::mont_reduce<secp224k1_mont>, 0>::ops;
+  case ID_SECP224R1: return &fast_curve<ec_fe::p224_reduce, -3>::ops;
+  case ID_SECP256K1: return &fast_curve_glv<ec_fe::mont_reduce<secp256k1_mont> >::ops;
+  case ID_SECP384R1: return &fast_curve<ec_fe::p384_reduce, -3>::ops;
+  case ID_SECP521R1: return &fast_curve<ec_fe::p521_reduce, -3>::ops;
+ }
+ #endif
+ return nullptr;
+}
+
+static const int FIXED_TABLE_WINDOW = 5;
+
+class curve_cache
+{
+ public:
+  curve_cache(): p256_table(nullptr)
+  {
+   memset(contexts, 0, sizeof(contexts));
+   memset(tables, 0, sizeof(tables));
+  }
+  ~curve_cache();
+  const curve_context *get_context(const curve_wei *params);
+  const ec_fixed_table_t *get_table(const curve_wei *params);
+  const ec_p256_table_t *get_p256_table();
+
+ private:
+  mutex lock;
+  curve_context *contexts[CURVE_COUNT];
+  ec_fixed_table_t *tables[CURVE_COUNT];
+  ec_p256_table_t *p256_table;
+
+  const curve_context *create_context(unsigned index);
+};
+
+curve_cache::~curve_cache()
+{
+ for (unsigned i = 0; i < CURVE_COUNT; i++)
+ {
+  if (tables[i])
+  {
+   ec_wei_fixed_table_destroy(tables[i]);
+   delete tables[i];
+  }
+  if (contexts[i])
+  {
+   ec_wei_def_destroy(&contexts[i]->def);
+   ec_wei_point_destroy(&contexts[i]->gen);
+   bigint_destroy(contexts[i]->order);
+   if (contexts[i]->glv) destroy_glv(contexts[i]->glv);
+   ec_wei_sqrt_destroy(&contexts[i]->sqrt);
+   delete contexts[i];
+  }
+ }
+ if (p256_table) ec_p256_table_destroy(p256_table);
+}
+
+// must be called with the lock held
+const curve_context *curve_cache::create_context(unsigned index)
+{
+ if (!contexts[index])
+ {
+  curve_context *ctx = new curve_context;
+  ctx->params = curves + index;
+  init_curve(&ctx->def, &ctx->gen, &ctx->order, ctx->params);
+  ctx->glv = create_glv(ctx);
+  ctx->fast = get_fast_ops(ctx->params->id);
+  ec_scratch_t s;
+  ec_wei_scratch_init(&s, &ctx->def);
+  ec_wei_sqrt_init(&ctx->sqrt, &ctx->def, &s);
+  ec_wei_scratch_destroy(&s);
+  contexts[index] = ctx;
+ }
+ return contexts[index];
+}
+
+const curve_context *curve_cache::get_context(const curve_wei *params)
+{
+ unsigned index = params - curves;
+ if (index >= CURVE_COUNT) return nullptr;
+ mutex_locker lock(this->lock);
+ return create_context(index);
+}
+
+const ec_fixed_table_t *curve_cache::get_table(const curve_wei *params)
+{
+ unsigned index = params - curves;
+ if (index >= CURVE_COUNT) return nullptr;
+ mutex_locker lock(this->lock);
+ if (!tables[index])
+ {
+  const curve_context *ctx = create_context(index);
+  ec_scratch_t s;
+  ec_wei_scratch_init(&s, &ctx->def);
+  ec_fixed_table_t *t = new ec_fixed_table_t;
+  ec_weij_fixed_table_init(t, &ctx->gen, bigint_get_bit_count(ctx->order), FIXED_TABLE_WINDOW, &ctx->def, &s);
+  ec_wei_scratch_destroy(&s);
+  tables[index] = t;
+ }
+ return tables[index];
+}
+
+const ec_p256_table_t *curve_cache::get_p256_table()
+{
+ mutex_locker lock(this->lock);
+ if (!p256_table)
+ {
+  const curve_context *ctx = create_context(get_wei_curve_by_id(ID_SECP256R1) - curves);
+  p256_table = ec_p256_table_create(&ctx->gen);
+ }
+ return p256_table;
+}
+
+static curve_cache cache;
+
+const curve_context *get_wei_curve_context(const curve_wei *params)
+{
+ return cache.get_context(params);
+}
+
+const ec_fixed_table_t *get_wei_fixed_table(const curve_wei *params)
+{
+ return cache.get_table(params);
+}
+
+const ec_p256_table_t *get_p256_fixed_table()
+{
+ return cache.get_p256_table();
+}
+
+#if defined(_MSC_VER) && _MSC_VER < 1900
+// no thread_local for objects with destructors, all threads share one pool
+#define SCRATCH_POOL_SHARED
+#endif
+
+class scratch_pool
+{
+ public:
+  ~scratch_pool()
+  {
+   for (unsigned i = 0; i < CURVE_COUNT; i++)
+    for (size_t j = 0; j < items[i].size(); j++)
+     ec_wei_scratch_destroy(&items[i][j]);
+  }
+  void get(ec_scratch_t *s, const curve_context *ctx);
+  void put(ec_scratch_t *s, const curve_context *ctx);
+
+ private:
+  #ifdef SCRATCH_POOL_SHARED
+  static const size_t MAX_FREE = 64;
+  mutex lock;
+  #else
+  // enough for nested use on one thread
+  static const size_t MAX_FREE = 4;
+  #endif
+  std::vector<ec_scratch_t> items[CURVE_COUNT];
+};
+
+#ifdef SCRATCH_POOL_SHARED
+static scratch_pool pool;
+#else
+static thread_local scratch_pool pool;
+#endif
+
+void scratch_pool::get(ec_scratch_t *s, const curve_context *ctx)
+{
+ std::vector<ec_scratch_t> &v = items[ctx->params - curves];
+ {
+  #ifdef SCRATCH_POOL_SHARED
+  mutex_locker ml(lock);
+  #endif
+  if (!v.empty())
+  {
+   *s = v.back();
+   v.pop_back();
+   return;
+  }
+ }
+ ec_wei_scratch_init(s, &ctx->def);
+}
+
+void scratch_pool::put(ec_scratch_t *s, const curve_context *ctx)
+{
+ std::vector<ec_scratch_t> &v = items[ctx->params - curves];
+ {
+  #ifdef SCRATCH_POOL_SHARED
+  mutex_locker ml(lock);
+  #endif
+  if (v.size() < MAX_FREE)
+  {
+   v.push_back(*s);
+   return;
+  }
+ }
+ ec_wei_scratch_destroy(s);
+}
+
+wei_scratch::wei_scratch(const curve_context *ctx): ctx(ctx)
+{
+ pool.get(&s, ctx);
+}
+
+wei_scratch::~wei_scratch()
+{
+ pool.put(&s, ctx);
+}
@@ -2,6 +2,7 @@
 #define __curves_wei_h__
 
 #include "ec_wei.h"
+#include "ec_p256.h"
 #include <stdlib.h>
 
 struct curve_wei
@@ -23,6 +24,57 @@ struct curve_wei
 const curve_wei *get_wei_curve_by_id(int id);
 const curve_wei *get_wei_curve_by_name(const char *name);
 
+struct curve_context;
+
+// Arithmetic on fixed-size limbs specialized for one curve (ec_wei_fe.h)
+struct curve_fast_ops
+{
+ // (x, y) = k*G in constant time, 0 <= k < n; y may be nullptr.
+ // Returns false for the identity
+ bool (*mul_base_ct)(bigint_t x, bigint_t y, const bigint_t k, const curve_context *ctx);
+ // r[i] = k[i]*G in constant time, the affine results share one inversion.
+ // Returns false if any of them is the identity
+ bool (*mul_base_ct_batch)(ec_point_t *r, const bigint_t *k, size_t count, const curve_context *ctx);
+ // r = u1*G + u2*q in Jacobian coordinates, q is affine, variable time.
+ // Returns false for the identity
+ bool (*mul2)(ec_point_t *r, const bigint_t u1, const ec_point_t *q, const bigint_t u2, const curve_context *ctx);
+};
+
+// Curve parameters as bigints
+struct curve_context
+{
+ const curve_wei *params;
+ ec_wei_def_t def;
+ ec_point_t gen;
+ bigint_t order;
+ ec_glv_def_t *glv; // nullptr if the curve has no fast endomorphism
+ ec_sqrt_def_t sqrt; // for decompression of points
+ const curve_fast_ops *fast; // nullptr if only the bigint code is available (or CRYPTO_EC_GENERIC)
+};
+
 void init_curve(ec_wei_def_t *def, ec_point_t *g, bigint_t *pn, const curve_wei *params);
 
+// Shared immutable contexts and generator tables, built on first use and kept until exit
+const curve_context *get_wei_curve_context(const curve_wei *params);
+const ec_fixed_table_t *get_wei_fixed_table(const curve_wei *params);
+const ec_p256_table_t *get_p256_fixed_table();
+
+// Scratch space from a per-thread pool of the curve, returned to the pool
+// on destruction. The bigints are reused by later calls on the same thread
+// and freed when the thread exits.
+class wei_scratch
+{
+ public:
+  explicit wei_scratch(const curve_context *ctx);
+  ~wei_scratch();
+  ec_scratch_t *get() { return &s; }
+
+ private:
+  const curve_context *ctx;
+  ec_scratch_t s;
+
+  wei_scratch(const wei_scratch &) = delete;
+  wei_scratch& operator= (const wei_scratch &) = delete;
+};
+
 #endif
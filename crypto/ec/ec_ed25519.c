@@ -0,0 +1,426 @@
+#include "ec_ed25519.h"
+#include "fe25519.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct
+{
+ fe25519_t x;
+ fe25519_t y;
+ fe25519_t z;
+ fe25519_t t;
+} ed_point_t;
+
+/* affine point as (y+x, y-x, 2d*x*y) */
+typedef struct
+{
+ fe25519_t yplusx;
+ fe25519_t yminusx;
+ fe25519_t xy2d;
+} ed_niels_t;
+
+/* table[i][j] = (j+1)*256^i*B */
+struct _ec_ed25519_table
+{
+ ed_niels_t points[32][8];
+};
+
+static const fe25519_t ed25519_d =
+{
+ 0x75EB4DCA135978A3, 0x00700A4D4141D8AB, 0x8CC740797779E898, 0x52036CEE2B6FFE73
+};
+
+static const fe25519_t ed25519_d2 =
+{
+ 0xEBD69B9426B2F159, 0x00E0149A8283B156, 0x198E80F2EEF3D130, 0x2406D9DC56DFFCE7
+};
+
+static const fe25519_t ed25519_sqrtm1 =
+{
+ 0xC4EE1B274A0EA0B0, 0x2F431806AD2FE478, 0x2B4D00993DFBD7A7, 0x2B8324804FC1DF0B
+};
+
+static const fe25519_t ed25519_bx =
+{
+ 0xC9562D608F25D51A, 0x692CC7609525A7B2, 0xC0A4E231FDD6DC5C, 0x216936D3CD6E53FE
+};
+
+static const fe25519_t ed25519_by =
+{
+ 0x6666666666666658, 0x6666666666666666, 0x6666666666666666, 0x6666666666666666
+};
+
+static void ed_point_set_identity(ed_point_t *r)
+{
+ fe25519_set_word(r->x, 0);
+ fe25519_set_word(r->y, 1);
+ fe25519_set_word(r->z, 1);
+ fe25519_set_word(r->t, 0);
+}
+
+static void ed_point_neg(ed_point_t *r, const ed_point_t *a)
+{
+ fe25519_neg(r->x, a->x);
+ fe25519_copy(r->y, a->y);
+ fe25519_copy(r->z, a->z);
+ fe25519_neg(r->t, a->t);
+}
+
+/* X3 = E*F, Y3 = G*H, T3 = E*H, Z3 = F*G */
+static void ed_point_finish(ed_point_t *r, const fe25519_t e, const fe25519_t f,
+                            const fe25519_t g, const fe25519_t h)
+{
+ fe25519_mul(r->x, e, f);
+ fe25519_mul(r->y, g, h);
+ fe25519_mul(r->t, e, h);
+ fe25519_mul(r->z, f, g);
+}
+
+/* add-2008-hwcd-3 with a = -1: 8M + 1 multiplication by 2d */
+static void ed_point_add(ed_point_t *r, const ed_point_t *a, const ed_point_t *b)
+{
+ fe25519_t pa, pb, c, d, e, f, g, h;
+ fe25519_sub(pa, a->y, a->x);
+ fe25519_sub(h, b->y, b->x);
+ fe25519_mul(pa, pa, h);          /* A = (Y1-X1)*(Y2-X2) */
+ fe25519_add(pb, a->y, a->x);
+ fe25519_add(h, b->y, b->x);
+ fe25519_mul(pb, pb, h);          /* B = (Y1+X1)*(Y2+X2) */
+ fe25519_mul(c, a->t, b->t);
+ fe25519_mul(c, c, ed25519_d2);   /* C = T1*2d*T2 */
+ fe25519_mul(d, a->z, b->z);
+ fe25519_add(d, d, d);            /* D = 2*Z1*Z2 */
+ fe25519_sub(e, pb, pa);
+ fe25519_sub(f, d, c);
+ fe25519_add(g, d, c);
+ fe25519_add(h, pb, pa);
+ ed_point_finish(r, e, f, g, h);
+}
+
+/* a + b with an affine b: 7M */
+static void ed_point_madd(ed_point_t *r, const ed_point_t *a, const ed_niels_t *b)
+{
+ fe25519_t pa, pb, c, d, e, f, g, h;
+ fe25519_sub(pa, a->y, a->x);
+ fe25519_mul(pa, pa, b->yminusx);
+ fe25519_add(pb, a->y, a->x);
+ fe25519_mul(pb, pb, b->yplusx);
+ fe25519_mul(c, a->t, b->xy2d);
+ fe25519_add(d, a->z, a->z);
+ fe25519_sub(e, pb, pa);
+ fe25519_sub(f, d, c);
+ fe25519_add(g, d, c);
+ fe25519_add(h, pb, pa);
+ ed_point_finish(r, e, f, g, h);
+}
+
+/* dbl-2008-hwcd with a = -1: 4M + 4S */
+static void ed_point_dbl(ed_point_t *r, const ed_point_t *a)
+{
+ fe25519_t pa, pb, c, e, f, g, h;
+ fe25519_sqr(pa, a->x);           /* A = X1^2 */
+ fe25519_sqr(pb, a->y);           /* B = Y1^2 */
+ fe25519_sqr(c, a->z);
+ fe25519_add(c, c, c);            /* C = 2*Z1^2 */
+ fe25519_add(h, pa, pb);          /* H = A + B */
+ fe25519_add(e, a->x, a->y);
+ fe25519_sqr(e, e);
+ fe25519_sub(e, h, e);            /* E = H - (X1+Y1)^2 */
+ fe25519_sub(g, pa, pb);          /* G = A - B */
+ fe25519_add(f, c, g);            /* F = C + G */
+ ed_point_finish(r, e, f, g, h);
+}
+
+static void ed_point_encode(uint8_t *out, const ed_point_t *a)
+{
+ fe25519_t zi, x, y;
+ fe25519_inv(zi, a->z);
+ fe25519_mul(x, a->x, zi);
+ fe25519_mul(y, a->y, zi);
+ fe25519_store(out, y);
+ out[31] |= fe25519_is_odd(x) << 7;
+}
+
+/* RFC 8032, 5.1.3 */
+static int ed_point_decode(ed_point_t *r, const uint8_t *in)
+{
+ fe25519_t u, v, v3, vxx, t;
+ uint8_t buf[32];
+ int sign = in[31] >> 7;
+ fe25519_load(r->y, in);
+ /* y must be canonical */
+ fe25519_store(buf, r->y);
+ buf[31] |= sign << 7;
+ if (memcmp(buf, in, 32)) return 0;
+ fe25519_set_word(r->z, 1);
+ fe25519_sqr(u, r->y);
+ fe25519_mul(v, u, ed25519_d);
+ fe25519_sub(u, u, r->z);         /* u = y^2 - 1 */
+ fe25519_add(v, v, r->z);         /* v = d*y^2 + 1 */
+ /* x = u*v^3*(u*v^7)^((p-5)/8) */
+ fe25519_sqr(v3, v);
+ fe25519_mul(v3, v3, v);
+ fe25519_sqr(t, v3);
+ fe25519_mul(t, t, v);
+ fe25519_mul(t, t, u);
+ fe25519_pow22523(t, t);
+ fe25519_mul(t, t, v3);
+ fe25519_mul(r->x, t, u);
+ fe25519_sqr(vxx, r->x);
+ fe25519_mul(vxx, vxx, v);
+ if (!fe25519_equal(vxx, u))
+ {
+  fe25519_neg(t, u);
+  if (!fe25519_equal(vxx, t)) return 0;
+  fe25519_mul(r->x, r->x, ed25519_sqrtm1);
+ }
+ if (fe25519_is_odd(r->x) != sign)
+ {
+  if (fe25519_is_zero(r->x)) return 0;
+  fe25519_neg(r->x, r->x);
+ }
+ fe25519_mul(r->t, r->x, r->y);
+ return 1;
+}
+
+static int fe_from_bigint(fe25519_t r, const bigint_t a)
+{
+ uint8_t buf[32], le[32];
+ int i, size;
+ if (bigint_get_sign(a) || bigint_get_bit_count(a) > 255) return 0;
+ size = bigint_get_byte_count(a);
+ memset(buf, 0, 32);
+ if (size) bigint_get_bytes_be(a, buf + 32 - size, size);
+ for (i = 0; i < 32; i++) le[i] = buf[31-i];
+ fe25519_load(r, le);
+ return 1;
+}
+
+static void fe_to_bigint(bigint_t r, const fe25519_t a)
+{
+ uint8_t buf[32], le[32];
+ int i;
+ fe25519_store(le, a);
+ for (i = 0; i < 32; i++) buf[i] = le[31-i];
+ bigint_set_bytes_be(r, buf, 32);
+}
+
+static void ed_point_load(ed_point_t *r, const ec_ext_point_t *a)
+{
+ fe_from_bigint(r->x, a->x);
+ fe_from_bigint(r->y, a->y);
+ fe_from_bigint(r->z, a->z);
+ fe_from_bigint(r->t, a->t);
+}
+
+static void ed_point_store(ec_ext_point_t *r, const ed_point_t *a)
+{
+ fe_to_bigint(r->x, a->x);
+ fe_to_bigint(r->y, a->y);
+ fe_to_bigint(r->z, a->z);
+ fe_to_bigint(r->t, a->t);
+}
+
+void ec_ed25519_point_add(ec_ext_point_t *res, const ec_ext_point_t *a, const ec_ext_point_t *b)
+{
+ ed_point_t pa, pb;
+ ed_point_load(&pa, a);
+ ed_point_load(&pb, b);
+ ed_point_add(&pa, &pa, &pb);
+ ed_point_store(res, &pa);
+}
+
+void ec_ed25519_point_dbl(ec_ext_point_t *res, const ec_ext_point_t *a)
+{
+ ed_point_t pa;
+ ed_point_load(&pa, a);
+ ed_point_dbl(&pa, &pa);
+ ed_point_store(res, &pa);
+}
+
+int ec_ed25519_point_decode(ec_ext_point_t *res, const uint8_t *in)
+{
+ ed_point_t pa;
+ if (!ed_point_decode(&pa, in)) return 0;
+ ed_point_store(res, &pa);
+ return 1;
+}
+
+void ec_ed25519_point_encode(uint8_t *out, const ec_ext_point_t *a)
+{
+ ed_point_t pa;
+ ed_point_load(&pa, a);
+ ed_point_encode(out, &pa);
+}
+
+ec_ed25519_table_t *ec_ed25519_table_create(void)
+{
+ int i, j, n = 32*8;
+ ed_point_t *pts, base;
+ fe25519_t *c, inv, zi, x, y;
+ ec_ed25519_table_t *table = (ec_ed25519_table_t *) malloc(sizeof(ec_ed25519_table_t));
+ pts = (ed_point_t *) malloc(n * sizeof(ed_point_t));
+ c = (fe25519_t *) malloc(n * sizeof(fe25519_t));
+ fe25519_copy(base.x, ed25519_bx);
+ fe25519_copy(base.y, ed25519_by);
+ fe25519_set_word(base.z, 1);
+ fe25519_mul(base.t, ed25519_bx, ed25519_by);
+ for (i = 0; i < 32; i++)
+ {
+  pts[8*i] = base;
+  for (j = 1; j < 8; j++)
+   ed_point_add(pts + 8*i + j, pts + 8*i + j-1, &base);
+  /* base = 256*base */
+  ed_point_dbl(&base, pts + 8*i + 7);
+  for (j = 0; j < 4; j++) ed_point_dbl(&base, &base);
+ }
+ /* one inversion for all points */
+ fe25519_copy(c[0], pts[0].z);
+ for (i = 1; i < n; i++)
+  fe25519_mul(c[i], c[i-1], pts[i].z);
+ fe25519_inv(inv, c[n-1]);
+ for (i = n-1; i >= 0; i--)
+ {
+  ed_niels_t *r = &table->points[i >> 3][i & 7];
+  if (i)
+  {
+   fe25519_mul(zi, inv, c[i-1]);
+   fe25519_mul(inv, inv, pts[i].z);
+  } else fe25519_copy(zi, inv);
+  fe25519_mul(x, pts[i].x, zi);
+  fe25519_mul(y, pts[i].y, zi);
+  fe25519_add(r->yplusx, y, x);
+  fe25519_sub(r->yminusx, y, x);
+  fe25519_mul(r->xy2d, x, y);
+  fe25519_mul(r->xy2d, r->xy2d, ed25519_d2);
+ }
+ free(c);
+ free(pts);
+ return table;
+}
+
+void ec_ed25519_table_destroy(ec_ed25519_table_t *table)
+{
+ free(table);
+}
+
+/* r = d*256^i*B, -8 <= d <= 8, without secret-dependent memory access */
+static void ed_select(ed_niels_t *r, const ec_ed25519_table_t *table, int i, signed char d)
+{
+ uint32_t neg = ((uint32_t) d >> 31) & 1;
+ uint32_t abs_d = (uint32_t) (d ^ -(int32_t) neg) + neg;
+ uint64_t eq;
+ fe25519_t t;
+ int j;
+ fe25519_set_word(r->yplusx, 1);
+ fe25519_set_word(r->yminusx, 1);
+ fe25519_set_word(r->xy2d, 0);
+ for (j = 0; j < 8; j++)
+ {
+  eq = ((abs_d ^ (j+1)) - 1) >> 31;
+  fe25519_cmov(r->yplusx, table->points[i][j].yplusx, eq);
+  fe25519_cmov(r->yminusx, table->points[i][j].yminusx, eq);
+  fe25519_cmov(r->xy2d, table->points[i][j].xy2d, eq);
+ }
+ /* -(x, y) = (-x, y) */
+ fe25519_cswap(r->yplusx, r->yminusx, neg);
+ fe25519_neg(t, r->xy2d);
+ fe25519_cmov(r->xy2d, t, neg);
+}
+
+static void ed_point_mul_fixed(ed_point_t *r, const ec_ed25519_table_t *table, const uint8_t *k)
+{
+ signed char e[64];
+ ed_niels_t t;
+ int i, carry = 0;
+ for (i = 0; i < 32; i++)
+ {
+  e[2*i] = k[i] & 15;
+  e[2*i+1] = k[i] >> 4;
+ }
+ /* signed digits in [-8, 8) */
+ for (i = 0; i < 63; i++)
+ {
+  e[i] += carry;
+  carry = (e[i] + 8) >> 4;
+  e[i] -= carry << 4;
+ }
+ e[63] += carry;
+ /* k*B = sum(e[i]*16^i*B), odd digits go first and are multiplied by 16 */
+ ed_point_set_identity(r);
+ for (i = 1; i < 64; i += 2)
+ {
+  ed_select(&t, table, i >> 1, e[i]);
+  ed_point_madd(r, r, &t);
+ }
+ for (i = 0; i < 4; i++) ed_point_dbl(r, r);
+ for (i = 0; i < 64; i += 2)
+ {
+  ed_select(&t, table, i >> 1, e[i]);
+  ed_point_madd(r, r, &t);
+ }
+ memset(e, 0, sizeof(e));
+}
+
+void ec_ed25519_point_mul_fixed(uint8_t *out, const ec_ed25519_table_t *table, const uint8_t *k)
+{
+ ed_point_t r;
+ ed_point_mul_fixed(&r, table, k);
+ ed_point_encode(out, &r);
+}
+
+#define WNAF_WINDOW 5
+
+/* width-w NAF of a 256-bit scalar, returns the number of digits */
+static int ed_recode_wnaf(signed char *digits, const uint8_t *k)
+{
+ int i, d, full = 1 << WNAF_WINDOW, half = full >> 1;
+ int val = k[0] & (full - 1);
+ for (i = 0; val || i < 256; i++)
+ {
+  d = 0;
+  if (val & 1)
+  {
+   d = (val & half)? val - full : val;
+   val -= d;
+  }
+  digits[i] = (signed char) d;
+  if (i + WNAF_WINDOW < 256)
+   val += ((k[(i + WNAF_WINDOW) >> 3] >> ((i + WNAF_WINDOW) & 7)) & 1) << WNAF_WINDOW;
+  val >>= 1;
+ }
+ return i;
+}
+
+int ec_ed25519_point_mul2_fixed(uint8_t *out, const ec_ed25519_table_t *table,
+                                const uint8_t *s, const uint8_t *h, const uint8_t *a)
+{
+ ed_point_t t[1 << (WNAF_WINDOW-2)], a2, r, sb, neg;
+ signed char digits[257];
+ int i, len;
+ if (!ed_point_decode(t, a)) return 0;
+ /* odd multiples of -A */
+ ed_point_neg(t, t);
+ ed_point_dbl(&a2, t);
+ for (i = 1; i < 1 << (WNAF_WINDOW-2); i++)
+  ed_point_add(t + i, t + i-1, &a2);
+ len = ed_recode_wnaf(digits, h);
+ ed_point_set_identity(&r);
+ for (i = len-1; i >= 0; i--)
+ {
+  ed_point_dbl(&r, &r);
+  if (digits[i] > 0)
+   ed_point_add(&r, &r, t + (digits[i] >> 1));
+  else
+  if (digits[i] < 0)
+  {
+   ed_point_neg(&neg, t + (-digits[i] >> 1));
+   ed_point_add(&r, &r, &neg);
+  }
+ }
+ /* s*B doesn't need doublings */
+ ed_point_mul_fixed(&sb, table, s);
+ ed_point_add(&r, &r, &sb);
+ ed_point_encode(out, &r);
+ return 1;
+}
@@ -0,0 +1,44 @@
+#ifndef __ec_ed25519_h__
+#define __ec_ed25519_h__
+
+#include "ec_common.h"
+#include <stdint.h>
+
+/*
+  Ed25519 group (RFC 8032): twisted Edwards curve -x^2 + y^2 = 1 + d*x^2*y^2
+  over p = 2^255 - 19. Points use extended coordinates (X:Y:Z:T) with
+  x = X/Z, y = Y/Z, x*y = T/Z; addition and doubling are unified.
+  Scalars and encoded points are 32-byte little-endian strings.
+ */
+
+#define EC_ED25519_SIZE 32
+
+typedef struct _ec_ed25519_table ec_ed25519_table_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* coordinates of ec_ext_point_t are in [0, p) */
+void ec_ed25519_point_add(ec_ext_point_t *res, const ec_ext_point_t *a, const ec_ext_point_t *b);
+void ec_ed25519_point_dbl(ec_ext_point_t *res, const ec_ext_point_t *a);
+/* returns 0 if the encoding is invalid */
+int  ec_ed25519_point_decode(ec_ext_point_t *res, const uint8_t *in);
+void ec_ed25519_point_encode(uint8_t *out, const ec_ext_point_t *a);
+
+/* precomputed multiples of the base point B */
+ec_ed25519_table_t *ec_ed25519_table_create(void);
+void ec_ed25519_table_destroy(ec_ed25519_table_t *table);
+/* out = encode(k*B) in constant time, k < 2^255 */
+void ec_ed25519_point_mul_fixed(uint8_t *out, const ec_ed25519_table_t *table, const uint8_t *k);
+/* out = encode(s*B - h*A) for signature verification, A is encoded;
+   returns 0 if A is invalid */
+int  ec_ed25519_point_mul2_fixed(uint8_t *out, const ec_ed25519_table_t *table,
+                                 const uint8_t *s, const uint8_t *h, const uint8_t *a);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,109 @@
+#include "ec_mont.h"
+#include "fe25519.h"
+#include <string.h>
+
+/* (a + 2)/4 */
+#define A24 121665
+
+/* x2 = k*u, k is 32 bytes little-endian, bits above 'bits' must be 0 */
+static void mont_ladder(fe25519_t x2, const fe25519_t u, const uint8_t *k, int bits)
+{
+ fe25519_t z2, x3, z3, a, aa, b, bb, e, c, d;
+ uint64_t swap = 0, bit;
+ int i;
+ fe25519_set_word(x2, 1);
+ fe25519_set_word(z2, 0);
+ fe25519_copy(x3, u);
+ fe25519_set_word(z3, 1);
+ for (i = bits-1; i >= 0; i--)
+ {
+  bit = (k[i >> 3] >> (i & 7)) & 1;
+  swap ^= bit;
+  fe25519_cswap(x2, x3, swap);
+  fe25519_cswap(z2, z3, swap);
+  swap = bit;
+  fe25519_add(a, x2, z2);
+  fe25519_sqr(aa, a);
+  fe25519_sub(b, x2, z2);
+  fe25519_sqr(bb, b);
+  fe25519_sub(e, aa, bb);
+  fe25519_add(c, x3, z3);
+  fe25519_sub(d, x3, z3);
+  fe25519_mul(d, d, a);            /* da */
+  fe25519_mul(c, c, b);            /* cb */
+  fe25519_add(x3, d, c);
+  fe25519_sqr(x3, x3);             /* x3 = (da + cb)^2 */
+  fe25519_sub(z3, d, c);
+  fe25519_sqr(z3, z3);
+  fe25519_mul(z3, z3, u);          /* z3 = u*(da - cb)^2 */
+  fe25519_mul(x2, aa, bb);         /* x2 = aa*bb */
+  fe25519_mul_word(z2, e, A24);
+  fe25519_add(z2, z2, aa);
+  fe25519_mul(z2, z2, e);          /* z2 = e*(aa + a24*e) */
+ }
+ fe25519_cswap(x2, x3, swap);
+ fe25519_cswap(z2, z3, swap);
+ fe25519_inv(z2, z2);
+ fe25519_mul(x2, x2, z2);
+}
+
+int ec_x25519(uint8_t *out, const uint8_t *scalar, const uint8_t *u)
+{
+ fe25519_t fu, r;
+ uint8_t k[32];
+ memcpy(k, scalar, 32);
+ k[0] &= 248;
+ k[31] &= 127;
+ k[31] |= 64;
+ fe25519_load(fu, u);
+ mont_ladder(r, fu, k, 255);
+ fe25519_store(out, r);
+ memset(k, 0, sizeof(k));
+ return !fe25519_is_zero(r);
+}
+
+int ec_x25519_base(uint8_t *out, const uint8_t *scalar)
+{
+ static const uint8_t base[32] = { 9 };
+ return ec_x25519(out, scalar, base);
+}
+
+/* 0 <= a < 2^255 to 32 bytes little-endian */
+static int load_bigint(uint8_t *out, const bigint_t a)
+{
+ uint8_t buf[32];
+ int i, size;
+ if (bigint_get_sign(a) || bigint_get_bit_count(a) > 255) return 0;
+ size = bigint_get_byte_count(a);
+ memset(buf, 0, 32);
+ if (size) bigint_get_bytes_be(a, buf + 32 - size, size);
+ for (i = 0; i < 32; i++) out[i] = buf[31-i];
+ return 1;
+}
+
+static void store_bigint(bigint_t r, const uint8_t *in)
+{
+ uint8_t buf[32];
+ int i;
+ for (i = 0; i < 32; i++) buf[i] = in[31-i];
+ bigint_set_bytes_be(r, buf, 32);
+}
+
+int ec_mont25519_point_mul(ec_xz_point_t *res, const ec_xz_point_t *a, const bigint_t k)
+{
+ fe25519_t x, z;
+ uint8_t buf[32], kb[32];
+ if (!load_bigint(kb, k)) return 0;
+ if (!load_bigint(buf, a->x)) return 0;
+ fe25519_load(x, buf);
+ if (!load_bigint(buf, a->z)) return 0;
+ fe25519_load(z, buf);
+ if (fe25519_is_zero(z)) return 0;
+ fe25519_inv(z, z);
+ fe25519_mul(x, x, z);
+ mont_ladder(z, x, kb, 255);
+ fe25519_store(buf, z);
+ store_bigint(res->x, buf);
+ bigint_set_word(res->z, 1);
+ return !fe25519_is_zero(z);
+}
@@ -0,0 +1,33 @@
+#ifndef __ec_mont_h__
+#define __ec_mont_h__
+
+#include "ec_common.h"
+#include <stdint.h>
+
+/*
+  Curve25519 (RFC 7748): Montgomery curve v^2 = u^3 + 486662*u^2 + u
+  over p = 2^255 - 19. Only u (or X:Z) coordinates are used,
+  the ladder runs in constant time.
+ */
+
+#define EC_X25519_SIZE 32
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* out = X25519(scalar, u), returns 0 if the result is zero (u has small order) */
+int ec_x25519(uint8_t *out, const uint8_t *scalar, const uint8_t *u);
+/* out = X25519(scalar, 9) */
+int ec_x25519_base(uint8_t *out, const uint8_t *scalar);
+
+/* res = k*a, k is used as is (not clamped), 0 <= k < 2^255;
+   res->z is set to 1, returns 0 if the result is the point at infinity or (0, 0) */
+int ec_mont25519_point_mul(ec_xz_point_t *res, const ec_xz_point_t *a, const bigint_t k);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,944 @@
+#include "ec_p256.h"
+#include <platform/umul.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* field element, 4 little-endian limbs, always < p */
+typedef uint64_t p256_fe_t[4];
+
+/* Jacobian coordinates, z = 0 for the identity */
+typedef struct
+{
+ p256_fe_t x;
+ p256_fe_t y;
+ p256_fe_t z;
+} p256_point_t;
+
+static const p256_fe_t p256_p =
+{
+ 0xFFFFFFFFFFFFFFFF, 0x00000000FFFFFFFF, 0x0000000000000000, 0xFFFFFFFF00000001
+};
+
+static const p256_fe_t p256_zero = { 0, 0, 0, 0 };
+static const p256_fe_t p256_one = { 1, 0, 0, 0 };
+
+static const p256_fe_t p256_b =
+{
+ 0x3BCE3C3E27D2604B, 0x651D06B0CC53B0F6, 0xB3EBBD55769886BC, 0x5AC635D8AA3A93E7
+};
+
+/* r = t - p if t >= p or carry is set, else r = t */
+static void p256_fe_final_sub(p256_fe_t r, const p256_fe_t t, uint64_t carry)
+{
+ p256_fe_t d;
+ uint64_t borrow = 0, x, y, mask;
+ int i;
+ for (i = 0; i < 4; i++)
+ {
+  x = t[i];
+  y = p256_p[i] + borrow;
+  borrow = (y < borrow) | (x < y);
+  d[i] = x - y;
+ }
+ mask = 0 - (borrow & (carry ^ 1));
+ for (i = 0; i < 4; i++)
+  r[i] = (t[i] & mask) | (d[i] & ~mask);
+}
+
+static void p256_fe_add(p256_fe_t r, const p256_fe_t a, const p256_fe_t b)
+{
+ p256_fe_t t;
+ uint64_t carry = 0, x;
+ int i;
+ for (i = 0; i < 4; i++)
+ {
+  x = a[i] + carry;
+  carry = x < carry;
+  t[i] = x + b[i];
+  carry += t[i] < x;
+ }
+ p256_fe_final_sub(r, t, carry);
+}
+
+static void p256_fe_sub(p256_fe_t r, const p256_fe_t a, const p256_fe_t b)
+{
+ uint64_t borrow = 0, carry = 0, x, y, mask;
+ int i;
+ for (i = 0; i < 4; i++)
+ {
+  x = a[i];
+  y = b[i] + borrow;
+  borrow = (y < borrow) | (x < y);
+  r[i] = x - y;
+ }
+ mask = 0 - borrow;
+ for (i = 0; i < 4; i++)
+ {
+  x = r[i] + carry;
+  carry = x < carry;
+  r[i] = x + (p256_p[i] & mask);
+  carry += r[i] < x;
+ }
+}
+
+#define PROPAGATE_WORD(x) \
+ acc += x; \
+ x = (uint32_t) acc; \
+ acc >>= 32;
+
+#define PROPAGATE_CARRY() \
+ acc = 0; \
+ PROPAGATE_WORD(s0); PROPAGATE_WORD(s1); PROPAGATE_WORD(s2); PROPAGATE_WORD(s3); \
+ PROPAGATE_WORD(s4); PROPAGATE_WORD(s5); PROPAGATE_WORD(s6); PROPAGATE_WORD(s7);
+
+/*
+  Solinas reduction of a 512-bit number (FIPS 186-4, D.2.3)
+  with 32-bit words c0..c15:
+    r = t + 2*s1 + 2*s2 + s3 + s4 - d1 - d2 - d3 - d4
+ */
+static void p256_fe_reduce(p256_fe_t r, const uint64_t t[8])
+{
+ int64_t c0, c1, c2, c3, c4, c5, c6, c7, c8, c9, c10, c11, c12, c13, c14, c15;
+ int64_t s0, s1, s2, s3, s4, s5, s6, s7, acc;
+ p256_fe_t v;
+ c0 = (uint32_t) t[0]; c1 = t[0] >> 32;
+ c2 = (uint32_t) t[1]; c3 = t[1] >> 32;
+ c4 = (uint32_t) t[2]; c5 = t[2] >> 32;
+ c6 = (uint32_t) t[3]; c7 = t[3] >> 32;
+ c8 = (uint32_t) t[4]; c9 = t[4] >> 32;
+ c10 = (uint32_t) t[5]; c11 = t[5] >> 32;
+ c12 = (uint32_t) t[6]; c13 = t[6] >> 32;
+ c14 = (uint32_t) t[7]; c15 = t[7] >> 32;
+ s0 = c0 + c8 + c9 - c11 - c12 - c13 - c14;
+ s1 = c1 + c9 + c10 - c12 - c13 - c14 - c15;
+ s2 = c2 + c10 + c11 - c13 - c14 - c15;
+ s3 = c3 + 2*(c11 + c12) + c13 - c15 - c8 - c9;
+ s4 = c4 + 2*(c12 + c13) + c14 - c9 - c10;
+ s5 = c5 + 2*(c13 + c14) + c15 - c10 - c11;
+ s6 = c6 + 3*c14 + 2*c15 + c13 - c8 - c9;
+ s7 = c7 + 3*c15 + c8 - c10 - c11 - c12 - c13;
+ /* the carry out of the top word is small, 2^256 = 2^224 - 2^192 - 2^96 + 1 (mod p)
+    is folded back twice to bring it to zero */
+ PROPAGATE_CARRY();
+ s0 += acc; s3 -= acc; s6 -= acc; s7 += acc;
+ PROPAGATE_CARRY();
+ s0 += acc; s3 -= acc; s6 -= acc; s7 += acc;
+ PROPAGATE_CARRY();
+ assert(acc == 0);
+ v[0] = (uint64_t) s1 << 32 | (uint64_t) s0;
+ v[1] = (uint64_t) s3 << 32 | (uint64_t) s2;
+ v[2] = (uint64_t) s5 << 32 | (uint64_t) s4;
+ v[3] = (uint64_t) s7 << 32 | (uint64_t) s6;
+ p256_fe_final_sub(r, v, 0);
+}
+
+static void p256_fe_mul(p256_fe_t r, const p256_fe_t a, const p256_fe_t b)
+{
+ uint64_t t[8], carry, lo, hi;
+ int i, j;
+ memset(t, 0, sizeof(t));
+ for (i = 0; i < 4; i++)
+ {
+  carry = 0;
+  for (j = 0; j < 4; j++)
+  {
+   lo = umul64(&hi, a[j], b[i]);
+   lo += carry;
+   hi += lo < carry;
+   lo += t[i+j];
+   hi += lo < t[i+j];
+   t[i+j] = lo;
+   carry = hi;
+  }
+  t[i+4] = carry;
+ }
+ p256_fe_reduce(r, t);
+}
+
+static void p256_fe_sqr(p256_fe_t r, const p256_fe_t a)
+{
+ uint64_t t[8], carry, lo, hi;
+ int i, j;
+ memset(t, 0, sizeof(t));
+ /* cross products once, then doubled */
+ for (i = 0; i < 3; i++)
+ {
+  carry = 0;
+  for (j = i+1; j < 4; j++)
+  {
+   lo = umul64(&hi, a[i], a[j]);
+   lo += carry;
+   hi += lo < carry;
+   lo += t[i+j];
+   hi += lo < t[i+j];
+   t[i+j] = lo;
+   carry = hi;
+  }
+  t[i+4] = carry;
+ }
+ carry = 0;
+ for (i = 1; i < 8; i++)
+ {
+  hi = t[i] >> 63;
+  t[i] = t[i] << 1 | carry;
+  carry = hi;
+ }
+ carry = 0;
+ for (i = 0; i < 4; i++)
+ {
+  lo = umul64(&hi, a[i], a[i]);
+  lo += carry;
+  hi += lo < carry;
+  t[2*i] += lo;
+  hi += t[2*i] < lo;
+  t[2*i+1] += hi;
+  carry = t[2*i+1] < hi;
+ }
+ p256_fe_reduce(r, t);
+}
+
+static void p256_fe_sqr_n(p256_fe_t r, const p256_fe_t a, int n)
+{
+ p256_fe_sqr(r, a);
+ while (--n) p256_fe_sqr(r, r);
+}
+
+/* r = a^(p-2), a != 0 */
+static void p256_fe_inv(p256_fe_t r, const p256_fe_t a)
+{
+ p256_fe_t x2, x3, x6, x12, x15, x30, x32, t;
+ p256_fe_sqr(t, a);
+ p256_fe_mul(x2, t, a);        /* 2^2 - 1 */
+ p256_fe_sqr(t, x2);
+ p256_fe_mul(x3, t, a);        /* 2^3 - 1 */
+ p256_fe_sqr_n(t, x3, 3);
+ p256_fe_mul(x6, t, x3);       /* 2^6 - 1 */
+ p256_fe_sqr_n(t, x6, 6);
+ p256_fe_mul(x12, t, x6);      /* 2^12 - 1 */
+ p256_fe_sqr_n(t, x12, 3);
+ p256_fe_mul(x15, t, x3);      /* 2^15 - 1 */
+ p256_fe_sqr_n(t, x15, 15);
+ p256_fe_mul(x30, t, x15);     /* 2^30 - 1 */
+ p256_fe_sqr_n(t, x30, 2);
+ p256_fe_mul(x32, t, x2);      /* 2^32 - 1 */
+ p256_fe_sqr_n(t, x32, 32);
+ p256_fe_mul(t, t, a);         /* ffffffff 00000001 */
+ p256_fe_sqr_n(t, t, 128);
+ p256_fe_mul(t, t, x32);       /* ffffffff 00000001 00000000 00000000 00000000 ffffffff */
+ p256_fe_sqr_n(t, t, 32);
+ p256_fe_mul(t, t, x32);       /* ... ffffffff ffffffff */
+ p256_fe_sqr_n(t, t, 30);
+ p256_fe_mul(t, t, x30);
+ p256_fe_sqr_n(t, t, 2);
+ p256_fe_mul(r, t, a);         /* ... ffffffff ffffffff fffffffd */
+}
+
+/* r = a^((p+1)/4), the square root of a if there is one */
+static void p256_fe_sqrt(p256_fe_t r, const p256_fe_t a)
+{
+ p256_fe_t x2, x4, x8, x16, x32, t;
+ p256_fe_sqr(t, a);
+ p256_fe_mul(x2, t, a);        /* 2^2 - 1 */
+ p256_fe_sqr_n(t, x2, 2);
+ p256_fe_mul(x4, t, x2);       /* 2^4 - 1 */
+ p256_fe_sqr_n(t, x4, 4);
+ p256_fe_mul(x8, t, x4);       /* 2^8 - 1 */
+ p256_fe_sqr_n(t, x8, 8);
+ p256_fe_mul(x16, t, x8);      /* 2^16 - 1 */
+ p256_fe_sqr_n(t, x16, 16);
+ p256_fe_mul(x32, t, x16);     /* 2^32 - 1 */
+ p256_fe_sqr_n(t, x32, 32);
+ p256_fe_mul(t, t, a);         /* ffffffff 00000001 */
+ p256_fe_sqr_n(t, t, 96);
+ p256_fe_mul(t, t, a);         /* ffffffff 00000001 00000000 00000000 00000001 */
+ p256_fe_sqr_n(r, t, 94);      /* 2^254 - 2^222 + 2^190 + 2^94 */
+}
+
+static int p256_fe_is_zero(const p256_fe_t a)
+{
+ return !(a[0] | a[1] | a[2] | a[3]);
+}
+
+static int p256_fe_equal(const p256_fe_t a, const p256_fe_t b)
+{
+ return !((a[0] ^ b[0]) | (a[1] ^ b[1]) | (a[2] ^ b[2]) | (a[3] ^ b[3]));
+}
+
+/* r = a if flag is 1 */
+static void p256_fe_cmov(p256_fe_t r, const p256_fe_t a, uint64_t flag)
+{
+ uint64_t mask = 0 - flag;
+ int i;
+ for (i = 0; i < 4; i++)
+  r[i] ^= (r[i] ^ a[i]) & mask;
+}
+
+static void p256_fe_load(p256_fe_t r, const uint8_t in[32])
+{
+ int i, j;
+ for (i = 0; i < 4; i++)
+ {
+  r[i] = 0;
+  for (j = 0; j < 8; j++)
+   r[i] |= (uint64_t) in[31 - 8*i - j] << 8*j;
+ }
+ p256_fe_final_sub(r, r, 0);
+}
+
+static void p256_fe_store(uint8_t out[32], const p256_fe_t a)
+{
+ int i, j;
+ for (i = 0; i < 4; i++)
+  for (j = 0; j < 8; j++)
+   out[31 - 8*i - j] = (uint8_t) (a[i] >> 8*j);
+}
+
+/* |a| as 32 big-endian bytes, returns 0 if it doesn't fit */
+static int p256_get_bytes(uint8_t out[32], const bigint_t a)
+{
+ int size = bigint_get_byte_count(a);
+ if (size > 32) return 0;
+ memset(out, 0, 32);
+ if (size) bigint_get_bytes_be(a, out + 32 - size, size);
+ return 1;
+}
+
+static void p256_fe_from_bigint(p256_fe_t r, const bigint_t a)
+{
+ uint8_t buf[32];
+ int result = p256_get_bytes(buf, a);
+ assert(result);
+ (void) result;
+ p256_fe_load(r, buf);
+ if (bigint_get_sign(a)) p256_fe_sub(r, p256_zero, r);
+}
+
+static void p256_fe_to_bigint(bigint_t r, const p256_fe_t a)
+{
+ uint8_t buf[32];
+ p256_fe_store(buf, a);
+ bigint_set_bytes_be(r, buf, 32);
+}
+
+static void p256_point_set_identity(p256_point_t *r)
+{
+ memcpy(r->x, p256_one, sizeof(p256_fe_t));
+ memcpy(r->y, p256_one, sizeof(p256_fe_t));
+ memset(r->z, 0, sizeof(p256_fe_t));
+}
+
+/* dbl-2001-b: 3M + 5S */
+static void p256_point_dbl(p256_point_t *r, const p256_point_t *a)
+{
+ p256_fe_t delta, gamma, beta, alpha, t1, t2;
+ p256_fe_sqr(delta, a->z);        /* delta = z^2                 */
+ p256_fe_sqr(gamma, a->y);        /* gamma = y^2                 */
+ p256_fe_mul(beta, a->x, gamma);  /* beta = x*gamma              */
+ p256_fe_sub(t1, a->x, delta);
+ p256_fe_add(t2, a->x, delta);
+ p256_fe_mul(alpha, t1, t2);
+ p256_fe_add(t1, alpha, alpha);
+ p256_fe_add(alpha, alpha, t1);   /* alpha = 3*(x-delta)*(x+delta) */
+ p256_fe_add(t1, a->y, a->z);
+ p256_fe_sqr(t1, t1);
+ p256_fe_sub(t1, t1, gamma);
+ p256_fe_sub(r->z, t1, delta);    /* z' = (y+z)^2 - gamma - delta */
+ p256_fe_add(beta, beta, beta);
+ p256_fe_add(beta, beta, beta);   /* beta = 4*beta               */
+ p256_fe_sqr(t1, alpha);
+ p256_fe_add(t2, beta, beta);
+ p256_fe_sub(r->x, t1, t2);       /* x' = alpha^2 - 8*beta       */
+ p256_fe_sub(t1, beta, r->x);
+ p256_fe_mul(t1, alpha, t1);
+ p256_fe_sqr(t2, gamma);
+ p256_fe_add(t2, t2, t2);
+ p256_fe_add(t2, t2, t2);
+ p256_fe_add(t2, t2, t2);
+ p256_fe_sub(r->y, t1, t2);       /* y' = alpha*(4*beta-x') - 8*gamma^2 */
+}
+
+/* add-2007-bl: 11M + 5S */
+static void p256_point_add(p256_point_t *r, const p256_point_t *a, const p256_point_t *b)
+{
+ p256_fe_t z1z1, z2z2, u1, u2, s1, s2, h, i, j, rr, v, t;
+ if (p256_fe_is_zero(b->z))
+ {
+  *r = *a;
+  return;
+ }
+ if (p256_fe_is_zero(a->z))
+ {
+  *r = *b;
+  return;
+ }
+ p256_fe_sqr(z1z1, a->z);
+ p256_fe_sqr(z2z2, b->z);
+ p256_fe_mul(u1, a->x, z2z2);       /* U1 = x1*z2^2  */
+ p256_fe_mul(u2, b->x, z1z1);       /* U2 = x2*z1^2  */
+ p256_fe_mul(s1, b->z, z2z2);
+ p256_fe_mul(s1, a->y, s1);         /* S1 = y1*z2^3  */
+ p256_fe_mul(s2, a->z, z1z1);
+ p256_fe_mul(s2, b->y, s2);         /* S2 = y2*z1^3  */
+ p256_fe_sub(h, u2, u1);            /* H = U2 - U1   */
+ p256_fe_sub(rr, s2, s1);
+ if (p256_fe_is_zero(h))
+ {
+  if (p256_fe_is_zero(rr))
+   p256_point_dbl(r, a);
+  else
+   p256_point_set_identity(r);
+  return;
+ }
+ p256_fe_add(rr, rr, rr);           /* r = 2*(S2-S1) */
+ p256_fe_add(i, h, h);
+ p256_fe_sqr(i, i);                 /* I = (2*H)^2   */
+ p256_fe_mul(j, h, i);              /* J = H*I       */
+ p256_fe_mul(v, u1, i);             /* V = U1*I      */
+ p256_fe_add(t, a->z, b->z);
+ p256_fe_sqr(t, t);
+ p256_fe_sub(t, t, z1z1);
+ p256_fe_sub(t, t, z2z2);
+ p256_fe_mul(r->z, t, h);           /* z' = ((z1+z2)^2 - z1^2 - z2^2)*H */
+ p256_fe_sqr(t, rr);
+ p256_fe_sub(t, t, j);
+ p256_fe_sub(t, t, v);
+ p256_fe_sub(r->x, t, v);           /* x' = r^2 - J - 2*V */
+ p256_fe_sub(t, v, r->x);
+ p256_fe_mul(t, rr, t);
+ p256_fe_mul(s1, s1, j);
+ p256_fe_add(s1, s1, s1);
+ p256_fe_sub(r->y, t, s1);          /* y' = r*(V-x') - 2*S1*J */
+}
+
+/* madd-2007-bl: 7M + 4S, b is affine */
+static void p256_point_madd(p256_point_t *r, const p256_point_t *a, const p256_fe_t bx, const p256_fe_t by)
+{
+ p256_fe_t z1z1, u2, s2, h, hh, i, j, rr, v, t;
+ if (p256_fe_is_zero(a->z))
+ {
+  memcpy(r->x, bx, sizeof(p256_fe_t));
+  memcpy(r->y, by, sizeof(p256_fe_t));
+  memcpy(r->z, p256_one, sizeof(p256_fe_t));
+  return;
+ }
+ p256_fe_sqr(z1z1, a->z);
+ p256_fe_mul(u2, bx, z1z1);         /* U2 = x2*z1^2  */
+ p256_fe_mul(s2, a->z, z1z1);
+ p256_fe_mul(s2, by, s2);           /* S2 = y2*z1^3  */
+ p256_fe_sub(h, u2, a->x);          /* H = U2 - x1   */
+ p256_fe_sub(rr, s2, a->y);
+ if (p256_fe_is_zero(h))
+ {
+  if (p256_fe_is_zero(rr))
+   p256_point_dbl(r, a);
+  else
+   p256_point_set_identity(r);
+  return;
+ }
+ p256_fe_add(rr, rr, rr);           /* r = 2*(S2 - y1) */
+ p256_fe_sqr(hh, h);
+ p256_fe_add(i, hh, hh);
+ p256_fe_add(i, i, i);              /* I = 4*H^2     */
+ p256_fe_mul(j, h, i);              /* J = H*I       */
+ p256_fe_mul(v, a->x, i);           /* V = x1*I      */
+ p256_fe_add(t, a->z, h);
+ p256_fe_sqr(t, t);
+ p256_fe_sub(t, t, z1z1);
+ p256_fe_sub(r->z, t, hh);          /* z' = (z1 + H)^2 - z1^2 - H^2 */
+ p256_fe_mul(s2, a->y, j);
+ p256_fe_add(s2, s2, s2);           /* 2*y1*J, a->y is not used after this */
+ p256_fe_sqr(t, rr);
+ p256_fe_sub(t, t, j);
+ p256_fe_sub(t, t, v);
+ p256_fe_sub(r->x, t, v);           /* x' = r^2 - J - 2*V */
+ p256_fe_sub(t, v, r->x);
+ p256_fe_mul(t, rr, t);
+ p256_fe_sub(r->y, t, s2);          /* y' = r*(V - x') - 2*y1*J */
+}
+
+/* returns 0 for the identity */
+static int p256_point_affine(p256_fe_t x, p256_fe_t y, const p256_point_t *a)
+{
+ p256_fe_t zi, zi2;
+ if (p256_fe_is_zero(a->z)) return 0;
+ p256_fe_inv(zi, a->z);
+ p256_fe_sqr(zi2, zi);
+ p256_fe_mul(x, a->x, zi2);
+ p256_fe_mul(zi2, zi2, zi);
+ p256_fe_mul(y, a->y, zi2);
+ return 1;
+}
+
+static int p256_load_affine(p256_fe_t x, p256_fe_t y, const ec_point_t *a)
+{
+ p256_point_t t;
+ p256_fe_from_bigint(t.x, a->x);
+ p256_fe_from_bigint(t.y, a->y);
+ p256_fe_from_bigint(t.z, a->z);
+ if (p256_fe_equal(t.z, p256_one))
+ {
+  memcpy(x, t.x, sizeof(p256_fe_t));
+  memcpy(y, t.y, sizeof(p256_fe_t));
+  return 1;
+ }
+ return p256_point_affine(x, y, &t);
+}
+
+static int p256_get_bit(const uint8_t k[32], int i)
+{
+ return (k[31 - (i >> 3)] >> (i & 7)) & 1;
+}
+
+/* width-5 NAF, returns the number of digits */
+static int p256_recode_wnaf(signed char digits[257], const uint8_t k[32])
+{
+ int i, d, val = 0;
+ for (i = 0; i < 5; i++) val |= p256_get_bit(k, i) << i;
+ for (i = 0; val || i < 256; i++)
+ {
+  d = 0;
+  if (val & 1)
+  {
+   d = (val & 16)? val - 32 : val;
+   val -= d;
+  }
+  digits[i] = (signed char) d;
+  val >>= 1;
+  if (i + 5 < 256) val += p256_get_bit(k, i + 5) << 4;
+ }
+ return i;
+}
+
+/* r = k*a, a is affine; odd multiples a, 3a, ..., 15a are kept in Jacobian
+   coordinates since converting them would cost more than the saved field ops */
+static void p256_point_mul(p256_point_t *r, const p256_fe_t ax, const p256_fe_t ay, const uint8_t k[32])
+{
+ int i, d, len;
+ signed char digits[257];
+ p256_point_t t[8], a2, neg;
+ memcpy(t[0].x, ax, sizeof(p256_fe_t));
+ memcpy(t[0].y, ay, sizeof(p256_fe_t));
+ memcpy(t[0].z, p256_one, sizeof(p256_fe_t));
+ p256_point_dbl(&a2, &t[0]);
+ for (i = 1; i < 8; i++) p256_point_add(&t[i], &t[i-1], &a2);
+ len = p256_recode_wnaf(digits, k);
+ p256_point_set_identity(r);
+ for (i = len-1; i >= 0; i--)
+ {
+  p256_point_dbl(r, r);
+  d = digits[i];
+  if (d > 0)
+   p256_point_add(r, r, &t[d >> 1]);
+  else
+  if (d < 0)
+  {
+   neg = t[-d >> 1];
+   p256_fe_sub(neg.y, p256_zero, neg.y);
+   p256_point_add(r, r, &neg);
+  }
+ }
+}
+
+static int p256_store_result(bigint_t x, bigint_t y, p256_point_t *r)
+{
+ p256_fe_t rx, ry;
+ if (!p256_point_affine(rx, ry, r)) return 0;
+ p256_fe_to_bigint(x, rx);
+ if (y) p256_fe_to_bigint(y, ry);
+ return 1;
+}
+
+static int p256_get_scalar(uint8_t out[32], p256_fe_t ay, const bigint_t k)
+{
+ if (!p256_get_bytes(out, k)) return 0;
+ /* k*a = |k|*(-a) */
+ if (bigint_get_sign(k)) p256_fe_sub(ay, p256_zero, ay);
+ return 1;
+}
+
+/* signed window of 5 bits, 52 digits cover 256-bit scalars with the carry */
+#define P256_FIXED_WINDOW 5
+#define P256_FIXED_COUNT  52
+#define P256_FIXED_HALF   (1 << (P256_FIXED_WINDOW-1))
+#define P256_BATCH_SIZE   32
+
+typedef struct
+{
+ p256_fe_t x, y;
+} p256_affine_t;
+
+struct _ec_p256_table
+{
+ /* points[i][j-1] = j*2^(5*i)*G */
+ p256_affine_t points[P256_FIXED_COUNT][P256_FIXED_HALF];
+};
+
+static void p256_recode_signed(int digits[P256_FIXED_COUNT], const uint8_t k[32])
+{
+ int i, j, d, carry = 0;
+ for (i = 0; i < P256_FIXED_COUNT; i++)
+ {
+  d = carry;
+  for (j = 0; j < P256_FIXED_WINDOW; j++)
+   if (P256_FIXED_WINDOW*i + j < 256) d += p256_get_bit(k, P256_FIXED_WINDOW*i + j) << j;
+  /* d <= 2^5, carry if d > 2^4 */
+  carry = (d + P256_FIXED_HALF - 1) >> P256_FIXED_WINDOW;
+  d -= carry << P256_FIXED_WINDOW;
+  digits[i] = d;
+ }
+ assert(!carry);
+}
+
+ec_p256_table_t *ec_p256_table_create(const ec_point_t *a)
+{
+ enum { N = P256_FIXED_COUNT * P256_FIXED_HALF };
+ int i, j;
+ p256_point_t base, *pts, *row;
+ p256_fe_t *c, inv, zi, zi2;
+ p256_affine_t *out;
+ ec_p256_table_t *table;
+ if (!p256_load_affine(base.x, base.y, a)) return NULL;
+ memcpy(base.z, p256_one, sizeof(p256_fe_t));
+ /* Jacobian entries first, then one inversion for the whole table */
+ pts = (p256_point_t *) malloc(N * sizeof(p256_point_t));
+ c = (p256_fe_t *) malloc(N * sizeof(p256_fe_t));
+ for (i = 0; i < P256_FIXED_COUNT; i++)
+ {
+  row = pts + i*P256_FIXED_HALF;
+  row[0] = base;
+  for (j = 1; j < P256_FIXED_HALF; j++)
+   p256_point_add(&row[j], &row[j-1], &base);
+  p256_point_dbl(&base, &row[P256_FIXED_HALF-1]); /* next base = 2^5 * base */
+ }
+ /* c[i] = z[0]*...*z[i] */
+ memcpy(c[0], pts[0].z, sizeof(p256_fe_t));
+ for (i = 1; i < N; i++)
+  p256_fe_mul(c[i], c[i-1], pts[i].z);
+ if (p256_fe_is_zero(c[N-1]))
+ {
+  free(c);
+  free(pts);
+  return NULL;
+ }
+ table = (ec_p256_table_t *) malloc(sizeof(ec_p256_table_t));
+ p256_fe_inv(inv, c[N-1]);
+ for (i = N-1; i >= 0; i--)
+ {
+  if (i)
+  {
+   p256_fe_mul(zi, inv, c[i-1]);
+   p256_fe_mul(inv, inv, pts[i].z);
+  } else memcpy(zi, inv, sizeof(p256_fe_t));
+  out = &table->points[i / P256_FIXED_HALF][i % P256_FIXED_HALF];
+  p256_fe_sqr(zi2, zi);
+  p256_fe_mul(out->x, pts[i].x, zi2);
+  p256_fe_mul(zi2, zi2, zi);
+  p256_fe_mul(out->y, pts[i].y, zi2);
+ }
+ free(c);
+ free(pts);
+ return table;
+}
+
+void ec_p256_table_destroy(ec_p256_table_t *table)
+{
+ free(table);
+}
+
+static int p256_point_mul_fixed(p256_point_t *r, const ec_p256_table_t *table, const bigint_t k)
+{
+ int i, d, digits[P256_FIXED_COUNT];
+ const p256_affine_t *pt;
+ p256_fe_t ny;
+ uint8_t kb[32];
+ if (!p256_get_bytes(kb, k)) return 0;
+ p256_recode_signed(digits, kb);
+ p256_point_set_identity(r);
+ for (i = 0; i < P256_FIXED_COUNT; i++)
+ {
+  d = digits[i];
+  if (d > 0)
+  {
+   pt = &table->points[i][d-1];
+   p256_point_madd(r, r, pt->x, pt->y);
+  } else
+  if (d < 0)
+  {
+   pt = &table->points[i][-d-1];
+   p256_fe_sub(ny, p256_zero, pt->y);
+   p256_point_madd(r, r, pt->x, ny);
+  }
+ }
+ if (bigint_get_sign(k)) p256_fe_sub(r->y, p256_zero, r->y);
+ return 1;
+}
+
+/*
+  Complete mixed addition for a = -3 (Renes, Costello, Batina, algorithm 5): 11M.
+  Homogeneous projective coordinates, x = X/Z, y = Y/Z, the identity is (0:1:0);
+  no exceptions for any a, b must not be the identity.
+ */
+static void p256_point_madd_complete(p256_point_t *r, const p256_point_t *a, const p256_fe_t bx, const p256_fe_t by)
+{
+ p256_fe_t t0, t1, t2, t3, t4, x3, y3, z3;
+ p256_fe_mul(t0, a->x, bx);
+ p256_fe_mul(t1, a->y, by);
+ p256_fe_add(t3, bx, by);
+ p256_fe_add(t4, a->x, a->y);
+ p256_fe_mul(t3, t3, t4);
+ p256_fe_add(t4, t0, t1);
+ p256_fe_sub(t3, t3, t4);
+ p256_fe_mul(t4, by, a->z);
+ p256_fe_add(t4, t4, a->y);
+ p256_fe_mul(y3, bx, a->z);
+ p256_fe_add(y3, y3, a->x);
+ p256_fe_mul(z3, p256_b, a->z);
+ p256_fe_sub(x3, y3, z3);
+ p256_fe_add(z3, x3, x3);
+ p256_fe_add(x3, x3, z3);
+ p256_fe_sub(z3, t1, x3);
+ p256_fe_add(x3, t1, x3);
+ p256_fe_mul(y3, p256_b, y3);
+ p256_fe_add(t1, a->z, a->z);
+ p256_fe_add(t2, t1, a->z);
+ p256_fe_sub(y3, y3, t2);
+ p256_fe_sub(y3, y3, t0);
+ p256_fe_add(t1, y3, y3);
+ p256_fe_add(y3, t1, y3);
+ p256_fe_add(t1, t0, t0);
+ p256_fe_add(t0, t1, t0);
+ p256_fe_sub(t0, t0, t2);
+ p256_fe_mul(t1, t4, y3);
+ p256_fe_mul(t2, t0, y3);
+ p256_fe_mul(y3, x3, z3);
+ p256_fe_add(r->y, y3, t2);
+ p256_fe_mul(x3, t3, x3);
+ p256_fe_sub(r->x, x3, t1);
+ p256_fe_mul(z3, t4, z3);
+ p256_fe_mul(t1, t3, t0);
+ p256_fe_add(r->z, z3, t1);
+}
+
+/* (x, y) = d*row[0], reads every entry of the row; d = 0 gives an invalid point */
+static void p256_select(p256_fe_t x, p256_fe_t y, const p256_affine_t *row, int d)
+{
+ uint64_t sign = (unsigned) d >> 31, e;
+ uint64_t abs_d = ((uint64_t) d ^ (0 - sign)) + sign;
+ p256_fe_t ny;
+ int j;
+ memset(x, 0, sizeof(p256_fe_t));
+ memset(y, 0, sizeof(p256_fe_t));
+ for (j = 0; j < P256_FIXED_HALF; j++)
+ {
+  e = (uint64_t) (j+1) ^ abs_d;
+  e = ((e | (0 - e)) >> 63) ^ 1;
+  p256_fe_cmov(x, row[j].x, e);
+  p256_fe_cmov(y, row[j].y, e);
+ }
+ p256_fe_sub(ny, p256_zero, y);
+ p256_fe_cmov(y, ny, sign);
+}
+
+/* the sequence of operations and memory accesses doesn't depend on k */
+static int p256_point_mul_fixed_ct(p256_point_t *r, const ec_p256_table_t *table, const bigint_t k)
+{
+ int i, digits[P256_FIXED_COUNT];
+ p256_fe_t x, y;
+ p256_point_t t;
+ uint64_t nz;
+ uint8_t kb[32];
+ if (!p256_get_bytes(kb, k)) return 0;
+ p256_recode_signed(digits, kb);
+ memset(r->x, 0, sizeof(p256_fe_t));
+ memcpy(r->y, p256_one, sizeof(p256_fe_t));
+ memset(r->z, 0, sizeof(p256_fe_t));
+ for (i = 0; i < P256_FIXED_COUNT; i++)
+ {
+  p256_select(x, y, table->points[i], digits[i]);
+  p256_point_madd_complete(&t, r, x, y);
+  nz = (uint64_t) (digits[i] | -digits[i]) >> 63;
+  p256_fe_cmov(r->x, t.x, nz);
+  p256_fe_cmov(r->y, t.y, nz);
+  p256_fe_cmov(r->z, t.z, nz);
+ }
+ memset(kb, 0, sizeof(kb));
+ memset(digits, 0, sizeof(digits));
+ return 1;
+}
+
+int ec_p256_point_mul_fixed_ct(bigint_t x, bigint_t y, const ec_p256_table_t *table, const bigint_t k)
+{
+ p256_point_t r;
+ p256_fe_t zi;
+ if (bigint_get_sign(k) || !p256_point_mul_fixed_ct(&r, table, k)) return 0;
+ if (p256_fe_is_zero(r.z)) return 0;
+ p256_fe_inv(zi, r.z);
+ p256_fe_mul(r.x, r.x, zi);
+ p256_fe_to_bigint(x, r.x);
+ if (y)
+ {
+  p256_fe_mul(r.y, r.y, zi);
+  p256_fe_to_bigint(y, r.y);
+ }
+ return 1;
+}
+
+int ec_p256_points_mul_fixed_ct(bigint_t *x, bigint_t *y, const ec_p256_table_t *table,
+                                const bigint_t *k, size_t count)
+{
+ p256_point_t r[P256_BATCH_SIZE];
+ p256_fe_t c[P256_BATCH_SIZE], inv, zi;
+ size_t i, n;
+ for (; count; count -= n, x += n, y += n, k += n)
+ {
+  n = count < P256_BATCH_SIZE? count : P256_BATCH_SIZE;
+  for (i = 0; i < n; i++)
+  {
+   if (bigint_get_sign(k[i]) || !p256_point_mul_fixed_ct(r + i, table, k[i])) return 0;
+   /* c[i] = z[0]*...*z[i] */
+   if (i)
+    p256_fe_mul(c[i], c[i-1], r[i].z);
+   else
+    memcpy(c[0], r[0].z, sizeof(p256_fe_t));
+  }
+  if (p256_fe_is_zero(c[n-1])) return 0;
+  p256_fe_inv(inv, c[n-1]);
+  for (i = n-1; i > 0; i--)
+  {
+   p256_fe_mul(zi, inv, c[i-1]);
+   p256_fe_mul(inv, inv, r[i].z);
+   p256_fe_mul(r[i].x, r[i].x, zi);
+   p256_fe_mul(r[i].y, r[i].y, zi);
+  }
+  p256_fe_mul(r[0].x, r[0].x, inv);
+  p256_fe_mul(r[0].y, r[0].y, inv);
+  for (i = 0; i < n; i++)
+  {
+   p256_fe_to_bigint(x[i], r[i].x);
+   p256_fe_to_bigint(y[i], r[i].y);
+  }
+ }
+ return 1;
+}
+
+int ec_p256_point_mul_fixed(bigint_t x, bigint_t y, const ec_p256_table_t *table, const bigint_t k)
+{
+ p256_point_t r;
+ if (!p256_point_mul_fixed(&r, table, k)) return 0;
+ return p256_store_result(x, y, &r);
+}
+
+int ec_p256_point_mul2_fixed(ec_point_t *res, const ec_p256_table_t *table, const bigint_t ka,
+                             const ec_point_t *b, const bigint_t kb)
+{
+ p256_fe_t bx, by;
+ p256_point_t r, t;
+ uint8_t kbb[32];
+ if (!p256_point_mul_fixed(&r, table, ka)) return 0;
+ if (p256_load_affine(bx, by, b))
+ {
+  if (!p256_get_scalar(kbb, by, kb)) return 0;
+  p256_point_mul(&t, bx, by, kbb);
+  p256_point_add(&r, &r, &t);
+ }
+ p256_fe_to_bigint(res->x, r.x);
+ p256_fe_to_bigint(res->y, r.y);
+ p256_fe_to_bigint(res->z, r.z);
+ return 1;
+}
+
+int ec_p256_point_mul2_tables(ec_point_t *res, const ec_p256_table_t *ta, const bigint_t ka,
+                              const ec_p256_table_t *tb, const bigint_t kb)
+{
+ p256_point_t r, t;
+ if (!p256_point_mul_fixed(&r, ta, ka)) return 0;
+ if (!p256_point_mul_fixed(&t, tb, kb)) return 0;
+ p256_point_add(&r, &r, &t);
+ p256_fe_to_bigint(res->x, r.x);
+ p256_fe_to_bigint(res->y, r.y);
+ p256_fe_to_bigint(res->z, r.z);
+ return 1;
+}
+
+int ec_p256_point_decompress(bigint_t y, const bigint_t x, int odd)
+{
+ static const p256_fe_t three = { 3, 0, 0, 0 };
+ p256_fe_t fx, fy, t;
+ uint8_t buf[32], check[32];
+ if (bigint_get_sign(x) || !p256_get_bytes(buf, x)) return 0;
+ p256_fe_load(fx, buf);
+ p256_fe_store(check, fx);
+ if (memcmp(buf, check, 32)) return 0; /* x >= p */
+ /* y^2 = x^3 - 3*x + b */
+ p256_fe_sqr(t, fx);
+ p256_fe_sub(t, t, three);
+ p256_fe_mul(t, t, fx);
+ p256_fe_add(t, t, p256_b);
+ p256_fe_sqrt(fy, t);
+ p256_fe_sqr(fx, fy);
+ if (!p256_fe_equal(fx, t)) return 0;
+ if ((int) (fy[0] & 1) != odd)
+ {
+  if (p256_fe_is_zero(fy)) return 0;
+  p256_fe_sub(fy, p256_zero, fy);
+ }
+ p256_fe_to_bigint(y, fy);
+ return 1;
+}
+
+int ec_p256_point_mul(bigint_t x, bigint_t y, const ec_point_t *a, const bigint_t k)
+{
+ p256_fe_t ax, ay;
+ p256_point_t r;
+ uint8_t kb[32];
+ if (!p256_load_affine(ax, ay, a)) return 0;
+ if (!p256_get_scalar(kb, ay, k)) return 0;
+ p256_point_mul(&r, ax, ay, kb);
+ return p256_store_result(x, y, &r);
+}
+
+int ec_p256_point_mul2(bigint_t x, bigint_t y,
+                       const ec_point_t *a, const bigint_t ka,
+                       const ec_point_t *b, const bigint_t kb)
+{
+ int i, bit_a, bit_b, ab_valid;
+ p256_fe_t ax, ay, bx, by, abx, aby;
+ p256_point_t r;
+ uint8_t kab[32], kbb[32];
+ int a_valid = p256_load_affine(ax, ay, a);
+ int b_valid = p256_load_affine(bx, by, b);
+ if (a_valid && !p256_get_scalar(kab, ay, ka)) return 0;
+ if (b_valid && !p256_get_scalar(kbb, by, kb)) return 0;
+ if (!(a_valid && b_valid))
+ {
+  if (a_valid)
+   p256_point_mul(&r, ax, ay, kab);
+  else
+  if (b_valid)
+   p256_point_mul(&r, bx, by, kbb);
+  else return 0;
+  return p256_store_result(x, y, &r);
+ }
+ /* Shamir's trick with a + b precomputed */
+ memcpy(r.x, ax, sizeof(p256_fe_t));
+ memcpy(r.y, ay, sizeof(p256_fe_t));
+ memcpy(r.z, p256_one, sizeof(p256_fe_t));
+ p256_point_madd(&r, &r, bx, by);
+ ab_valid = p256_point_affine(abx, aby, &r);
+ p256_point_set_identity(&r);
+ for (i = 255; i >= 0; i--)
+ {
+  p256_point_dbl(&r, &r);
+  bit_a = p256_get_bit(kab, i);
+  bit_b = p256_get_bit(kbb, i);
+  if (bit_a && bit_b && ab_valid)
+   p256_point_madd(&r, &r, abx, aby);
+  else
+  {
+   if (bit_a) p256_point_madd(&r, &r, ax, ay);
+   if (bit_b) p256_point_madd(&r, &r, bx, by);
+  }
+ }
+ return p256_store_result(x, y, &r);
+}
@@ -0,0 +1,52 @@
+#ifndef __ec_p256_h__
+#define __ec_p256_h__
+
+#include "ec_common.h"
+
+/*
+  NIST P-256 (secp256r1) with fixed-width field arithmetic
+    p = 2^256 - 2^224 + 2^192 + 2^96 - 1
+  Points are passed as bigints, computations use 4x64-bit limbs
+  and don't allocate memory.
+ */
+
+typedef struct _ec_p256_table ec_p256_table_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* (x, y) = k*a, returns 0 if the result is the identity; y may be NULL */
+int ec_p256_point_mul(bigint_t x, bigint_t y, const ec_point_t *a, const bigint_t k);
+/* (x, y) = ka*a + kb*b */
+int ec_p256_point_mul2(bigint_t x, bigint_t y,
+                       const ec_point_t *a, const bigint_t ka,
+                       const ec_point_t *b, const bigint_t kb);
+
+/* y of the point with the given x and parity of y, returns 0 if there is no such point */
+int ec_p256_point_decompress(bigint_t y, const bigint_t x, int odd);
+
+/* precomputed multiples of a fixed point, returns NULL for the identity */
+ec_p256_table_t *ec_p256_table_create(const ec_point_t *a);
+void ec_p256_table_destroy(ec_p256_table_t *table);
+/* (x, y) = k*a without doublings */
+int ec_p256_point_mul_fixed(bigint_t x, bigint_t y, const ec_p256_table_t *table, const bigint_t k);
+/* same in constant time for secret scalars, k >= 0 */
+int ec_p256_point_mul_fixed_ct(bigint_t x, bigint_t y, const ec_p256_table_t *table, const bigint_t k);
+/* (x[i], y[i]) = k[i]*a for count scalars in constant time, the results are
+   converted to affine with one inversion per 32 points; returns 0 if any of them is the identity */
+int ec_p256_points_mul_fixed_ct(bigint_t *x, bigint_t *y, const ec_p256_table_t *table,
+                                const bigint_t *k, size_t count);
+/* res = ka*a + kb*b in Jacobian coordinates, a is given by its table; returns 0 on error */
+int ec_p256_point_mul2_fixed(ec_point_t *res, const ec_p256_table_t *table, const bigint_t ka,
+                             const ec_point_t *b, const bigint_t kb);
+/* same with both points given by their tables */
+int ec_p256_point_mul2_tables(ec_point_t *res, const ec_p256_table_t *ta, const bigint_t ka,
+                              const ec_p256_table_t *tb, const bigint_t kb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
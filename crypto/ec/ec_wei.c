@@ -1,7 +1,11 @@
 #include "ec_wei.h"
+#include <stdlib.h>
+#include <stdint.h>
 #include <limits.h>
 #include <assert.h>
 
+#define SQRT_WINDOW 6
+
 void ec_wei_def_init(ec_wei_def_t *def, bigint_t p, bigint_t a, bigint_t b)
 {
  def->p = p;
@@ -86,6 +90,21 @@ void ec_wei_point_neg(ec_point_t *a)
  bigint_set_sign(a->y, !bigint_get_sign(a->y));
 }
 
+static void cswap(bigint_t *a, bigint_t *b, uintptr_t mask)
+{
+ uintptr_t x = ((uintptr_t) *a ^ (uintptr_t) *b) & mask;
+ *a = (bigint_t) ((uintptr_t) *a ^ x);
+ *b = (bigint_t) ((uintptr_t) *b ^ x);
+}
+
+void ec_wei_point_cswap(ec_point_t *a, ec_point_t *b, int flag)
+{
+ uintptr_t mask = 0 - (uintptr_t) flag;
+ cswap(&a->x, &b->x, mask);
+ cswap(&a->y, &b->y, mask);
+ cswap(&a->z, &b->z, mask);
+}
+
 void ec_wei_scratch_init(ec_scratch_t *s, const ec_wei_def_t *def)
 {
  int n = bigint_get_word_count(def->p) << 1;
@@ -104,3 +123,193 @@ void ec_wei_scratch_destroy(ec_scratch_t *s)
  #endif
  for (i = 0; i < 10; i++) bigint_destroy(s->v[i]);
 }
+
+void ec_wei_fixed_table_alloc(ec_fixed_table_t *t, const ec_wei_def_t *def, int bits, int window)
+{
+ int i, size;
+ t->window = window;
+ t->count = (bits + window) / window; /* one more bit for the carry */
+ size = t->count << (window-1);
+ t->points = (ec_point_t *) malloc(size * sizeof(ec_point_t));
+ for (i = 0; i < size; i++) ec_wei_point_init(t->points + i, def);
+}
+
+void ec_wei_fixed_table_destroy(ec_fixed_table_t *t)
+{
+ int i, size = t->count << (t->window-1);
+ for (i = 0; i < size; i++) ec_wei_point_destroy(t->points + i);
+ free(t->points);
+ t->points = NULL;
+}
+
+int ec_wei_recode_signed(int *digits, const bigint_t k, int window, int count)
+{
+ int i, j, d, carry = 0;
+ if (bigint_get_bit_count(k) > window*count) return 0;
+ for (i = 0; i < count; i++)
+ {
+  d = carry;
+  for (j = 0; j < window; j++)
+   d += bigint_get_bit(k, window*i + j) << j;
+  carry = d > 1 << (window-1);
+  if (carry) d -= 1 << window;
+  digits[i] = d;
+ }
+ return !carry;
+}
+
+void ec_wei_sqrt_init(ec_sqrt_def_t *sq, const ec_wei_def_t *def, ec_scratch_t *s)
+{
+ int i, e = 1;
+ sq->exp = bigint_create(0);
+ sq->q = bigint_create(0);
+ sq->c = sq->dlog = NULL;
+ bigint_subw(sq->q, def->p, 1);
+ while (!bigint_get_bit(sq->q, e)) e++;
+ bigint_rshift(sq->q, sq->q, e);
+ sq->e = e;
+ sq->window = e < SQRT_WINDOW? e : SQRT_WINDOW;
+ if (e == 1)
+ {
+  bigint_addw(sq->exp, def->p, 1);
+  bigint_rshift(sq->exp, sq->exp, 2);
+  return;
+ }
+ bigint_addw(sq->exp, sq->q, 1);
+ bigint_rshift(sq->exp, sq->exp, 1);
+ /* smallest non-residue: z^((p-1)/2) = -1 */
+ bigint_subw(s->v[0], def->p, 1);
+ bigint_rshift(s->v[0], s->v[0], 1);
+ bigint_subw(s->v[1], def->p, 1);
+ bigint_set_word(s->v[2], 2);
+ for (;;)
+ {
+  bigint_mpow(s->v[3], s->v[2], s->v[0], def->p);
+  if (!bigint_cmp(s->v[3], s->v[1])) break;
+  bigint_addw(s->v[2], s->v[2], 1);
+ }
+ bigint_minv(s->v[3], s->v[2], def->p);
+ sq->c = (bigint_t *) malloc(e * sizeof(bigint_t));
+ sq->c[0] = bigint_create(0);
+ bigint_mpow(sq->c[0], s->v[3], sq->q, def->p);
+ for (i = 1; i < e; i++)
+ {
+  sq->c[i] = bigint_create(0);
+  bigint_mmul(sq->c[i], sq->c[i-1], sq->c[i-1], def->p);
+ }
+ sq->dlog = (bigint_t *) malloc(sizeof(bigint_t) << sq->window);
+ sq->dlog[0] = bigint_create_word(1);
+ for (i = 1; i < 1 << sq->window; i++)
+ {
+  sq->dlog[i] = bigint_create(0);
+  bigint_mmul(sq->dlog[i], sq->dlog[i-1], sq->c[e - sq->window], def->p);
+ }
+}
+
+void ec_wei_sqrt_destroy(ec_sqrt_def_t *sq)
+{
+ int i;
+ bigint_destroy(sq->exp);
+ bigint_destroy(sq->q);
+ if (!sq->c) return;
+ for (i = 0; i < sq->e; i++) bigint_destroy(sq->c[i]);
+ for (i = 0; i < 1 << sq->window; i++) bigint_destroy(sq->dlog[i]);
+ free(sq->c);
+ free(sq->dlog);
+}
+
+int ec_wei_sqrt(bigint_t r, const bigint_t a, const ec_sqrt_def_t *sq,
+                const ec_wei_def_t *def, ec_scratch_t *s)
+{
+ int i, j, w, d, size = 1 << sq->window;
+ bigint_mpow(r, a, sq->exp, def->p);
+ if (sq->c && !bigint_eq_word(a, 0))
+ {
+  /* r = a^((q+1)/2), t = a^q = u^-k; then sqrt(a) = r*u^(k/2).
+     k is found window by window, t*u^k so far is kept in v0 */
+  bigint_t t = s->v[0], y = s->v[1];
+  bigint_mpow(t, a, sq->q, def->p);
+  for (i = 0; i < sq->e; i += w)
+  {
+   w = sq->e - i;
+   if (w > sq->window) w = sq->window;
+   /* y has order 2^w at most */
+   bigint_copy(y, t);
+   for (j = sq->e - i - w; j; j--) bigint_mmul(y, y, y, def->p);
+   for (j = 0; j < size && bigint_cmp(y, sq->dlog[j]); j++);
+   if (j == size) return 0;
+   d = ((size - j) & (size - 1)) >> (sq->window - w);
+   for (j = i; d; j++, d >>= 1)
+    if (d & 1)
+    {
+     if (!j) return 0; /* k is odd */
+     bigint_mmul(t, t, sq->c[j], def->p);
+     bigint_mmul(r, r, sq->c[j-1], def->p);
+    }
+  }
+ }
+ bigint_mmul(s->v[3], r, r, def->p);
+ return bigint_cmp(s->v[3], a) == 0;
+}
+
+int ec_wei_wnaf_window(const ec_wei_def_t *def)
+{
+ int bits = bigint_get_bit_count(def->p);
+ return bits <= 256? 4 : 5;
+}
+
+int ec_wei_recode_wnaf(signed char *digits, const bigint_t k, int window)
+{
+ int i, d, full = 1 << window, half = full >> 1;
+ int n = bigint_get_bit_count(k);
+ int val = 0;
+ for (i = 0; i < window; i++) val |= bigint_get_bit(k, i) << i;
+ for (i = 0; val || i < n; i++)
+ {
+  d = 0;
+  if (val & 1)
+  {
+   d = (val & half)? val - full : val;
+   val -= d; /* 0 or 2^window */
+  }
+  digits[i] = (signed char) d;
+  val = (val >> 1) + (bigint_get_bit(k, i + window) << (window-1));
+ }
+ return i;
+}
+
+int ec_wei_ladder_scalar(bigint_t t, const bigint_t k, const bigint_t n, ec_scratch_t *s)
+{
+ int bits = bigint_get_bit_count(n);
+ bigint_add(s->v[0], k, n);
+ bigint_add(s->v[1], s->v[0], n);
+ cswap(&s->v[0], &s->v[1], (uintptr_t) bigint_get_bit(s->v[0], bits) - 1);
+ bigint_copy(t, s->v[0]);
+ return bits;
+}
+
+/* c = round(k*g/2^shift) */
+static void glv_round(bigint_t c, const bigint_t k, const bigint_t g, int shift)
+{
+ bigint_mul(c, k, g);
+ bigint_rshift(c, c, shift-1);
+ bigint_addw(c, c, 1);
+ bigint_rshift(c, c, 1);
+}
+
+void ec_wei_glv_split(bigint_t k1, bigint_t k2, const bigint_t k, const ec_glv_def_t *glv, ec_scratch_t *s)
+{
+ glv_round(s->v[0], k, glv->g1, glv->shift);   /* c1 */
+ glv_round(s->v[1], k, glv->g2, glv->shift);   /* c2 */
+ /* k1 = k - c1*a1 - c2*a2 */
+ bigint_mul(s->v[2], s->v[0], glv->a1);
+ bigint_sub(k1, k, s->v[2]);
+ bigint_mul(s->v[2], s->v[1], glv->a2);
+ bigint_sub(k1, k1, s->v[2]);
+ /* k2 = -c1*b1 - c2*b2 */
+ bigint_mul(s->v[2], s->v[0], glv->b1);
+ bigint_mul(s->v[3], s->v[1], glv->b2);
+ bigint_add(s->v[2], s->v[2], s->v[3]);
+ bigint_set_word(k2, 0);
+ bigint_sub(k2, k2, s->v[2]);
+}
@@ -11,6 +11,39 @@ typedef struct _ec_wei_def
  int am3_flag; /* a = -3 ? */
 } ec_wei_def_t;
 
+/* GLV endomorphism: phi(x, y) = (beta*x, y) = lambda*(x, y) */
+typedef struct _ec_glv_def
+{
+ bigint_t n;      /* group order */
+ bigint_t beta;   /* cube root of unity mod p */
+ bigint_t a1, b1; /* short basis of {(x, y): x + y*lambda = 0 mod n} */
+ bigint_t a2, b2;
+ bigint_t g1, g2; /* round(2^shift*b2/n), round(-2^shift*b1/n) */
+ int shift;
+} ec_glv_def_t;
+
+/* square roots mod p, computed once per curve */
+typedef struct _ec_sqrt_def
+{
+ bigint_t exp; /* (p+1)/4 if p = 3 mod 4, else (q+1)/2 */
+ bigint_t q;   /* p - 1 = q*2^e, q is odd */
+ /* Tonelli-Shanks tables, NULL if p = 3 mod 4;
+    u = z^-q for a non-residue z generates the subgroup of order 2^e */
+ bigint_t *c;    /* c[i] = u^(2^i), i < e */
+ bigint_t *dlog; /* dlog[j] = u^(j*2^(e-window)), j < 2^window */
+ int e;
+ int window;
+} ec_sqrt_def_t;
+
+/* multiples of a fixed point P for signed window scalar multiplication:
+   points[(i << (window-1)) + j-1] = j*2^(window*i)*P, j = 1..2^(window-1) */
+typedef struct _ec_fixed_table
+{
+ int window;
+ int count;          /* number of digits */
+ ec_point_t *points; /* affine */
+} ec_fixed_table_t;
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -27,10 +60,39 @@ int  ec_wei_point_check(const bigint_t x, const bigint_t y, const ec_wei_def_t *
 void ec_wei_point_copy(ec_point_t *res, const ec_point_t *a);
 void ec_wei_point_move(ec_point_t *res, ec_point_t *a);
 void ec_wei_point_neg(ec_point_t *a);
+/* swaps a and b if flag is 1 without branches, the bigints are not copied */
+void ec_wei_point_cswap(ec_point_t *a, ec_point_t *b, int flag);
 
 void ec_wei_scratch_init(ec_scratch_t *s, const ec_wei_def_t *def);
 void ec_wei_scratch_destroy(ec_scratch_t *s);
 
+void ec_wei_fixed_table_alloc(ec_fixed_table_t *t, const ec_wei_def_t *def, int bits, int window);
+void ec_wei_fixed_table_destroy(ec_fixed_table_t *t);
+
+void ec_wei_sqrt_init(ec_sqrt_def_t *sq, const ec_wei_def_t *def, ec_scratch_t *s);
+void ec_wei_sqrt_destroy(ec_sqrt_def_t *sq);
+/* r = sqrt(a) for 0 <= a < p, Tonelli-Shanks if p = 1 mod 4;
+   returns 0 if a is not a square */
+int  ec_wei_sqrt(bigint_t r, const bigint_t a, const ec_sqrt_def_t *sq,
+                 const ec_wei_def_t *def, ec_scratch_t *s);
+
+/* window width for ec_*_point_mul_wnaf */
+int  ec_wei_wnaf_window(const ec_wei_def_t *def);
+/* width-w NAF: digits are 0 or odd with |d| < 2^(window-1), window <= 7;
+   digits must hold bit_count(k)+1 entries, returns the number of digits */
+int  ec_wei_recode_wnaf(signed char *digits, const bigint_t k, int window);
+
+/* t = k + n or k + 2n, whichever has bit_count(n)+1 bits, so that the ladder
+   does the same steps for every k; returns bit_count(n), 0 <= k < n */
+int  ec_wei_ladder_scalar(bigint_t t, const bigint_t k, const bigint_t n, ec_scratch_t *s);
+
+/* k = k1 + k2*lambda mod n, |k1| and |k2| are about sqrt(n); 0 <= k < n */
+void ec_wei_glv_split(bigint_t k1, bigint_t k2, const bigint_t k, const ec_glv_def_t *glv, ec_scratch_t *s);
+
+/* k = sum(digits[i]*2^(window*i)), -2^(window-1) < digits[i] <= 2^(window-1),
+   returns 0 if count digits are not enough */
+int  ec_wei_recode_signed(int *digits, const bigint_t k, int window, int count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,761 @@
+#ifndef __ec_wei_fe_h__
+#define __ec_wei_fe_h__
+
+// Short Weierstrass curve arithmetic on a fixed number of 64-bit limbs.
+// The limb count and the reduction are template parameters, so the loops
+// have constant bounds and are unrolled by the compiler. A reduction
+// policy R provides:
+//   enum { N }                         number of limbs
+//   static const uint64_t *modulus()   p, N limbs
+//   static void reduce(r, t)           r = t*c mod p, t < p^2 has 2N limbs
+//   static void encode(r, a)           internal form of a < p
+//   static void decode(r, a)           inverse of encode
+// where c is 1 for the special primes and 1/2^(64N) for Montgomery.
+
+#include "ec_wei.h"
+#include <platform/umul.h>
+#include <string.h>
+#include <assert.h>
+
+namespace ec_fe
+{
+
+// r = a + b, returns the carry
+template<int N>
+static inline uint64_t add_n(uint64_t *r, const uint64_t *a, const uint64_t *b)
+{
+ uint64_t carry = 0, x;
+ for (int i = 0; i < N; i++)
+ {
+  x = a[i] + carry;
+  carry = x < carry;
+  r[i] = x + b[i];
+  carry += r[i] < x;
+ }
+ return carry;
+}
+
+// r = a - b, returns the borrow
+template<int N>
+static inline uint64_t sub_n(uint64_t *r, const uint64_t *a, const uint64_t *b)
+{
+ uint64_t borrow = 0, x, y;
+ for (int i = 0; i < N; i++)
+ {
+  x = a[i];
+  y = b[i] + borrow;
+  borrow = (y < borrow) | (x < y);
+  r[i] = x - y;
+ }
+ return borrow;
+}
+
+// t = a*b, 2N limbs
+template<int N>
+static inline void mul_n(uint64_t *t, const uint64_t *a, const uint64_t *b)
+{
+ uint64_t carry, lo, hi;
+ for (int i = 0; i < N; i++) t[i] = 0;
+ for (int i = 0; i < N; i++)
+ {
+  carry = 0;
+  for (int j = 0; j < N; j++)
+  {
+   lo = umul64(&hi, a[j], b[i]);
+   lo += carry;
+   hi += lo < carry;
+   lo += t[i+j];
+   hi += lo < t[i+j];
+   t[i+j] = lo;
+   carry = hi;
+  }
+  t[i+N] = carry;
+ }
+}
+
+// t = a^2, the cross products are computed once and doubled
+template<int N>
+static inline void sqr_n(uint64_t *t, const uint64_t *a)
+{
+ uint64_t carry, lo, hi;
+ for (int i = 0; i < 2*N; i++) t[i] = 0;
+ for (int i = 0; i < N-1; i++)
+ {
+  carry = 0;
+  for (int j = i+1; j < N; j++)
+  {
+   lo = umul64(&hi, a[i], a[j]);
+   lo += carry;
+   hi += lo < carry;
+   lo += t[i+j];
+   hi += lo < t[i+j];
+   t[i+j] = lo;
+   carry = hi;
+  }
+  t[i+N] = carry;
+ }
+ carry = 0;
+ for (int i = 1; i < 2*N; i++)
+ {
+  hi = t[i] >> 63;
+  t[i] = t[i] << 1 | carry;
+  carry = hi;
+ }
+ carry = 0;
+ for (int i = 0; i < N; i++)
+ {
+  lo = umul64(&hi, a[i], a[i]);
+  lo += carry;
+  hi += lo < carry;
+  t[2*i] += lo;
+  hi += t[2*i] < lo;
+  t[2*i+1] += hi;
+  carry = t[2*i+1] < hi;
+ }
+}
+
+// r = t - p if t >= p or carry is set, else r = t
+template<int N>
+static inline void final_sub(uint64_t *r, const uint64_t *t, uint64_t carry, const uint64_t *p)
+{
+ uint64_t d[N];
+ uint64_t borrow = sub_n<N>(d, t, p);
+ uint64_t mask = 0 - (borrow & (carry ^ 1));
+ for (int i = 0; i < N; i++)
+  r[i] = (t[i] & mask) | (d[i] & ~mask);
+}
+
+// all ones if a = 0
+template<int N>
+static inline uint64_t zero_mask(const uint64_t *a)
+{
+ uint64_t x = 0;
+ for (int i = 0; i < N; i++) x |= a[i];
+ return ((x | (0 - x)) >> 63) - 1;
+}
+
+// s[i] are signed sums of 32-bit words; normalizes them to [0, 2^32)
+// and returns the carry out of the top word
+template<int W>
+static inline int64_t propagate(int64_t *s)
+{
+ int64_t acc = 0;
+ for (int i = 0; i < W; i++)
+ {
+  acc += s[i];
+  s[i] = (uint32_t) acc;
+  acc >>= 32;
+ }
+ return acc;
+}
+
+template<int N>
+static inline void split_words(int64_t *c, const uint64_t *t)
+{
+ for (int i = 0; i < N; i++)
+ {
+  c[2*i] = (uint32_t) t[i];
+  c[2*i+1] = t[i] >> 32;
+ }
+}
+
+template<int N>
+static inline void join_words(uint64_t *r, const int64_t *s, int words)
+{
+ for (int i = 0; i < N; i++)
+ {
+  r[i] = (uint64_t) s[2*i];
+  if (2*i+1 < words) r[i] |= (uint64_t) s[2*i+1] << 32;
+ }
+}
+
+// Generic Montgomery reduction, P provides N, p, n0 = -1/p mod 2^64 and r2 = 2^(128N) mod p
+template<class P>
+struct mont_reduce
+{
+ enum { N = P::N };
+ static const uint64_t *modulus() { return P::p(); }
+
+ static void reduce(uint64_t *r, const uint64_t *in)
+ {
+  const uint64_t *p = P::p();
+  uint64_t t[2*N], carry, top = 0, m, lo, hi, x;
+  memcpy(t, in, sizeof(t));
+  for (int i = 0; i < N; i++)
+  {
+   m = t[i] * P::n0;
+   carry = 0;
+   for (int j = 0; j < N; j++)
+   {
+    lo = umul64(&hi, m, p[j]);
+    lo += carry;
+    hi += lo < carry;
+    lo += t[i+j];
+    hi += lo < t[i+j];
+    t[i+j] = lo;
+    carry = hi;
+   }
+   x = t[i+N] + carry;
+   carry = x < carry;
+   x += top;
+   carry += x < top;
+   t[i+N] = x;
+   top = carry;
+  }
+  final_sub<N>(r, t + N, top, p);
+ }
+
+ static void encode(uint64_t *r, const uint64_t *a)
+ {
+  uint64_t t[2*N];
+  mul_n<N>(t, a, P::r2());
+  reduce(r, t);
+ }
+
+ static void decode(uint64_t *r, const uint64_t *a)
+ {
+  uint64_t t[2*N];
+  memcpy(t, a, N*sizeof(uint64_t));
+  memset(t + N, 0, N*sizeof(uint64_t));
+  reduce(r, t);
+ }
+};
+
+// Reductions for the NIST primes (FIPS 186-4, D.2) keep the values as is
+template<int N>
+struct plain_encoding
+{
+ static void encode(uint64_t *r, const uint64_t *a) { memcpy(r, a, N*sizeof(uint64_t)); }
+ static void decode(uint64_t *r, const uint64_t *a) { memcpy(r, a, N*sizeof(uint64_t)); }
+};
+
+// p = 2^192 - 2^64 - 1
+struct p192_reduce: public plain_encoding<3>
+{
+ enum { N = 3 };
+ static const uint64_t *modulus()
+ {
+  static const uint64_t p[N] = { 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFE, 0xFFFFFFFFFFFFFFFF };
+  return p;
+ }
+
+ // r = t + s2 + s3 + s4
+ static void reduce(uint64_t *r, const uint64_t *t)
+ {
+  int64_t c[12], s[6], acc;
+  split_words<6>(c, t);
+  s[0] = c[0] + c[6] + c[10];
+  s[1] = c[1] + c[7] + c[11];
+  s[2] = c[2] + c[6] + c[8] + c[10];
+  s[3] = c[3] + c[7] + c[9] + c[11];
+  s[4] = c[4] + c[8] + c[10];
+  s[5] = c[5] + c[9] + c[11];
+  // 2^192 = 2^64 + 1 (mod p)
+  for (int i = 0; i < 2; i++)
+  {
+   acc = propagate<6>(s);
+   s[0] += acc; s[2] += acc;
+  }
+  acc = propagate<6>(s);
+  assert(acc == 0);
+  join_words<N>(r, s, 6);
+  final_sub<N>(r, r, 0, modulus());
+ }
+};
+
+// p = 2^224 - 2^96 + 1, the top limb is 32 bits
+struct p224_reduce: public plain_encoding<4>
+{
+ enum { N = 4 };
+ static const uint64_t *modulus()
+ {
+  static const uint64_t p[N] = { 0x0000000000000001, 0xFFFFFFFF00000000, 0xFFFFFFFFFFFFFFFF, 0x00000000FFFFFFFF };
+  return p;
+ }
+
+ // r = t + s1 + s2 - d1 - d2
+ static void reduce(uint64_t *r, const uint64_t *t)
+ {
+  int64_t c[16], s[7], acc;
+  split_words<8>(c, t);
+  s[0] = c[0] - c[7] - c[11];
+  s[1] = c[1] - c[8] - c[12];
+  s[2] = c[2] - c[9] - c[13];
+  s[3] = c[3] + c[7] + c[11] - c[10];
+  s[4] = c[4] + c[8] + c[12] - c[11];
+  s[5] = c[5] + c[9] + c[13] - c[12];
+  s[6] = c[6] + c[10] - c[13];
+  // 2^224 = 2^96 - 1 (mod p)
+  for (int i = 0; i < 2; i++)
+  {
+   acc = propagate<7>(s);
+   s[0] -= acc; s[3] += acc;
+  }
+  acc = propagate<7>(s);
+  assert(acc == 0);
+  join_words<N>(r, s, 7);
+  final_sub<N>(r, r, 0, modulus());
+ }
+};
+
+// p = 2^384 - 2^128 - 2^96 + 2^32 - 1
+struct p384_reduce: public plain_encoding<6>
+{
+ enum { N = 6 };
+ static const uint64_t *modulus()
+ {
+  static const uint64_t p[N] =
+  {
+   0x00000000FFFFFFFF, 0xFFFFFFFF00000000, 0xFFFFFFFFFFFFFFFE,
+   0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF
+  };
+  return p;
+ }
+
+ // r = t + 2*s1 + s2 + s3 + s4 + s5 + s6 - d1 - d2 - d3
+ static void reduce(uint64_t *r, const uint64_t *t)
+ {
+  int64_t c[24], s[12], acc;
+  split_words<12>(c, t);
+  s[0] = c[0] + c[12] + c[20] + c[21] - c[23];
+  s[1] = c[1] + c[13] + c[22] + c[23] - c[12] - c[20];
+  s[2] = c[2] + c[14] + c[23] - c[13] - c[21];
+  s[3] = c[3] + c[12] + c[15] + c[20] + c[21] - c[14] - c[22] - c[23];
+  s[4] = c[4] + c[12] + c[13] + c[16] + c[20] + 2*c[21] + c[22] - c[15] - 2*c[23];
+  s[5] = c[5] + c[13] + c[14] + c[17] + c[21] + 2*c[22] + c[23] - c[16];
+  s[6] = c[6] + c[14] + c[15] + c[18] + c[22] + 2*c[23] - c[17];
+  s[7] = c[7] + c[15] + c[16] + c[19] + c[23] - c[18];
+  s[8] = c[8] + c[16] + c[17] + c[20] - c[19];
+  s[9] = c[9] + c[17] + c[18] + c[21] - c[20];
+  s[10] = c[10] + c[18] + c[19] + c[22] - c[21];
+  s[11] = c[11] + c[19] + c[20] + c[23] - c[22];
+  // 2^384 = 2^128 + 2^96 - 2^32 + 1 (mod p)
+  for (int i = 0; i < 2; i++)
+  {
+   acc = propagate<12>(s);
+   s[0] += acc; s[1] -= acc; s[3] += acc; s[4] += acc;
+  }
+  acc = propagate<12>(s);
+  assert(acc == 0);
+  join_words<N>(r, s, 12);
+  final_sub<N>(r, r, 0, modulus());
+ }
+};
+
+// p = 2^521 - 1
+struct p521_reduce: public plain_encoding<9>
+{
+ enum { N = 9 };
+ static const uint64_t *modulus()
+ {
+  static const uint64_t p[N] =
+  {
+   0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF,
+   0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF,
+   0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0x00000000000001FF
+  };
+  return p;
+ }
+
+ // r = (t mod 2^521) + (t >> 521)
+ static void reduce(uint64_t *r, const uint64_t *t)
+ {
+  uint64_t hi[N], carry;
+  for (int i = 0; i < N; i++)
+   hi[i] = t[N-1+i] >> 9 | t[N+i] << 55;
+  memcpy(r, t, N*sizeof(uint64_t));
+  r[N-1] &= 0x1FF;
+  add_n<N>(r, r, hi);
+  // r < 2^522, fold the top bit once more
+  carry = r[N-1] >> 9;
+  r[N-1] &= 0x1FF;
+  for (int i = 0; i < N; i++)
+  {
+   r[i] += carry;
+   carry = r[i] < carry;
+  }
+  final_sub<N>(r, r, 0, modulus());
+ }
+};
+
+template<class R>
+class field
+{
+ public:
+  enum { N = R::N };
+  struct elem { uint64_t v[N]; };
+
+  static void add(elem &r, const elem &a, const elem &b)
+  {
+   uint64_t carry = add_n<N>(r.v, a.v, b.v);
+   final_sub<N>(r.v, r.v, carry, R::modulus());
+  }
+
+  static void sub(elem &r, const elem &a, const elem &b)
+  {
+   uint64_t t[N];
+   uint64_t mask = 0 - sub_n<N>(r.v, a.v, b.v);
+   for (int i = 0; i < N; i++) t[i] = R::modulus()[i] & mask;
+   add_n<N>(r.v, r.v, t);
+  }
+
+  static void neg(elem &r, const elem &a)
+  {
+   elem z;
+   memset(&z, 0, sizeof(z));
+   sub(r, z, a);
+  }
+
+  static void mul(elem &r, const elem &a, const elem &b)
+  {
+   uint64_t t[2*N];
+   mul_n<N>(t, a.v, b.v);
+   R::reduce(r.v, t);
+  }
+
+  static void sqr(elem &r, const elem &a)
+  {
+   uint64_t t[2*N];
+   sqr_n<N>(t, a.v);
+   R::reduce(r.v, t);
+  }
+
+  static uint64_t is_zero(const elem &a) { return zero_mask<N>(a.v); }
+
+  // r = mask? a : b
+  static void select(elem &r, const elem &a, const elem &b, uint64_t mask)
+  {
+   for (int i = 0; i < N; i++)
+    r.v[i] = (a.v[i] & mask) | (b.v[i] & ~mask);
+  }
+
+  static void set_one(elem &r)
+  {
+   uint64_t one[N];
+   memset(one, 0, sizeof(one));
+   one[0] = 1;
+   R::encode(r.v, one);
+  }
+
+  // r = a^(p-2) with a fixed window of 4 bits, the exponent is public
+  static void inv(elem &r, const elem &a)
+  {
+   uint64_t e[N], two[N];
+   elem t[16], acc;
+   memset(two, 0, sizeof(two));
+   two[0] = 2;
+   sub_n<N>(e, R::modulus(), two);
+   set_one(t[0]);
+   t[1] = a;
+   for (int i = 2; i < 16; i++) mul(t[i], t[i-1], a);
+   int i = N*16 - 1;
+   while (!((e[i >> 4] >> ((i & 15) << 2)) & 15)) i--;
+   acc = t[(e[i >> 4] >> ((i & 15) << 2)) & 15];
+   for (i--; i >= 0; i--)
+   {
+    for (int j = 0; j < 4; j++) sqr(acc, acc);
+    int d = (e[i >> 4] >> ((i & 15) << 2)) & 15;
+    if (d) mul(acc, acc, t[d]);
+   }
+   r = acc;
+  }
+
+  // |a| < 2^(64N) as limbs, returns false if it doesn't fit
+  static bool get_limbs(uint64_t *r, const bigint_t a)
+  {
+   uint8_t buf[N*8];
+   int size = bigint_get_byte_count(a);
+   if (size > N*8) return false;
+   memset(buf, 0, sizeof(buf));
+   if (size) bigint_get_bytes_be(a, buf + sizeof(buf) - size, size);
+   for (int i = 0; i < N; i++)
+   {
+    r[i] = 0;
+    for (int j = 0; j < 8; j++)
+     r[i] |= (uint64_t) buf[sizeof(buf) - 1 - 8*i - j] << 8*j;
+   }
+   return true;
+  }
+
+  // fails unless |a| < p
+  static bool load(elem &r, const bigint_t a)
+  {
+   uint64_t t[N], d[N];
+   if (!get_limbs(t, a) || !sub_n<N>(d, t, R::modulus())) return false;
+   R::encode(r.v, t);
+   if (bigint_get_sign(a)) neg(r, r);
+   return true;
+  }
+
+  static void store(bigint_t r, const elem &a)
+  {
+   uint64_t t[N];
+   uint8_t buf[N*8];
+   R::decode(t, a.v);
+   for (int i = 0; i < N; i++)
+    for (int j = 0; j < 8; j++)
+     buf[sizeof(buf) - 1 - 8*i - j] = (uint8_t) (t[i] >> 8*j);
+   bigint_set_bytes_be(r, buf, sizeof(buf));
+  }
+};
+
+// Jacobian coordinates for y^2 = x^3 + a*x + b with a = 0 or a = -3,
+// z = 0 for the identity
+template<class F, int A>
+class curve
+{
+ public:
+  enum { N = F::N };
+  typedef typename F::elem elem;
+  struct point { elem x, y, z; };
+
+  static void set_identity(point &r)
+  {
+   F::set_one(r.x);
+   F::set_one(r.y);
+   memset(&r.z, 0, sizeof(r.z));
+  }
+
+  static void dbl(point &r, const point &a)
+  {
+   elem t1, t2, t3, t4;
+   if (A == 0)
+   {
+    // dbl-2009-l: 2M + 5S
+    F::sqr(t1, a.x);             // A = x^2
+    F::sqr(t2, a.y);             // B = y^2
+    F::mul(r.z, a.y, a.z);
+    F::add(r.z, r.z, r.z);       // z' = 2*y*z
+    F::sqr(t3, t2);              // C = B^2
+    F::add(t2, a.x, t2);
+    F::sqr(t2, t2);
+    F::sub(t2, t2, t1);
+    F::sub(t2, t2, t3);
+    F::add(t2, t2, t2);          // D = 2*((x+B)^2 - A - C)
+    F::add(t4, t1, t1);
+    F::add(t1, t4, t1);          // E = 3*A
+    F::sqr(t4, t1);
+    F::sub(t4, t4, t2);
+    F::sub(r.x, t4, t2);         // x' = E^2 - 2*D
+    F::sub(t2, t2, r.x);
+    F::mul(t2, t1, t2);
+    F::add(t3, t3, t3);
+    F::add(t3, t3, t3);
+    F::add(t3, t3, t3);
+    F::sub(r.y, t2, t3);         // y' = E*(D - x') - 8*C
+   } else
+   {
+    // dbl-2001-b: 3M + 5S
+    elem delta, gamma;
+    F::sqr(delta, a.z);
+    F::sqr(gamma, a.y);
+    F::mul(t3, a.x, gamma);      // beta = x*gamma
+    F::sub(t1, a.x, delta);
+    F::add(t2, a.x, delta);
+    F::mul(t4, t1, t2);
+    F::add(t1, t4, t4);
+    F::add(t4, t4, t1);          // alpha = 3*(x-delta)*(x+delta)
+    F::add(t1, a.y, a.z);
+    F::sqr(t1, t1);
+    F::sub(t1, t1, gamma);
+    F::sub(r.z, t1, delta);      // z' = (y+z)^2 - gamma - delta
+    F::add(t3, t3, t3);
+    F::add(t3, t3, t3);          // 4*beta
+    F::sqr(t1, t4);
+    F::add(t2, t3, t3);
+    F::sub(r.x, t1, t2);         // x' = alpha^2 - 8*beta
+    F::sub(t1, t3, r.x);
+    F::mul(t1, t4, t1);
+    F::sqr(t2, gamma);
+    F::add(t2, t2, t2);
+    F::add(t2, t2, t2);
+    F::add(t2, t2, t2);
+    F::sub(r.y, t1, t2);         // y' = alpha*(4*beta - x') - 8*gamma^2
+   }
+  }
+
+  // add-2007-bl: 11M + 5S. Sets h_zero if x(a) = x(b), r is valid only
+  // when it is not set; the identity is not handled
+  static void add_raw(point &r, const point &a, const point &b, uint64_t &h_zero, uint64_t &r_zero)
+  {
+   elem z1z1, z2z2, u1, u2, s1, s2, h, i, j, rr, v, t;
+   F::sqr(z1z1, a.z);
+   F::sqr(z2z2, b.z);
+   F::mul(u1, a.x, z2z2);
+   F::mul(u2, b.x, z1z1);
+   F::mul(s1, b.z, z2z2);
+   F::mul(s1, a.y, s1);
+   F::mul(s2, a.z, z1z1);
+   F::mul(s2, b.y, s2);
+   F::sub(h, u2, u1);
+   F::sub(rr, s2, s1);
+   h_zero = F::is_zero(h);
+   r_zero = F::is_zero(rr);
+   F::add(rr, rr, rr);           // r = 2*(S2 - S1)
+   F::add(i, h, h);
+   F::sqr(i, i);                 // I = (2*H)^2
+   F::mul(j, h, i);
+   F::mul(v, u1, i);
+   F::add(t, a.z, b.z);
+   F::sqr(t, t);
+   F::sub(t, t, z1z1);
+   F::sub(t, t, z2z2);
+   F::mul(r.z, t, h);            // z' = ((z1+z2)^2 - z1^2 - z2^2)*H
+   F::sqr(t, rr);
+   F::sub(t, t, j);
+   F::sub(t, t, v);
+   F::sub(r.x, t, v);            // x' = r^2 - J - 2*V
+   F::sub(t, v, r.x);
+   F::mul(t, rr, t);
+   F::mul(s1, s1, j);
+   F::add(s1, s1, s1);
+   F::sub(r.y, t, s1);           // y' = r*(V - x') - 2*S1*J
+  }
+
+  // r = a + b, all cases, variable time
+  static void add(point &r, const point &a, const point &b)
+  {
+   uint64_t h_zero, r_zero;
+   if (F::is_zero(b.z)) { r = a; return; }
+   if (F::is_zero(a.z)) { r = b; return; }
+   point t;
+   add_raw(t, a, b, h_zero, r_zero);
+   if (h_zero)
+   {
+    if (r_zero)
+     dbl(r, a);
+    else
+     set_identity(r);
+    return;
+   }
+   r = t;
+  }
+
+  // r = a + b in constant time, either may be the identity but a != +-b
+  static void add_ct(point &r, const point &a, const point &b)
+  {
+   uint64_t h_zero, r_zero, mask;
+   point t;
+   add_raw(t, a, b, h_zero, r_zero);
+   mask = F::is_zero(b.z);
+   select(t, a, t, mask);
+   mask = F::is_zero(a.z);
+   select(r, b, t, mask);
+  }
+
+  static void select(point &r, const point &a, const point &b, uint64_t mask)
+  {
+   F::select(r.x, a.x, b.x, mask);
+   F::select(r.y, a.y, b.y, mask);
+   F::select(r.z, a.z, b.z, mask);
+  }
+
+  static bool to_affine(elem &x, elem &y, const point &a)
+  {
+   elem zi, zi2;
+   if (F::is_zero(a.z)) return false;
+   F::inv(zi, a.z);
+   F::sqr(zi2, zi);
+   F::mul(x, a.x, zi2);
+   F::mul(zi2, zi2, zi);
+   F::mul(y, a.y, zi2);
+   return true;
+  }
+
+  static bool load_affine(point &r, const ec_point_t *a)
+  {
+   if (!(F::load(r.x, a->x) && F::load(r.y, a->y))) return false;
+   F::set_one(r.z);
+   return true;
+  }
+
+  // r = k*a in constant time with a window of 4 bits; 0 <= k < n, so
+  // the sum never meets the doubling case. bits is the length of n
+  static void mul_ct(point &r, const point &a, const uint64_t *k, int bits)
+  {
+   point t[16], s;
+   set_identity(t[0]);
+   t[1] = a;
+   dbl(t[2], a);
+   for (int i = 3; i < 16; i++) add(t[i], t[i-1], a);
+   set_identity(r);
+   for (int i = ((bits + 3) >> 2) - 1; i >= 0; i--)
+   {
+    for (int j = 0; j < 4; j++) dbl(r, r);
+    uint64_t d = (k[i >> 4] >> ((i & 15) << 2)) & 15;
+    s = t[0];
+    for (uint64_t j = 1; j < 16; j++)
+     select(s, t[j], s, 0 - (uint64_t) (((j ^ d) - 1) >> 63));
+    add_ct(r, r, s);
+   }
+  }
+
+  // width-5 NAF, returns the number of digits without the leading zeros
+  static int recode_wnaf(signed char *digits, const uint64_t *k)
+  {
+   int i, d, val = (int) (k[0] & 31);
+   for (i = 0; val || i < N*64; i++)
+   {
+    d = 0;
+    if (val & 1)
+    {
+     d = (val & 16)? val - 32 : val;
+     val -= d;
+    }
+    digits[i] = (signed char) d;
+    val >>= 1;
+    if (i + 5 < N*64) val += (int) ((k[(i + 5) >> 6] >> ((i + 5) & 63)) & 1) << 4;
+   }
+   while (i && !digits[i-1]) i--;
+   return i;
+  }
+
+  enum { MAX_MUL_POINTS = 4 };
+
+  // r = sum of k[i]*a[i] for count <= MAX_MUL_POINTS points, variable time.
+  // The doublings are shared, so half-size scalars halve their number
+  static void mul_multi(point &r, const point *a, const uint64_t *const *k, int count)
+  {
+   signed char digits[MAX_MUL_POINTS][N*64+1];
+   point t[MAX_MUL_POINTS][8], t2, neg;
+   int len[MAX_MUL_POINTS], max_len = 0;
+   for (int j = 0; j < count; j++)
+   {
+    dbl(t2, a[j]);
+    t[j][0] = a[j];
+    for (int i = 1; i < 8; i++) add(t[j][i], t[j][i-1], t2);
+    len[j] = recode_wnaf(digits[j], k[j]);
+    if (len[j] > max_len) max_len = len[j];
+   }
+   set_identity(r);
+   for (int i = max_len - 1; i >= 0; i--)
+   {
+    dbl(r, r);
+    for (int j = 0; j < count; j++)
+    {
+     int d = i < len[j]? digits[j][i] : 0;
+     if (d > 0)
+      add(r, r, t[j][d >> 1]);
+     else
+     if (d < 0)
+     {
+      neg = t[j][-d >> 1];
+      F::neg(neg.y, neg.y);
+      add(r, r, neg);
+     }
+    }
+   }
+  }
+
+  // r = ka*a + kb*b, variable time
+  static void mul2(point &r, const point &a, const uint64_t *ka, const point &b, const uint64_t *kb)
+  {
+   const point p[2] = { a, b };
+   const uint64_t *k[2] = { ka, kb };
+   mul_multi(r, p, k, 2);
+  }
+};
+
+} // end namespace
+
+#endif
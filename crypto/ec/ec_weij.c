@@ -1,4 +1,6 @@
 #include "ec_weij.h"
+#include <platform/alloca.h>
+#include <stdlib.h>
 #include <assert.h>
 
 /* dbl-2007-bl: 1M + 8S + 1m(a) + 1m(3) */
@@ -165,6 +167,98 @@ void ec_weij_point_madd(ec_point_t *res, const ec_point_t *a, const bigint_t bx,
  bigint_msub(res->z, s->v[6], s->v[0], def->p);  /*     z' = (z1 + H)^2 - z1^2 - H^2 */
 }
 
+/* dbl-2007-bl with co-Z update: upd = a with the same Z as res, 1M + 8S;
+   res != a, upd may be a */
+void ec_weij_point_dblu(ec_point_t *res, ec_point_t *upd, const ec_point_t *a, const ec_wei_def_t *def, ec_scratch_t *s)
+{
+ bigint_mmul(s->v[0], a->x, a->x, def->p);       /* 1S: v0 = XX = x^2                  */
+ bigint_mmul(s->v[1], a->y, a->y, def->p);       /* 2S: v1 = YY = y^2                  */
+ bigint_mmul(s->v[2], s->v[1], s->v[1], def->p); /* 3S: v2 = y^4                       */
+ bigint_mmul(s->v[3], a->z, a->z, def->p);       /* 4S: v3 = ZZ = z^2                  */
+ bigint_add(s->v[4], a->x, s->v[1]);             /*     v4 = x + YY                    */
+ bigint_mmul(s->v[5], s->v[4], s->v[4], def->p); /* 5S: v5 = (x+YY)^2                  */
+ bigint_sub(s->v[5], s->v[5], s->v[0]);          /*     v5 = (x+YY)^2 - XX             */
+ bigint_msub(s->v[5], s->v[5], s->v[2], def->p); /*     v5 = (x+YY)^2 - XX - y^4       */
+ bigint_madd(s->v[5], s->v[5], s->v[5], def->p); /*     v5 = S = 4*x*YY                */
+ bigint_mmul(s->v[4], s->v[3], s->v[3], def->p); /* 6S: v4 = z^4                       */
+ bigint_mmul(s->v[6], s->v[4], def->a, def->p);  /* 1m: v6 = a*z^4                     */
+ bigint_mulw(s->v[4], s->v[0], 3);               /* 2m: v4 = 3*XX                      */
+ bigint_add(s->v[0], s->v[4], s->v[6]);          /*     v0 = M = 3*XX + a*z^4          */
+ bigint_mmul(s->v[4], s->v[0], s->v[0], def->p); /* 7S: v4 = M^2                       */
+ bigint_lshift(s->v[6], s->v[5], 1);             /*     v6 = 2*S                       */
+ bigint_msub(res->x, s->v[4], s->v[6], def->p);  /*     x' = T = M^2 - 2*S             */
+ bigint_sub(s->v[4], s->v[5], res->x);           /*     v4 = S - T                     */
+ bigint_mmul(s->v[7], s->v[0], s->v[4], def->p); /* 1M: v7 = M*(S-T)                   */
+ bigint_madd(s->v[6], s->v[2], s->v[2], def->p); /*     v6 = 2*y^4                     */
+ bigint_madd(s->v[6], s->v[6], s->v[6], def->p); /*     v6 = 4*y^4                     */
+ bigint_madd(s->v[6], s->v[6], s->v[6], def->p); /*     v6 = 8*y^4                     */
+ bigint_add(s->v[4], a->y, a->z);                /*     v4 = y + z                     */
+ bigint_msub(res->y, s->v[7], s->v[6], def->p);  /*     y' = M*(S-T) - 8*y^4           */
+ bigint_mmul(s->v[0], s->v[4], s->v[4], def->p); /* 8S: v0 = (y+z)^2                   */
+ bigint_sub(s->v[0], s->v[0], s->v[1]);          /*     v0 = (y+z)^2 - YY              */
+ bigint_msub(res->z, s->v[0], s->v[3], def->p);  /*     z' = 2*y*z                     */
+ /* scaling a by lambda = 2*y gives (S : 8*y^4 : z') */
+ bigint_copy(upd->x, s->v[5]);
+ bigint_copy(upd->y, s->v[6]);
+ bigint_copy(upd->z, res->z);
+}
+
+/* co-Z addition with update (ZADDU): 5M + 2S */
+int ec_weij_point_zaddu(ec_point_t *res, ec_point_t *a, const ec_point_t *b, const ec_wei_def_t *def, ec_scratch_t *s)
+{
+ bigint_sub(s->v[0], a->x, b->x);                /*     v0 = x1 - x2                   */
+ bigint_mmul(s->v[1], s->v[0], s->v[0], def->p); /* 1S: v1 = C = (x1-x2)^2             */
+ if (bigint_eq_word(s->v[1], 0)) return 0;
+ bigint_mmul(s->v[2], a->x, s->v[1], def->p);    /* 1M: v2 = W1 = x1*C                 */
+ bigint_mmul(s->v[3], b->x, s->v[1], def->p);    /* 2M: v3 = W2 = x2*C                 */
+ bigint_sub(s->v[4], a->y, b->y);                /*     v4 = y1 - y2                   */
+ bigint_mmul(s->v[5], s->v[4], s->v[4], def->p); /* 2S: v5 = D = (y1-y2)^2             */
+ bigint_sub(s->v[6], s->v[2], s->v[3]);          /*     v6 = W1 - W2                   */
+ bigint_mmul(s->v[7], a->y, s->v[6], def->p);    /* 3M: v7 = A1 = y1*(W1-W2)           */
+ bigint_mmul(s->v[6], a->z, s->v[0], def->p);    /* 4M: v6 = z' = z*(x1-x2)            */
+ bigint_add(s->v[3], s->v[2], s->v[3]);          /*     v3 = W1 + W2                   */
+ bigint_msub(res->x, s->v[5], s->v[3], def->p);  /*     x' = D - W1 - W2               */
+ bigint_sub(s->v[5], s->v[2], res->x);           /*     v5 = W1 - x'                   */
+ bigint_mmul(s->v[0], s->v[4], s->v[5], def->p); /* 5M: v0 = (y1-y2)*(W1-x')           */
+ bigint_msub(res->y, s->v[0], s->v[7], def->p);  /*     y' = (y1-y2)*(W1-x') - A1      */
+ bigint_copy(res->z, s->v[6]);
+ bigint_copy(a->x, s->v[2]);                     /*     a = (W1 : A1 : z')             */
+ bigint_copy(a->y, s->v[7]);
+ bigint_copy(a->z, s->v[6]);
+ return 1;
+}
+
+/* conjugate co-Z addition (ZADDC): 6M + 3S */
+int ec_weij_point_zaddc(ec_point_t *sum, ec_point_t *diff, const ec_point_t *a, const ec_point_t *b,
+                        const ec_wei_def_t *def, ec_scratch_t *s)
+{
+ bigint_sub(s->v[0], a->x, b->x);                /*     v0 = x1 - x2                   */
+ bigint_mmul(s->v[1], s->v[0], s->v[0], def->p); /* 1S: v1 = C = (x1-x2)^2             */
+ if (bigint_eq_word(s->v[1], 0)) return 0;
+ bigint_mmul(s->v[2], a->x, s->v[1], def->p);    /* 1M: v2 = W1 = x1*C                 */
+ bigint_mmul(s->v[3], b->x, s->v[1], def->p);    /* 2M: v3 = W2 = x2*C                 */
+ bigint_sub(s->v[4], a->y, b->y);                /*     v4 = y1 - y2                   */
+ bigint_add(s->v[5], a->y, b->y);                /*     v5 = y1 + y2                   */
+ bigint_sub(s->v[6], s->v[2], s->v[3]);          /*     v6 = W1 - W2                   */
+ bigint_mmul(s->v[7], a->y, s->v[6], def->p);    /* 3M: v7 = A1 = y1*(W1-W2)           */
+ bigint_mmul(s->v[6], a->z, s->v[0], def->p);    /* 4M: v6 = z' = z*(x1-x2)            */
+ bigint_add(s->v[1], s->v[2], s->v[3]);          /*     v1 = W1 + W2                   */
+ /* a and b are not used below, the results may overwrite them */
+ bigint_mmul(s->v[0], s->v[4], s->v[4], def->p); /* 2S: v0 = (y1-y2)^2                 */
+ bigint_msub(sum->x, s->v[0], s->v[1], def->p);  /*     x+ = (y1-y2)^2 - W1 - W2       */
+ bigint_sub(s->v[0], s->v[2], sum->x);           /*     v0 = W1 - x+                   */
+ bigint_mmul(s->v[3], s->v[4], s->v[0], def->p); /* 5M: v3 = (y1-y2)*(W1-x+)           */
+ bigint_msub(sum->y, s->v[3], s->v[7], def->p);  /*     y+ = (y1-y2)*(W1-x+) - A1      */
+ bigint_mmul(s->v[0], s->v[5], s->v[5], def->p); /* 3S: v0 = (y1+y2)^2                 */
+ bigint_msub(diff->x, s->v[0], s->v[1], def->p); /*     x- = (y1+y2)^2 - W1 - W2       */
+ bigint_sub(s->v[0], s->v[2], diff->x);          /*     v0 = W1 - x-                   */
+ bigint_mmul(s->v[3], s->v[5], s->v[0], def->p); /* 6M: v3 = (y1+y2)*(W1-x-)           */
+ bigint_msub(diff->y, s->v[3], s->v[7], def->p); /*     y- = (y1+y2)*(W1-x-) - A1      */
+ bigint_copy(sum->z, s->v[6]);
+ bigint_copy(diff->z, s->v[6]);
+ return 1;
+}
+
 int ec_weij_point_normalize(ec_point_t *a, const ec_wei_def_t *def, ec_scratch_t *s)
 {
  if (bigint_eq_word(a->z, 0) || !bigint_minv(s->v[0], a->z, def->p))
@@ -181,6 +275,52 @@ int ec_weij_point_normalize(ec_point_t *a, const ec_wei_def_t *def, ec_scratch_t
  return 1;
 }
 
+/* Montgomery's trick: one inversion and 3(n-1) multiplications */
+int ec_weij_points_normalize(ec_point_t *pts, size_t n, const ec_wei_def_t *def, ec_scratch_t *s)
+{
+ size_t i;
+ int result = 1;
+ bigint_t *c;
+ if (!n) return 1;
+ c = (bigint_t *) malloc(n * sizeof(bigint_t));
+ /* c[i] = z[0]*...*z[i], points at infinity are skipped */
+ for (i = 0; i < n; i++)
+ {
+  c[i] = bigint_create(bigint_get_word_count(def->p));
+  if (i) bigint_copy(c[i], c[i-1]); else bigint_set_word(c[i], 1);
+  if (bigint_eq_word(pts[i].z, 0))
+  {
+   bigint_set_word(pts[i].x, 1);
+   bigint_set_word(pts[i].y, 1);
+   result = 0;
+  } else bigint_mmul(c[i], c[i], pts[i].z, def->p);
+ }
+ if (!bigint_minv(s->v[3], c[n-1], def->p))
+ {
+  for (i = 0; i < n; i++) bigint_destroy(c[i]);
+  free(c);
+  return 0;
+ }
+ for (i = n; i-- > 0;)
+ {
+  if (bigint_eq_word(pts[i].z, 0)) continue;
+  /* v0 = 1/z[i], v3 = 1/c[i-1] */
+  if (i)
+  {
+   bigint_mmul(s->v[0], s->v[3], c[i-1], def->p);
+   bigint_mmul(s->v[3], s->v[3], pts[i].z, def->p);
+  } else bigint_copy(s->v[0], s->v[3]);
+  bigint_mmul(s->v[1], s->v[0], s->v[0], def->p);
+  bigint_mmul(pts[i].x, pts[i].x, s->v[1], def->p);
+  bigint_mmul(s->v[2], s->v[1], s->v[0], def->p);
+  bigint_mmul(pts[i].y, pts[i].y, s->v[2], def->p);
+  bigint_set_word(pts[i].z, 1);
+ }
+ for (i = 0; i < n; i++) bigint_destroy(c[i]);
+ free(c);
+ return result;
+}
+
 int ec_weij_point_affine_xy(bigint_t x, bigint_t y, const ec_point_t *a, const ec_wei_def_t *def, ec_scratch_t *s)
 {
  if (bigint_eq_word(a->z, 0)) return 0;
@@ -201,8 +341,130 @@ int ec_weij_point_affine_x(bigint_t x, const ec_point_t *a, const ec_wei_def_t *
  return 1;
 }
 
+/* t[i] = (2i+1)*a in affine coordinates, returns 0 if a is the identity
+   or has a small order.
+   2a is kept co-Z with the last multiple, so each entry costs 5M + 2S
+   instead of 7M + 4S for madd, and 2a needs no inversion */
+static int odd_multiples(ec_point_t *t, int count, const ec_point_t *a, const ec_wei_def_t *def, ec_scratch_t *s)
+{
+ int i, result = 1;
+ ec_point_t a1, a2;
+ if (!ec_weij_point_affine_xy(t[0].x, t[0].y, a, def, s)) return 0;
+ bigint_set_word(t[0].z, 1);
+ if (count == 1) return 1;
+ ec_wei_point_init(&a1, def);
+ ec_wei_point_init(&a2, def);
+ ec_wei_point_copy(&a1, t);
+ ec_weij_point_dblu(&a2, &a1, t, def, s);
+ for (i = 1; i < count && result; i++)
+  result = ec_weij_point_zaddu(t + i, &a2, i == 1? &a1 : t + i-1, def, s);
+ if (result) result = ec_weij_points_normalize(t + 1, count - 1, def, s);
+ ec_wei_point_destroy(&a2);
+ ec_wei_point_destroy(&a1);
+ return result;
+}
+
+/* res += d*a, t holds odd multiples of a */
+static void add_digit(ec_point_t *res, const ec_point_t *t, int d, const ec_wei_def_t *def, ec_scratch_t *s)
+{
+ if (d > 0)
+ {
+  t += d >> 1;
+  ec_weij_point_madd(res, res, t->x, t->y, def, s);
+ } else
+ if (d < 0)
+ {
+  t += -d >> 1;
+  bigint_sub(s->v[8], def->p, t->y);
+  ec_weij_point_madd(res, res, t->x, s->v[8], def, s);
+ }
+}
+
+/* width-w NAF with a table of odd multiples a, 3a, ..., (2^(window-1)-1)a */
+void ec_weij_point_mul_wnaf(ec_point_t *res, const ec_point_t *a, const ec_wei_def_t *def,
+                           const bigint_t k, int window, ec_scratch_t *s)
+{
+ int i, len, count = 1 << (window-2);
+ ec_point_t *t;
+ signed char *digits;
+ bigint_set_word(res->x, 1);
+ bigint_set_word(res->y, 1);
+ bigint_set_word(res->z, 0);
+ t = (ec_point_t *) alloca(count * sizeof(ec_point_t));
+ for (i = 0; i < count; i++) ec_wei_point_init(t + i, def);
+ if (odd_multiples(t, count, a, def, s))
+ {
+  digits = (signed char *) alloca(bigint_get_bit_count(k) + 1);
+  len = ec_wei_recode_wnaf(digits, k, window);
+  for (i = len-1; i >= 0; i--)
+  {
+   if (def->am3_flag)
+    ec_weij_point_dbl3(res, res, def, s);
+   else
+    ec_weij_point_dbl(res, res, def, s);
+   add_digit(res, t, digits[i], def, s);
+  }
+  if (bigint_get_sign(k)) ec_wei_point_neg(res);
+ }
+ for (i = 0; i < count; i++) ec_wei_point_destroy(t + i);
+}
+
+/* k*a = k1*a + k2*phi(a) with interleaved wNAF of the half-size scalars */
+void ec_weij_point_mul_glv(ec_point_t *res, const ec_point_t *a, const ec_glv_def_t *glv,
+                          const ec_wei_def_t *def, const bigint_t k, ec_scratch_t *s)
+{
+ int i, len1, len2, window = ec_wei_wnaf_window(def), count = 1 << (window-2);
+ ec_point_t *t1, *t2;
+ signed char *digits1, *digits2;
+ bigint_t k1 = bigint_create(0);
+ bigint_t k2 = bigint_create(0);
+ bigint_set_word(res->x, 1);
+ bigint_set_word(res->y, 1);
+ bigint_set_word(res->z, 0);
+ t1 = (ec_point_t *) alloca(2 * count * sizeof(ec_point_t));
+ t2 = t1 + count;
+ for (i = 0; i < 2*count; i++) ec_wei_point_init(t1 + i, def);
+ if (!odd_multiples(t1, count, a, def, s)) goto fin;
+
+ bigint_copy(s->v[9], k);
+ bigint_set_sign(s->v[9], 0);
+ bigint_mod(s->v[9], s->v[9], glv->n);
+ ec_wei_glv_split(k1, k2, s->v[9], glv, s);
+ for (i = 0; i < count; i++)
+ {
+  /* phi(t1[i]), signs of k1 and k2 go into the tables */
+  bigint_mmul(t2[i].x, t1[i].x, glv->beta, def->p);
+  bigint_copy(t2[i].y, t1[i].y);
+  bigint_set_word(t2[i].z, 1);
+  if (bigint_get_sign(k1)) bigint_sub(t1[i].y, def->p, t1[i].y);
+  if (bigint_get_sign(k2)) bigint_sub(t2[i].y, def->p, t2[i].y);
+ }
+ digits1 = (signed char *) alloca(bigint_get_bit_count(k1) + 1);
+ digits2 = (signed char *) alloca(bigint_get_bit_count(k2) + 1);
+ len1 = ec_wei_recode_wnaf(digits1, k1, window);
+ len2 = ec_wei_recode_wnaf(digits2, k2, window);
+ for (i = (len1 > len2? len1 : len2) - 1; i >= 0; i--)
+ {
+  if (def->am3_flag)
+   ec_weij_point_dbl3(res, res, def, s);
+  else
+   ec_weij_point_dbl(res, res, def, s);
+  if (i < len1) add_digit(res, t1, digits1[i], def, s);
+  if (i < len2) add_digit(res, t2, digits2[i], def, s);
+ }
+ if (bigint_get_sign(k)) ec_wei_point_neg(res);
+
+ fin:
+ for (i = 0; i < 2*count; i++) ec_wei_point_destroy(t1 + i);
+ bigint_destroy(k2);
+ bigint_destroy(k1);
+}
+
 void ec_weij_point_mul(ec_point_t *res, const ec_point_t *a, const ec_wei_def_t *def, const bigint_t k, ec_scratch_t *s)
 {
+ #if 1
+ ec_weij_point_mul_wnaf(res, a, def, k, ec_wei_wnaf_window(def), s);
+ #else
  int i, n = bigint_get_bit_count(k);
  bigint_set_word(res->x, 1);
  bigint_set_word(res->y, 1);
@@ -233,4 +495,189 @@ void ec_weij_point_mul(ec_point_t *res, const ec_point_t *a, const ec_wei_def_t
  }
  #endif
  if (bigint_get_sign(k)) ec_wei_point_neg(res);
+ #endif
+}
+
+/* Montgomery ladder with add-2007-bl and a doubling per bit, about 12M + 13S */
+static void ladder_generic(ec_point_t *res, ec_point_t *r1, const ec_point_t *a, int i,
+                           const ec_wei_def_t *def, ec_scratch_t *s)
+{
+ int bit;
+ ec_wei_point_copy(res, a);
+ ec_weij_point_dbl(r1, res, def, s);
+ while (i-- > 0)
+ {
+  bit = bigint_get_bit(s->v[9], i);
+  ec_wei_point_cswap(res, r1, bit);
+  ec_weij_point_add(r1, res, r1, def, s);
+  if (def->am3_flag)
+   ec_weij_point_dbl3(res, res, def, s);
+  else
+   ec_weij_point_dbl(res, res, def, s);
+  ec_wei_point_cswap(res, r1, bit);
+ }
+}
+
+/* Montgomery ladder: ZADDC + ZADDU per bit of n, 11M + 5S.
+   The points are swapped by masking their handles; the last bit uses
+   the generic step, which handles k = n-1 where (k+1)*a is the identity.
+   A scalar that hits x(res) = x(r1) earlier (probability about 2^-bits)
+   is redone with the generic ladder */
+void ec_weij_point_mul_ladder(ec_point_t *res, const ec_point_t *a, const bigint_t n,
+                              const ec_wei_def_t *def, const bigint_t k, ec_scratch_t *s)
+{
+ int i, bit, result = 1;
+ ec_point_t r1;
+ if (bigint_eq_word(a->z, 0))
+ {
+  bigint_set_word(res->x, 1);
+  bigint_set_word(res->y, 1);
+  bigint_set_word(res->z, 0);
+  return;
+ }
+ i = ec_wei_ladder_scalar(s->v[9], k, n, s);
+ ec_wei_point_init(&r1, def);
+ ec_wei_point_copy(res, a);
+ /* res = m*a, r1 = (m+1)*a for the top bits m of the scalar, same Z */
+ ec_weij_point_dblu(&r1, res, a, def, s);
+ while (i-- > 1)
+ {
+  bit = bigint_get_bit(s->v[9], i);
+  ec_wei_point_cswap(res, &r1, bit);
+  /* (r1, res) = (res + r1, res - r1), then res = r1 + res */
+  result &= ec_weij_point_zaddc(&r1, res, res, &r1, def, s);
+  result &= ec_weij_point_zaddu(res, &r1, res, def, s);
+  ec_wei_point_cswap(res, &r1, bit);
+ }
+ if (!result)
+ {
+  i = bigint_get_bit_count(s->v[9]) - 1;
+  ladder_generic(res, &r1, a, i, def, s);
+ } else
+ {
+  bit = bigint_get_bit(s->v[9], 0);
+  ec_wei_point_cswap(res, &r1, bit);
+  ec_weij_point_add(&r1, res, &r1, def, s);
+  if (def->am3_flag)
+   ec_weij_point_dbl3(res, res, def, s);
+  else
+   ec_weij_point_dbl(res, res, def, s);
+  ec_wei_point_cswap(res, &r1, bit);
+ }
+ ec_wei_point_destroy(&r1);
+}
+
+/* Shamir's trick: res = ka*a + kb*b with a single chain of doublings */
+void ec_weij_point_mul2(ec_point_t *res, const ec_point_t *a, const bigint_t ka,
+                       const ec_point_t *b, const bigint_t kb,
+                       const ec_wei_def_t *def, ec_scratch_t *s)
+{
+ int i, n, bit_a, bit_b, ab_valid;
+ ec_point_t bb, ab;
+ if (!ec_weij_point_affine_xy(s->v[8], s->v[9], a, def, s))
+ {
+  ec_weij_point_mul(res, b, def, kb, s);
+  return;
+ }
+ ec_wei_point_init(&bb, def);
+ if (!ec_weij_point_affine_xy(bb.x, bb.y, b, def, s))
+ {
+  ec_wei_point_destroy(&bb);
+  ec_weij_point_mul(res, a, def, ka, s);
+  return;
+ }
+ if (bigint_get_sign(ka)) bigint_sub(s->v[9], def->p, s->v[9]);
+ if (bigint_get_sign(kb)) bigint_sub(bb.y, def->p, bb.y);
+ ec_wei_point_init(&ab, def);
+ bigint_copy(ab.x, s->v[8]);
+ bigint_copy(ab.y, s->v[9]);
+ bigint_set_word(ab.z, 1);
+ ec_weij_point_madd(&ab, &ab, bb.x, bb.y, def, s);
+ ab_valid = ec_weij_point_normalize(&ab, def, s); /* 0 if b = -a */
+
+ n = bigint_get_bit_count(ka);
+ i = bigint_get_bit_count(kb);
+ if (i > n) n = i;
+ bigint_set_word(res->x, 1);
+ bigint_set_word(res->y, 1);
+ bigint_set_word(res->z, 0);
+ for (i = n-1; i >= 0; i--)
+ {
+  if (def->am3_flag)
+   ec_weij_point_dbl3(res, res, def, s);
+  else
+   ec_weij_point_dbl(res, res, def, s);
+  bit_a = bigint_get_bit(ka, i);
+  bit_b = bigint_get_bit(kb, i);
+  if (bit_a && bit_b && ab_valid)
+   ec_weij_point_madd(res, res, ab.x, ab.y, def, s);
+  else
+  {
+   if (bit_a) ec_weij_point_madd(res, res, s->v[8], s->v[9], def, s);
+   if (bit_b) ec_weij_point_madd(res, res, bb.x, bb.y, def, s);
+  }
+ }
+ ec_wei_point_destroy(&ab);
+ ec_wei_point_destroy(&bb);
+}
+
+void ec_weij_fixed_table_init(ec_fixed_table_t *t, const ec_point_t *a, int bits, int window,
+                             const ec_wei_def_t *def, ec_scratch_t *s)
+{
+ int i, j, co_z, half = 1 << (window-1);
+ ec_point_t *row, base, q;
+ ec_wei_fixed_table_alloc(t, def, bits, window);
+ ec_wei_point_init(&base, def);
+ ec_wei_point_init(&q, def);
+ ec_wei_point_copy(&base, a);
+ /* Jacobian points, normalized at once */
+ for (i = 0; i < t->count; i++)
+ {
+  row = t->points + (i << (window-1));
+  ec_wei_point_copy(&row[0], &base);
+  if (half > 1)
+  {
+   /* base is kept co-Z with the last multiple: 5M + 2S per entry instead of 11M + 5S */
+   ec_weij_point_dblu(&row[1], &q, &base, def, s);
+   for (j = 2, co_z = 1; j < half; j++)
+    if (!(co_z && (co_z = ec_weij_point_zaddu(&row[j], &q, &row[j-1], def, s))))
+     ec_weij_point_add(&row[j], &row[j-1], &base, def, s);
+  }
+  ec_weij_point_dbl(&base, &row[half-1], def, s); /* 2^window * base */
+ }
+ ec_weij_points_normalize(t->points, t->count << (window-1), def, s);
+ ec_wei_point_destroy(&q);
+ ec_wei_point_destroy(&base);
+}
+
+void ec_weij_point_mul_fixed(ec_point_t *res, const ec_fixed_table_t *t,
+                            const ec_wei_def_t *def, const bigint_t k, ec_scratch_t *s)
+{
+ int i, d;
+ const ec_point_t *pt;
+ int *digits = (int *) alloca(t->count * sizeof(int));
+ if (!ec_wei_recode_signed(digits, k, t->window, t->count))
+ {
+  ec_weij_point_mul(res, t->points, def, k, s);
+  return;
+ }
+ bigint_set_word(res->x, 1);
+ bigint_set_word(res->y, 1);
+ bigint_set_word(res->z, 0);
+ for (i = 0; i < t->count; i++)
+ {
+  d = digits[i];
+  if (d > 0)
+  {
+   pt = t->points + (i << (t->window-1)) + d - 1;
+   ec_weij_point_madd(res, res, pt->x, pt->y, def, s);
+  } else
+  if (d < 0)
+  {
+   pt = t->points + (i << (t->window-1)) - d - 1;
+   bigint_sub(s->v[8], def->p, pt->y);
+   ec_weij_point_madd(res, res, pt->x, s->v[8], def, s);
+  }
+ }
+ if (bigint_get_sign(k)) ec_wei_point_neg(res);
 }
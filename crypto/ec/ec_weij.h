@@ -23,14 +23,47 @@ void ec_weij_point_madd(ec_point_t *res, const ec_point_t *a,
                         const bigint_t bx, const bigint_t by,
                         const ec_wei_def_t *def, ec_scratch_t *s);
 
+/* co-Z (shared Z) formulas, a and b must have the same Z:
+   dblu: res = 2a, upd = a rescaled to the Z of res; res != a
+   zaddu: res = a + b, a is rescaled to the Z of res; res may be b
+   zaddc: sum = a + b, diff = a - b with the same Z; the results may overwrite a and b
+   zaddu and zaddc return 0 if x(a) = x(b), the results are not set then */
+void ec_weij_point_dblu(ec_point_t *res, ec_point_t *upd, const ec_point_t *a,
+                        const ec_wei_def_t *def, ec_scratch_t *s);
+int  ec_weij_point_zaddu(ec_point_t *res, ec_point_t *a, const ec_point_t *b,
+                         const ec_wei_def_t *def, ec_scratch_t *s);
+int  ec_weij_point_zaddc(ec_point_t *sum, ec_point_t *diff, const ec_point_t *a, const ec_point_t *b,
+                         const ec_wei_def_t *def, ec_scratch_t *s);
+
 int ec_weij_point_affine_xy(bigint_t x, bigint_t y, const ec_point_t *a,
                             const ec_wei_def_t *def, ec_scratch_t *s);
 int ec_weij_point_affine_x(bigint_t x, const ec_point_t *a,
                            const ec_wei_def_t *def, ec_scratch_t *s);
 int ec_weij_point_normalize(ec_point_t *a, const ec_wei_def_t *def, ec_scratch_t *s);
+/* normalizes n points with a single inversion, returns 0 if any of them is the identity */
+int ec_weij_points_normalize(ec_point_t *pts, size_t n, const ec_wei_def_t *def, ec_scratch_t *s);
 
 void ec_weij_point_mul(ec_point_t *res, const ec_point_t *a,
                        const ec_wei_def_t *def, const bigint_t k, ec_scratch_t *s);
+void ec_weij_point_mul_wnaf(ec_point_t *res, const ec_point_t *a, const ec_wei_def_t *def,
+                           const bigint_t k, int window, ec_scratch_t *s);
+/* curves with an efficient endomorphism */
+void ec_weij_point_mul_glv(ec_point_t *res, const ec_point_t *a, const ec_glv_def_t *glv,
+                          const ec_wei_def_t *def, const bigint_t k, ec_scratch_t *s);
+/* constant sequence of operations for secret scalars, n is the group order, 0 <= k < n */
+void ec_weij_point_mul_ladder(ec_point_t *res, const ec_point_t *a, const bigint_t n,
+                              const ec_wei_def_t *def, const bigint_t k, ec_scratch_t *s);
+/* res = ka*a + kb*b */
+void ec_weij_point_mul2(ec_point_t *res, const ec_point_t *a, const bigint_t ka,
+                       const ec_point_t *b, const bigint_t kb,
+                       const ec_wei_def_t *def, ec_scratch_t *s);
+
+/* fixed point multiplication without doublings,
+   the table holds affine multiples of a and can be used with ec_weip too */
+void ec_weij_fixed_table_init(ec_fixed_table_t *t, const ec_point_t *a, int bits, int window,
+                             const ec_wei_def_t *def, ec_scratch_t *s);
+void ec_weij_point_mul_fixed(ec_point_t *res, const ec_fixed_table_t *t,
+                            const ec_wei_def_t *def, const bigint_t k, ec_scratch_t *s);
 
 #ifdef __cplusplus
 }
@@ -1,4 +1,6 @@
 #include "ec_weip.h"
+#include <platform/alloca.h>
+#include <stdlib.h>
 #include <assert.h>
 
 /* dbl-2007-bl: 5M + 6S + 1m(a) + 1m(3) */
@@ -169,6 +171,50 @@ int ec_weip_point_normalize(ec_point_t *a, const ec_wei_def_t *def, ec_scratch_t
  return 1;
 }
 
+/* Montgomery's trick: one inversion and 3(n-1) multiplications */
+int ec_weip_points_normalize(ec_point_t *pts, size_t n, const ec_wei_def_t *def, ec_scratch_t *s)
+{
+ size_t i;
+ int result = 1;
+ bigint_t *c;
+ if (!n) return 1;
+ c = (bigint_t *) malloc(n * sizeof(bigint_t));
+ /* c[i] = z[0]*...*z[i], points at infinity are skipped */
+ for (i = 0; i < n; i++)
+ {
+  c[i] = bigint_create(bigint_get_word_count(def->p));
+  if (i) bigint_copy(c[i], c[i-1]); else bigint_set_word(c[i], 1);
+  if (bigint_eq_word(pts[i].z, 0))
+  {
+   bigint_set_word(pts[i].x, 0);
+   bigint_set_word(pts[i].y, 1);
+   result = 0;
+  } else bigint_mmul(c[i], c[i], pts[i].z, def->p);
+ }
+ if (!bigint_minv(s->v[3], c[n-1], def->p))
+ {
+  for (i = 0; i < n; i++) bigint_destroy(c[i]);
+  free(c);
+  return 0;
+ }
+ for (i = n; i-- > 0;)
+ {
+  if (bigint_eq_word(pts[i].z, 0)) continue;
+  /* v0 = 1/z[i], v3 = 1/c[i-1] */
+  if (i)
+  {
+   bigint_mmul(s->v[0], s->v[3], c[i-1], def->p);
+   bigint_mmul(s->v[3], s->v[3], pts[i].z, def->p);
+  } else bigint_copy(s->v[0], s->v[3]);
+  bigint_mmul(pts[i].x, pts[i].x, s->v[0], def->p);
+  bigint_mmul(pts[i].y, pts[i].y, s->v[0], def->p);
+  bigint_set_word(pts[i].z, 1);
+ }
+ for (i = 0; i < n; i++) bigint_destroy(c[i]);
+ free(c);
+ return result;
+}
+
 int ec_weip_point_affine_xy(bigint_t x, bigint_t y, const ec_point_t *a, const ec_wei_def_t *def, ec_scratch_t *s)
 {
  if (bigint_eq_word(a->z, 0)) return 0;
@@ -186,8 +232,128 @@ int ec_weip_point_affine_x(bigint_t x, const ec_point_t *a, const ec_wei_def_t *
  return 1;
 }
 
+/* t[i] = (2i+1)*a in affine coordinates, returns 0 if a is the identity */
+static int odd_multiples(ec_point_t *t, int count, const ec_point_t *a, const ec_wei_def_t *def, ec_scratch_t *s)
+{
+ int i, result;
+ ec_point_t a2;
+ if (!ec_weip_point_affine_xy(t[0].x, t[0].y, a, def, s)) return 0;
+ bigint_set_word(t[0].z, 1);
+ if (count == 1) return 1;
+ ec_wei_point_init(&a2, def);
+ ec_weip_point_dbl(&a2, t, def, s);
+ result = ec_weip_point_normalize(&a2, def, s);
+ if (result)
+ {
+  for (i = 1; i < count; i++)
+   ec_weip_point_madd(t + i, t + i-1, a2.x, a2.y, def, s);
+  result = ec_weip_points_normalize(t + 1, count - 1, def, s);
+ }
+ ec_wei_point_destroy(&a2);
+ return result;
+}
+
+/* res += d*a, t holds odd multiples of a */
+static void add_digit(ec_point_t *res, const ec_point_t *t, int d, const ec_wei_def_t *def, ec_scratch_t *s)
+{
+ if (d > 0)
+ {
+  t += d >> 1;
+  ec_weip_point_madd(res, res, t->x, t->y, def, s);
+ } else
+ if (d < 0)
+ {
+  t += -d >> 1;
+  bigint_sub(s->v[8], def->p, t->y);
+  ec_weip_point_madd(res, res, t->x, s->v[8], def, s);
+ }
+}
+
+/* width-w NAF with a table of odd multiples a, 3a, ..., (2^(window-1)-1)a */
+void ec_weip_point_mul_wnaf(ec_point_t *res, const ec_point_t *a, const ec_wei_def_t *def,
+                           const bigint_t k, int window, ec_scratch_t *s)
+{
+ int i, len, count = 1 << (window-2);
+ ec_point_t *t;
+ signed char *digits;
+ bigint_set_word(res->x, 0);
+ bigint_set_word(res->y, 1);
+ bigint_set_word(res->z, 0);
+ t = (ec_point_t *) alloca(count * sizeof(ec_point_t));
+ for (i = 0; i < count; i++) ec_wei_point_init(t + i, def);
+ if (odd_multiples(t, count, a, def, s))
+ {
+  digits = (signed char *) alloca(bigint_get_bit_count(k) + 1);
+  len = ec_wei_recode_wnaf(digits, k, window);
+  for (i = len-1; i >= 0; i--)
+  {
+   if (def->am3_flag)
+    ec_weip_point_dbl3(res, res, def, s);
+   else
+    ec_weip_point_dbl(res, res, def, s);
+   add_digit(res, t, digits[i], def, s);
+  }
+  if (bigint_get_sign(k)) ec_wei_point_neg(res);
+ }
+ for (i = 0; i < count; i++) ec_wei_point_destroy(t + i);
+}
+
+/* k*a = k1*a + k2*phi(a) with interleaved wNAF of the half-size scalars */
+void ec_weip_point_mul_glv(ec_point_t *res, const ec_point_t *a, const ec_glv_def_t *glv,
+                          const ec_wei_def_t *def, const bigint_t k, ec_scratch_t *s)
+{
+ int i, len1, len2, window = ec_wei_wnaf_window(def), count = 1 << (window-2);
+ ec_point_t *t1, *t2;
+ signed char *digits1, *digits2;
+ bigint_t k1 = bigint_create(0);
+ bigint_t k2 = bigint_create(0);
+ bigint_set_word(res->x, 0);
+ bigint_set_word(res->y, 1);
+ bigint_set_word(res->z, 0);
+ t1 = (ec_point_t *) alloca(2 * count * sizeof(ec_point_t));
+ t2 = t1 + count;
+ for (i = 0; i < 2*count; i++) ec_wei_point_init(t1 + i, def);
+ if (!odd_multiples(t1, count, a, def, s)) goto fin;
+
+ bigint_copy(s->v[9], k);
+ bigint_set_sign(s->v[9], 0);
+ bigint_mod(s->v[9], s->v[9], glv->n);
+ ec_wei_glv_split(k1, k2, s->v[9], glv, s);
+ for (i = 0; i < count; i++)
+ {
+  /* phi(t1[i]), signs of k1 and k2 go into the tables */
+  bigint_mmul(t2[i].x, t1[i].x, glv->beta, def->p);
+  bigint_copy(t2[i].y, t1[i].y);
+  bigint_set_word(t2[i].z, 1);
+  if (bigint_get_sign(k1)) bigint_sub(t1[i].y, def->p, t1[i].y);
+  if (bigint_get_sign(k2)) bigint_sub(t2[i].y, def->p, t2[i].y);
+ }
+ digits1 = (signed char *) alloca(bigint_get_bit_count(k1) + 1);
+ digits2 = (signed char *) alloca(bigint_get_bit_count(k2) + 1);
+ len1 = ec_wei_recode_wnaf(digits1, k1, window);
+ len2 = ec_wei_recode_wnaf(digits2, k2, window);
+ for (i = (len1 > len2? len1 : len2) - 1; i >= 0; i--)
+ {
+  if (def->am3_flag)
+   ec_weip_point_dbl3(res, res, def, s);
+  else
+   ec_weip_point_dbl(res, res, def, s);
+  if (i < len1) add_digit(res, t1, digits1[i], def, s);
+  if (i < len2) add_digit(res, t2, digits2[i], def, s);
+ }
+ if (bigint_get_sign(k)) ec_wei_point_neg(res);
+
+ fin:
+ for (i = 0; i < 2*count; i++) ec_wei_point_destroy(t1 + i);
+ bigint_destroy(k2);
+ bigint_destroy(k1);
+}
+
 void ec_weip_point_mul(ec_point_t *res, const ec_point_t *a, const ec_wei_def_t *def, const bigint_t k, ec_scratch_t *s)
 {
+ #if 1
+ ec_weip_point_mul_wnaf(res, a, def, k, ec_wei_wnaf_window(def), s);
+ #else
  int i, n = bigint_get_bit_count(k);
  bigint_set_word(res->x, 0);
  bigint_set_word(res->y, 1);
@@ -218,4 +384,124 @@ void ec_weip_point_mul(ec_point_t *res, const ec_point_t *a, const ec_wei_def_t
  }
  #endif
  if (bigint_get_sign(k)) ec_wei_point_neg(res);
+ #endif
+}
+
+/* Montgomery ladder: one addition and one doubling per bit of n,
+   the points are swapped by masking their handles */
+void ec_weip_point_mul_ladder(ec_point_t *res, const ec_point_t *a, const bigint_t n,
+                              const ec_wei_def_t *def, const bigint_t k, ec_scratch_t *s)
+{
+ int i, bit;
+ ec_point_t r1;
+ if (bigint_eq_word(a->z, 0))
+ {
+  bigint_set_word(res->x, 0);
+  bigint_set_word(res->y, 1);
+  bigint_set_word(res->z, 0);
+  return;
+ }
+ i = ec_wei_ladder_scalar(s->v[9], k, n, s);
+ ec_wei_point_init(&r1, def);
+ ec_wei_point_copy(res, a);
+ ec_weip_point_dbl(&r1, res, def, s);
+ /* res = m*a, r1 = (m+1)*a for the top bits m of the scalar */
+ while (i-- > 0)
+ {
+  bit = bigint_get_bit(s->v[9], i);
+  ec_wei_point_cswap(res, &r1, bit);
+  ec_weip_point_add(&r1, res, &r1, def, s);
+  if (def->am3_flag)
+   ec_weip_point_dbl3(res, res, def, s);
+  else
+   ec_weip_point_dbl(res, res, def, s);
+  ec_wei_point_cswap(res, &r1, bit);
+ }
+ ec_wei_point_destroy(&r1);
+}
+
+/* Shamir's trick: res = ka*a + kb*b with a single chain of doublings */
+void ec_weip_point_mul2(ec_point_t *res, const ec_point_t *a, const bigint_t ka,
+                       const ec_point_t *b, const bigint_t kb,
+                       const ec_wei_def_t *def, ec_scratch_t *s)
+{
+ int i, n, bit_a, bit_b, ab_valid;
+ ec_point_t bb, ab;
+ if (!ec_weip_point_affine_xy(s->v[8], s->v[9], a, def, s))
+ {
+  ec_weip_point_mul(res, b, def, kb, s);
+  return;
+ }
+ ec_wei_point_init(&bb, def);
+ if (!ec_weip_point_affine_xy(bb.x, bb.y, b, def, s))
+ {
+  ec_wei_point_destroy(&bb);
+  ec_weip_point_mul(res, a, def, ka, s);
+  return;
+ }
+ if (bigint_get_sign(ka)) bigint_sub(s->v[9], def->p, s->v[9]);
+ if (bigint_get_sign(kb)) bigint_sub(bb.y, def->p, bb.y);
+ ec_wei_point_init(&ab, def);
+ bigint_copy(ab.x, s->v[8]);
+ bigint_copy(ab.y, s->v[9]);
+ bigint_set_word(ab.z, 1);
+ ec_weip_point_madd(&ab, &ab, bb.x, bb.y, def, s);
+ ab_valid = ec_weip_point_normalize(&ab, def, s); /* 0 if b = -a */
+
+ n = bigint_get_bit_count(ka);
+ i = bigint_get_bit_count(kb);
+ if (i > n) n = i;
+ bigint_set_word(res->x, 0);
+ bigint_set_word(res->y, 1);
+ bigint_set_word(res->z, 0);
+ for (i = n-1; i >= 0; i--)
+ {
+  if (def->am3_flag)
+   ec_weip_point_dbl3(res, res, def, s);
+  else
+   ec_weip_point_dbl(res, res, def, s);
+  bit_a = bigint_get_bit(ka, i);
+  bit_b = bigint_get_bit(kb, i);
+  if (bit_a && bit_b && ab_valid)
+   ec_weip_point_madd(res, res, ab.x, ab.y, def, s);
+  else
+  {
+   if (bit_a) ec_weip_point_madd(res, res, s->v[8], s->v[9], def, s);
+   if (bit_b) ec_weip_point_madd(res, res, bb.x, bb.y, def, s);
+  }
+ }
+ ec_wei_point_destroy(&ab);
+ ec_wei_point_destroy(&bb);
+}
+
+void ec_weip_point_mul_fixed(ec_point_t *res, const ec_fixed_table_t *t,
+                            const ec_wei_def_t *def, const bigint_t k, ec_scratch_t *s)
+{
+ int i, d;
+ const ec_point_t *pt;
+ int *digits = (int *) alloca(t->count * sizeof(int));
+ if (!ec_wei_recode_signed(digits, k, t->window, t->count))
+ {
+  ec_weip_point_mul(res, t->points, def, k, s);
+  return;
+ }
+ bigint_set_word(res->x, 0);
+ bigint_set_word(res->y, 1);
+ bigint_set_word(res->z, 0);
+ for (i = 0; i < t->count; i++)
+ {
+  d = digits[i];
+  if (d > 0)
+  {
+   pt = t->points + (i << (t->window-1)) + d - 1;
+   ec_weip_point_madd(res, res, pt->x, pt->y, def, s);
+  } else
+  if (d < 0)
+  {
+   pt = t->points + (i << (t->window-1)) - d - 1;
+   bigint_sub(s->v[8], def->p, pt->y);
+   ec_weip_point_madd(res, res, pt->x, s->v[8], def, s);
+  }
+ }
+ if (bigint_get_sign(k)) ec_wei_point_neg(res);
 }
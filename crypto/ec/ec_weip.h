@@ -28,9 +28,27 @@ int ec_weip_point_affine_xy(bigint_t x, bigint_t y, const ec_point_t *a,
 int ec_weip_point_affine_x(bigint_t x, const ec_point_t *a,
                            const ec_wei_def_t *def, ec_scratch_t *s);
 int ec_weip_point_normalize(ec_point_t *a, const ec_wei_def_t *def, ec_scratch_t *s);
+/* normalizes n points with a single inversion, returns 0 if any of them is the identity */
+int ec_weip_points_normalize(ec_point_t *pts, size_t n, const ec_wei_def_t *def, ec_scratch_t *s);
 
 void ec_weip_point_mul(ec_point_t *res, const ec_point_t *a,
                        const ec_wei_def_t *def, const bigint_t k, ec_scratch_t *s);
+void ec_weip_point_mul_wnaf(ec_point_t *res, const ec_point_t *a, const ec_wei_def_t *def,
+                           const bigint_t k, int window, ec_scratch_t *s);
+/* curves with an efficient endomorphism */
+void ec_weip_point_mul_glv(ec_point_t *res, const ec_point_t *a, const ec_glv_def_t *glv,
+                          const ec_wei_def_t *def, const bigint_t k, ec_scratch_t *s);
+/* constant sequence of operations for secret scalars, n is the group order, 0 <= k < n */
+void ec_weip_point_mul_ladder(ec_point_t *res, const ec_point_t *a, const bigint_t n,
+                              const ec_wei_def_t *def, const bigint_t k, ec_scratch_t *s);
+/* res = ka*a + kb*b */
+void ec_weip_point_mul2(ec_point_t *res, const ec_point_t *a, const bigint_t ka,
+                       const ec_point_t *b, const bigint_t kb,
+                       const ec_wei_def_t *def, ec_scratch_t *s);
+
+/* fixed point multiplication without doublings, see ec_weij_fixed_table_init */
+void ec_weip_point_mul_fixed(ec_point_t *res, const ec_fixed_table_t *t,
+                            const ec_wei_def_t *def, const bigint_t k, ec_scratch_t *s);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,304 @@
+#include "fe25519.h"
+#include <platform/umul.h>
+#include <string.h>
+
+/* 2^256 = 38 (mod p) */
+
+/* r += w, w < 2^63 */
+static void fe25519_fold(fe25519_t r, uint64_t w)
+{
+ uint64_t carry = w;
+ int i;
+ for (i = 0; i < 4; i++)
+ {
+  r[i] += carry;
+  carry = r[i] < carry;
+ }
+ /* the sum wrapped around, r < w now */
+ r[0] += 38 & (0 - carry);
+}
+
+void fe25519_load(fe25519_t r, const uint8_t *in)
+{
+ int i, j;
+ for (i = 0; i < 4; i++)
+ {
+  r[i] = 0;
+  for (j = 7; j >= 0; j--)
+   r[i] = r[i] << 8 | in[8*i + j];
+ }
+ r[3] &= 0x7FFFFFFFFFFFFFFF;
+}
+
+void fe25519_store(uint8_t *out, const fe25519_t a)
+{
+ fe25519_t t, d;
+ uint64_t carry, mask;
+ int i, j;
+ fe25519_copy(t, a);
+ /* fold bit 255 twice to get t < 2^255 */
+ for (j = 0; j < 2; j++)
+ {
+  carry = t[3] >> 63;
+  t[3] &= 0x7FFFFFFFFFFFFFFF;
+  carry *= 19;
+  for (i = 0; i < 4; i++)
+  {
+   t[i] += carry;
+   carry = t[i] < carry;
+  }
+ }
+ /* t >= p if t + 19 >= 2^255 */
+ carry = 19;
+ for (i = 0; i < 4; i++)
+ {
+  d[i] = t[i] + carry;
+  carry = d[i] < carry;
+ }
+ mask = 0 - (d[3] >> 63);
+ d[3] &= 0x7FFFFFFFFFFFFFFF;
+ for (i = 0; i < 4; i++)
+ {
+  t[i] = (d[i] & mask) | (t[i] & ~mask);
+  for (j = 0; j < 8; j++)
+   out[8*i + j] = (uint8_t) (t[i] >> 8*j);
+ }
+}
+
+void fe25519_set_word(fe25519_t r, uint64_t w)
+{
+ r[0] = w;
+ r[1] = r[2] = r[3] = 0;
+}
+
+void fe25519_copy(fe25519_t r, const fe25519_t a)
+{
+ memcpy(r, a, sizeof(fe25519_t));
+}
+
+void fe25519_add(fe25519_t r, const fe25519_t a, const fe25519_t b)
+{
+ uint64_t carry = 0, x;
+ int i;
+ for (i = 0; i < 4; i++)
+ {
+  x = a[i] + carry;
+  carry = x < carry;
+  r[i] = x + b[i];
+  carry += r[i] < x;
+ }
+ fe25519_fold(r, 38 & (0 - carry));
+}
+
+void fe25519_sub(fe25519_t r, const fe25519_t a, const fe25519_t b)
+{
+ uint64_t borrow = 0, x, y;
+ int i;
+ for (i = 0; i < 4; i++)
+ {
+  x = a[i];
+  y = b[i] + borrow;
+  borrow = (y < borrow) | (x < y);
+  r[i] = x - y;
+ }
+ /* r = a - b + 2^256, subtract 38 once or twice */
+ y = 38 & (0 - borrow);
+ for (i = 0; i < 4; i++)
+ {
+  x = r[i];
+  r[i] = x - y;
+  y = x < y;
+ }
+ r[0] -= 38 & (0 - y);
+}
+
+void fe25519_neg(fe25519_t r, const fe25519_t a)
+{
+ static const fe25519_t zero = { 0, 0, 0, 0 };
+ fe25519_sub(r, zero, a);
+}
+
+/* r = t mod 2^256 + 38*(t >> 256) */
+static void fe25519_reduce(fe25519_t r, const uint64_t t[8])
+{
+ uint64_t carry = 0, lo, hi;
+ int i;
+ for (i = 0; i < 4; i++)
+ {
+  lo = umul64(&hi, t[i+4], 38);
+  lo += carry;
+  hi += lo < carry;
+  r[i] = lo + t[i];
+  carry = hi + (r[i] < lo);
+ }
+ fe25519_fold(r, carry * 38);
+}
+
+void fe25519_mul(fe25519_t r, const fe25519_t a, const fe25519_t b)
+{
+ uint64_t t[8], carry, lo, hi;
+ int i, j;
+ memset(t, 0, sizeof(t));
+ for (i = 0; i < 4; i++)
+ {
+  carry = 0;
+  for (j = 0; j < 4; j++)
+  {
+   lo = umul64(&hi, a[j], b[i]);
+   lo += carry;
+   hi += lo < carry;
+   lo += t[i+j];
+   hi += lo < t[i+j];
+   t[i+j] = lo;
+   carry = hi;
+  }
+  t[i+4] = carry;
+ }
+ fe25519_reduce(r, t);
+}
+
+void fe25519_sqr(fe25519_t r, const fe25519_t a)
+{
+ uint64_t t[8], carry, lo, hi;
+ int i, j;
+ memset(t, 0, sizeof(t));
+ /* cross products once, then doubled */
+ for (i = 0; i < 3; i++)
+ {
+  carry = 0;
+  for (j = i+1; j < 4; j++)
+  {
+   lo = umul64(&hi, a[i], a[j]);
+   lo += carry;
+   hi += lo < carry;
+   lo += t[i+j];
+   hi += lo < t[i+j];
+   t[i+j] = lo;
+   carry = hi;
+  }
+  t[i+4] = carry;
+ }
+ carry = 0;
+ for (i = 1; i < 8; i++)
+ {
+  hi = t[i] >> 63;
+  t[i] = t[i] << 1 | carry;
+  carry = hi;
+ }
+ carry = 0;
+ for (i = 0; i < 4; i++)
+ {
+  lo = umul64(&hi, a[i], a[i]);
+  lo += carry;
+  hi += lo < carry;
+  t[2*i] += lo;
+  hi += t[2*i] < lo;
+  t[2*i+1] += hi;
+  carry = t[2*i+1] < hi;
+ }
+ fe25519_reduce(r, t);
+}
+
+void fe25519_mul_word(fe25519_t r, const fe25519_t a, uint32_t w)
+{
+ uint64_t carry = 0, lo, hi;
+ int i;
+ for (i = 0; i < 4; i++)
+ {
+  lo = umul64(&hi, a[i], w);
+  r[i] = lo + carry;
+  carry = hi + (r[i] < lo);
+ }
+ fe25519_fold(r, carry * 38);
+}
+
+static void fe25519_sqr_n(fe25519_t r, const fe25519_t a, int n)
+{
+ fe25519_sqr(r, a);
+ while (--n) fe25519_sqr(r, r);
+}
+
+/* t = a^(2^250 - 1), x11 = a^11 */
+static void fe25519_pow250(fe25519_t t, fe25519_t x11, const fe25519_t a)
+{
+ fe25519_t x2, x9, x5, x10, x20, x50, x100;
+ fe25519_sqr(x2, a);
+ fe25519_sqr_n(t, x2, 2);
+ fe25519_mul(x9, t, a);
+ fe25519_mul(x11, x9, x2);
+ fe25519_sqr(t, x11);
+ fe25519_mul(x5, t, x9);          /* 2^5 - 1 */
+ fe25519_sqr_n(t, x5, 5);
+ fe25519_mul(x10, t, x5);         /* 2^10 - 1 */
+ fe25519_sqr_n(t, x10, 10);
+ fe25519_mul(x20, t, x10);        /* 2^20 - 1 */
+ fe25519_sqr_n(t, x20, 20);
+ fe25519_mul(t, t, x20);          /* 2^40 - 1 */
+ fe25519_sqr_n(t, t, 10);
+ fe25519_mul(x50, t, x10);        /* 2^50 - 1 */
+ fe25519_sqr_n(t, x50, 50);
+ fe25519_mul(x100, t, x50);       /* 2^100 - 1 */
+ fe25519_sqr_n(t, x100, 100);
+ fe25519_mul(t, t, x100);         /* 2^200 - 1 */
+ fe25519_sqr_n(t, t, 50);
+ fe25519_mul(t, t, x50);          /* 2^250 - 1 */
+}
+
+void fe25519_inv(fe25519_t r, const fe25519_t a)
+{
+ fe25519_t t, x11;
+ fe25519_pow250(t, x11, a);
+ fe25519_sqr_n(t, t, 5);
+ fe25519_mul(r, t, x11);          /* 2^255 - 21 */
+}
+
+void fe25519_pow22523(fe25519_t r, const fe25519_t a)
+{
+ fe25519_t t, x11;
+ fe25519_pow250(t, x11, a);
+ fe25519_sqr_n(t, t, 2);
+ fe25519_mul(r, t, a);            /* 2^252 - 3 */
+}
+
+void fe25519_cswap(fe25519_t a, fe25519_t b, uint64_t flag)
+{
+ uint64_t mask = 0 - flag, x;
+ int i;
+ for (i = 0; i < 4; i++)
+ {
+  x = (a[i] ^ b[i]) & mask;
+  a[i] ^= x;
+  b[i] ^= x;
+ }
+}
+
+void fe25519_cmov(fe25519_t r, const fe25519_t a, uint64_t flag)
+{
+ uint64_t mask = 0 - flag;
+ int i;
+ for (i = 0; i < 4; i++)
+  r[i] ^= (r[i] ^ a[i]) & mask;
+}
+
+int fe25519_is_zero(const fe25519_t a)
+{
+ uint8_t buf[32], acc = 0;
+ int i;
+ fe25519_store(buf, a);
+ for (i = 0; i < 32; i++) acc |= buf[i];
+ return acc == 0;
+}
+
+int fe25519_equal(const fe25519_t a, const fe25519_t b)
+{
+ fe25519_t t;
+ fe25519_sub(t, a, b);
+ return fe25519_is_zero(t);
+}
+
+int fe25519_is_odd(const fe25519_t a)
+{
+ uint8_t buf[32];
+ fe25519_store(buf, a);
+ return buf[0] & 1;
+}
@@ -0,0 +1,49 @@
+#ifndef __fe25519_h__
+#define __fe25519_h__
+
+#include <stdint.h>
+
+/*
+  Arithmetic modulo p = 2^255 - 19 with 4x64-bit limbs.
+  Elements are only kept below 2^256, fe25519_store returns
+  the canonical encoding. Everything runs in constant time.
+ */
+
+typedef uint64_t fe25519_t[4];
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* 32 bytes little-endian, the top bit is ignored */
+void fe25519_load(fe25519_t r, const uint8_t *in);
+void fe25519_store(uint8_t *out, const fe25519_t a);
+void fe25519_set_word(fe25519_t r, uint64_t w);
+void fe25519_copy(fe25519_t r, const fe25519_t a);
+
+void fe25519_add(fe25519_t r, const fe25519_t a, const fe25519_t b);
+void fe25519_sub(fe25519_t r, const fe25519_t a, const fe25519_t b);
+void fe25519_neg(fe25519_t r, const fe25519_t a);
+void fe25519_mul(fe25519_t r, const fe25519_t a, const fe25519_t b);
+void fe25519_sqr(fe25519_t r, const fe25519_t a);
+void fe25519_mul_word(fe25519_t r, const fe25519_t a, uint32_t w);
+/* r = a^(p-2), 0 for a = 0 */
+void fe25519_inv(fe25519_t r, const fe25519_t a);
+/* r = a^((p-5)/8), used for square roots */
+void fe25519_pow22523(fe25519_t r, const fe25519_t a);
+
+/* swaps a and b if flag = 1, flag must be 0 or 1 */
+void fe25519_cswap(fe25519_t a, fe25519_t b, uint64_t flag);
+/* r = a if flag = 1 */
+void fe25519_cmov(fe25519_t r, const fe25519_t a, uint64_t flag);
+int  fe25519_is_zero(const fe25519_t a);
+int  fe25519_equal(const fe25519_t a, const fe25519_t b);
+/* the low bit of the canonical value */
+int  fe25519_is_odd(const fe25519_t a);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -14,6 +14,8 @@ namespace oid
   ID_DSA,
   ID_ECDSA,
   ID_RSASSA_PSS,
+  ID_X25519,
+  ID_ED25519,
   ID_HASH_MD2,
   ID_HASH_MD5,
   ID_HASH_SHA1,
@@ -8,86 +8,88 @@ static const uint8_t d1[]  = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0
 static const uint8_t d2[]  = { 0x2A, 0x86, 0x48, 0xCE, 0x38, 0x04, 0x01 }; // ID_DSA
 static const uint8_t d3[]  = { 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x02, 0x01 }; // ID_ECDSA
 static const uint8_t d4[]  = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x0A }; // ID_RSASSA_PSS
-static const uint8_t d5[]  = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x02, 0x02 }; // ID_HASH_MD2
-static const uint8_t d6[]  = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x02, 0x05 }; // ID_HASH_MD5
-static const uint8_t d7[]  = { 0x2B, 0x0E, 0x03, 0x02, 0x1A }; // ID_HASH_SHA1
-static const uint8_t d8[]  = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x01 }; // ID_HASH_SHA256
-static const uint8_t d9[]  = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x02 }; // ID_HASH_SHA384
-static const uint8_t d10[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x03 }; // ID_HASH_SHA512
-static const uint8_t d11[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x04 }; // ID_HASH_SHA224
-static const uint8_t d12[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x05 }; // ID_HASH_SHA512_224
-static const uint8_t d13[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x06 }; // ID_HASH_SHA512_256
-static const uint8_t d14[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x07 }; // ID_HASH_SHA3_224
-static const uint8_t d15[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x08 }; // ID_HASH_SHA3_256
-static const uint8_t d16[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x09 }; // ID_HASH_SHA3_384
-static const uint8_t d17[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x0A }; // ID_HASH_SHA3_512
-static const uint8_t d18[] = { 0x2A, 0x85, 0x03, 0x07, 0x01, 0x01, 0x02, 0x02 }; // ID_HASH_STREEBOG256
-static const uint8_t d19[] = { 0x2A, 0x85, 0x03, 0x07, 0x01, 0x01, 0x02, 0x03 }; // ID_HASH_STREEBOG512
-static const uint8_t d20[] = { 0x2B, 0x06, 0x01, 0x03, 0x00, 0x10, 0x81, 0x00 }; // ID_HASH_SKEIN256_128
-static const uint8_t d21[] = { 0x2B, 0x06, 0x01, 0x03, 0x00, 0x10, 0x81, 0x20 }; // ID_HASH_SKEIN256_160
-static const uint8_t d22[] = { 0x2B, 0x06, 0x01, 0x03, 0x00, 0x10, 0x81, 0x60 }; // ID_HASH_SKEIN256_224
-static const uint8_t d23[] = { 0x2B, 0x06, 0x01, 0x03, 0x00, 0x10, 0x82, 0x00 }; // ID_HASH_SKEIN256_256
-static const uint8_t d24[] = { 0x2B, 0x06, 0x01, 0x03, 0x00, 0x11, 0x81, 0x60 }; // ID_HASH_SKEIN512_224
-static const uint8_t d25[] = { 0x2B, 0x06, 0x01, 0x03, 0x00, 0x11, 0x82, 0x00 }; // ID_HASH_SKEIN512_256
-static const uint8_t d26[] = { 0x2B, 0x06, 0x01, 0x03, 0x00, 0x11, 0x83, 0x00 }; // ID_HASH_SKEIN512_384
-static const uint8_t d27[] = { 0x2B, 0x06, 0x01, 0x03, 0x00, 0x11, 0x84, 0x00 }; // ID_HASH_SKEIN512_512
-static const uint8_t d28[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x02 }; // ID_SIGN_RSA_MD2
-static const uint8_t d29[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x04 }; // ID_SIGN_RSA_MD5
-static const uint8_t d30[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x05 }; // ID_SIGN_RSA_SHA1
-static const uint8_t d31[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x0E }; // ID_SIGN_RSA_SHA224
-static const uint8_t d32[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x0B }; // ID_SIGN_RSA_SHA256
-static const uint8_t d33[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x0C }; // ID_SIGN_RSA_SHA384
-static const uint8_t d34[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x0D }; // ID_SIGN_RSA_SHA512
-static const uint8_t d35[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x0F }; // ID_SIGN_RSA_SHA512_224
-static const uint8_t d36[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x10 }; // ID_SIGN_RSA_SHA512_256
-static const uint8_t d37[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x0D }; // ID_SIGN_RSA_SHA3_224
-static const uint8_t d38[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x0E }; // ID_SIGN_RSA_SHA3_256
-static const uint8_t d39[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x0F }; // ID_SIGN_RSA_SHA3_384
-static const uint8_t d40[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x10 }; // ID_SIGN_RSA_SHA3_512
-static const uint8_t d41[] = { 0x2A, 0x86, 0x48, 0xCE, 0x38, 0x04, 0x03 }; // ID_SIGN_DSA_SHA1
-static const uint8_t d42[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x01 }; // ID_SIGN_DSA_SHA224
-static const uint8_t d43[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x02 }; // ID_SIGN_DSA_SHA256
-static const uint8_t d44[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x03 }; // ID_SIGN_DSA_SHA384
-static const uint8_t d45[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x04 }; // ID_SIGN_DSA_SHA512
-static const uint8_t d46[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x05 }; // ID_SIGN_DSA_SHA3_224
-static const uint8_t d47[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x06 }; // ID_SIGN_DSA_SHA3_256
-static const uint8_t d48[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x07 }; // ID_SIGN_DSA_SHA3_384
-static const uint8_t d49[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x08 }; // ID_SIGN_DSA_SHA3_512
-static const uint8_t d50[] = { 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04, 0x01 }; // ID_SIGN_ECDSA_SHA1
-static const uint8_t d51[] = { 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04, 0x03, 0x01 }; // ID_SIGN_ECDSA_SHA224
-static const uint8_t d52[] = { 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04, 0x03, 0x02 }; // ID_SIGN_ECDSA_SHA256
-static const uint8_t d53[] = { 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04, 0x03, 0x03 }; // ID_SIGN_ECDSA_SHA384
-static const uint8_t d54[] = { 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04, 0x03, 0x04 }; // ID_SIGN_ECDSA_SHA512
-static const uint8_t d55[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x09 }; // ID_SIGN_ECDSA_SHA3_224
-static const uint8_t d56[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x0A }; // ID_SIGN_ECDSA_SHA3_256
-static const uint8_t d57[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x0B }; // ID_SIGN_ECDSA_SHA3_384
-static const uint8_t d58[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x0C }; // ID_SIGN_ECDSA_SHA3_512
-static const uint8_t d59[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x08 }; // ID_MGF1
-static const uint8_t d60[] = { 0x55, 0x04, 0x03 }; // ID_AT_COMMON_NAME
-static const uint8_t d61[] = { 0x55, 0x04, 0x29 }; // ID_AT_NAME
-static const uint8_t d62[] = { 0x55, 0x04, 0x04 }; // ID_AT_SURNAME
-static const uint8_t d63[] = { 0x55, 0x04, 0x2A }; // ID_AT_GIVEN_NAME
-static const uint8_t d64[] = { 0x55, 0x04, 0x2B }; // ID_AT_INITIALS
-static const uint8_t d65[] = { 0x55, 0x04, 0x2C }; // ID_AT_GENERATION_QUALIFIER
-static const uint8_t d66[] = { 0x55, 0x04, 0x07 }; // ID_AT_LOCALITY_NAME
-static const uint8_t d67[] = { 0x55, 0x04, 0x08 }; // ID_AT_STATE_OR_PROVINCE_NAME
-static const uint8_t d68[] = { 0x55, 0x04, 0x0A }; // ID_AT_ORGANIZATION_NAME
-static const uint8_t d69[] = { 0x55, 0x04, 0x0B }; // ID_AT_ORGANIZATIONAL_UNIT_NAME
-static const uint8_t d70[] = { 0x55, 0x04, 0x0C }; // ID_AT_TITLE
-static const uint8_t d71[] = { 0x55, 0x04, 0x2E }; // ID_AT_DN_QUALIFIER
-static const uint8_t d72[] = { 0x55, 0x04, 0x06 }; // ID_AT_COUNTRY_NAME
-static const uint8_t d73[] = { 0x55, 0x04, 0x05 }; // ID_AT_SERIAL_NUMBER
-static const uint8_t d74[] = { 0x55, 0x04, 0x41 }; // ID_AT_PSEUDONYM
-static const uint8_t d75[] = { 0x09, 0x92, 0x26, 0x89, 0x93, 0xF2, 0x2C, 0x64, 0x01, 0x19 }; // ID_AT_DOMAIN_COMPONENT
-static const uint8_t d76[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x09, 0x01 }; // ID_AT_EMAIL_ADDRESS
-static const uint8_t d77[] = { 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x03, 0x01, 0x01 }; // ID_SECP192R1
-static const uint8_t d78[] = { 0x2B, 0x81, 0x04, 0x00, 0x1F }; // ID_SECP192K1
-static const uint8_t d79[] = { 0x2B, 0x81, 0x04, 0x00, 0x21 }; // ID_SECP224R1
-static const uint8_t d80[] = { 0x2B, 0x81, 0x04, 0x00, 0x20 }; // ID_SECP224K1
-static const uint8_t d81[] = { 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x03, 0x01, 0x07 }; // ID_SECP256R1
-static const uint8_t d82[] = { 0x2B, 0x81, 0x04, 0x00, 0x0A }; // ID_SECP256K1
-static const uint8_t d83[] = { 0x2B, 0x81, 0x04, 0x00, 0x22 }; // ID_SECP384R1
-static const uint8_t d84[] = { 0x2B, 0x81, 0x04, 0x00, 0x23 }; // ID_SECP521R1
+static const uint8_t d5[]  = { 0x2B, 0x65, 0x6E }; // ID_X25519
+static const uint8_t d6[]  = { 0x2B, 0x65, 0x70 }; // ID_ED25519
+static const uint8_t d7[]  = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x02, 0x02 }; // ID_HASH_MD2
+static const uint8_t d8[]  = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x02, 0x05 }; // ID_HASH_MD5
+static const uint8_t d9[]  = { 0x2B, 0x0E, 0x03, 0x02, 0x1A }; // ID_HASH_SHA1
+static const uint8_t d10[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x01 }; // ID_HASH_SHA256
+static const uint8_t d11[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x02 }; // ID_HASH_SHA384
+static const uint8_t d12[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x03 }; // ID_HASH_SHA512
+static const uint8_t d13[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x04 }; // ID_HASH_SHA224
+static const uint8_t d14[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x05 }; // ID_HASH_SHA512_224
+static const uint8_t d15[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x06 }; // ID_HASH_SHA512_256
+static const uint8_t d16[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x07 }; // ID_HASH_SHA3_224
+static const uint8_t d17[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x08 }; // ID_HASH_SHA3_256
+static const uint8_t d18[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x09 }; // ID_HASH_SHA3_384
+static const uint8_t d19[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x0A }; // ID_HASH_SHA3_512
+static const uint8_t d20[] = { 0x2A, 0x85, 0x03, 0x07, 0x01, 0x01, 0x02, 0x02 }; // ID_HASH_STREEBOG256
+static const uint8_t d21[] = { 0x2A, 0x85, 0x03, 0x07, 0x01, 0x01, 0x02, 0x03 }; // ID_HASH_STREEBOG512
+static const uint8_t d22[] = { 0x2B, 0x06, 0x01, 0x03, 0x00, 0x10, 0x81, 0x00 }; // ID_HASH_SKEIN256_128
+static const uint8_t d23[] = { 0x2B, 0x06, 0x01, 0x03, 0x00, 0x10, 0x81, 0x20 }; // ID_HASH_SKEIN256_160
+static const uint8_t d24[] = { 0x2B, 0x06, 0x01, 0x03, 0x00, 0x10, 0x81, 0x60 }; // ID_HASH_SKEIN256_224
+static const uint8_t d25[] = { 0x2B, 0x06, 0x01, 0x03, 0x00, 0x10, 0x82, 0x00 }; // ID_HASH_SKEIN256_256
+static const uint8_t d26[] = { 0x2B, 0x06, 0x01, 0x03, 0x00, 0x11, 0x81, 0x60 }; // ID_HASH_SKEIN512_224
+static const uint8_t d27[] = { 0x2B, 0x06, 0x01, 0x03, 0x00, 0x11, 0x82, 0x00 }; // ID_HASH_SKEIN512_256
+static const uint8_t d28[] = { 0x2B, 0x06, 0x01, 0x03, 0x00, 0x11, 0x83, 0x00 }; // ID_HASH_SKEIN512_384
+static const uint8_t d29[] = { 0x2B, 0x06, 0x01, 0x03, 0x00, 0x11, 0x84, 0x00 }; // ID_HASH_SKEIN512_512
+static const uint8_t d30[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x02 }; // ID_SIGN_RSA_MD2
+static const uint8_t d31[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x04 }; // ID_SIGN_RSA_MD5
+static const uint8_t d32[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x05 }; // ID_SIGN_RSA_SHA1
+static const uint8_t d33[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x0E }; // ID_SIGN_RSA_SHA224
+static const uint8_t d34[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x0B }; // ID_SIGN_RSA_SHA256
+static const uint8_t d35[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x0C }; // ID_SIGN_RSA_SHA384
+static const uint8_t d36[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x0D }; // ID_SIGN_RSA_SHA512
+static const uint8_t d37[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x0F }; // ID_SIGN_RSA_SHA512_224
+static const uint8_t d38[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x10 }; // ID_SIGN_RSA_SHA512_256
+static const uint8_t d39[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x0D }; // ID_SIGN_RSA_SHA3_224
+static const uint8_t d40[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x0E }; // ID_SIGN_RSA_SHA3_256
+static const uint8_t d41[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x0F }; // ID_SIGN_RSA_SHA3_384
+static const uint8_t d42[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x10 }; // ID_SIGN_RSA_SHA3_512
+static const uint8_t d43[] = { 0x2A, 0x86, 0x48, 0xCE, 0x38, 0x04, 0x03 }; // ID_SIGN_DSA_SHA1
+static const uint8_t d44[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x01 }; // ID_SIGN_DSA_SHA224
+static const uint8_t d45[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x02 }; // ID_SIGN_DSA_SHA256
+static const uint8_t d46[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x03 }; // ID_SIGN_DSA_SHA384
+static const uint8_t d47[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x04 }; // ID_SIGN_DSA_SHA512
+static const uint8_t d48[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x05 }; // ID_SIGN_DSA_SHA3_224
+static const uint8_t d49[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x06 }; // ID_SIGN_DSA_SHA3_256
+static const uint8_t d50[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x07 }; // ID_SIGN_DSA_SHA3_384
+static const uint8_t d51[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x08 }; // ID_SIGN_DSA_SHA3_512
+static const uint8_t d52[] = { 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04, 0x01 }; // ID_SIGN_ECDSA_SHA1
+static const uint8_t d53[] = { 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04, 0x03, 0x01 }; // ID_SIGN_ECDSA_SHA224
+static const uint8_t d54[] = { 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04, 0x03, 0x02 }; // ID_SIGN_ECDSA_SHA256
+static const uint8_t d55[] = { 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04, 0x03, 0x03 }; // ID_SIGN_ECDSA_SHA384
+static const uint8_t d56[] = { 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04, 0x03, 0x04 }; // ID_SIGN_ECDSA_SHA512
+static const uint8_t d57[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x09 }; // ID_SIGN_ECDSA_SHA3_224
+static const uint8_t d58[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x0A }; // ID_SIGN_ECDSA_SHA3_256
+static const uint8_t d59[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x0B }; // ID_SIGN_ECDSA_SHA3_384
+static const uint8_t d60[] = { 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x03, 0x0C }; // ID_SIGN_ECDSA_SHA3_512
+static const uint8_t d61[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x08 }; // ID_MGF1
+static const uint8_t d62[] = { 0x55, 0x04, 0x03 }; // ID_AT_COMMON_NAME
+static const uint8_t d63[] = { 0x55, 0x04, 0x29 }; // ID_AT_NAME
+static const uint8_t d64[] = { 0x55, 0x04, 0x04 }; // ID_AT_SURNAME
+static const uint8_t d65[] = { 0x55, 0x04, 0x2A }; // ID_AT_GIVEN_NAME
+static const uint8_t d66[] = { 0x55, 0x04, 0x2B }; // ID_AT_INITIALS
+static const uint8_t d67[] = { 0x55, 0x04, 0x2C }; // ID_AT_GENERATION_QUALIFIER
+static const uint8_t d68[] = { 0x55, 0x04, 0x07 }; // ID_AT_LOCALITY_NAME
+static const uint8_t d69[] = { 0x55, 0x04, 0x08 }; // ID_AT_STATE_OR_PROVINCE_NAME
+static const uint8_t d70[] = { 0x55, 0x04, 0x0A }; // ID_AT_ORGANIZATION_NAME
+static const uint8_t d71[] = { 0x55, 0x04, 0x0B }; // ID_AT_ORGANIZATIONAL_UNIT_NAME
+static const uint8_t d72[] = { 0x55, 0x04, 0x0C }; // ID_AT_TITLE
+static const uint8_t d73[] = { 0x55, 0x04, 0x2E }; // ID_AT_DN_QUALIFIER
+static const uint8_t d74[] = { 0x55, 0x04, 0x06 }; // ID_AT_COUNTRY_NAME
+static const uint8_t d75[] = { 0x55, 0x04, 0x05 }; // ID_AT_SERIAL_NUMBER
+static const uint8_t d76[] = { 0x55, 0x04, 0x41 }; // ID_AT_PSEUDONYM
+static const uint8_t d77[] = { 0x09, 0x92, 0x26, 0x89, 0x93, 0xF2, 0x2C, 0x64, 0x01, 0x19 }; // ID_AT_DOMAIN_COMPONENT
+static const uint8_t d78[] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x09, 0x01 }; // ID_AT_EMAIL_ADDRESS
+static const uint8_t d79[] = { 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x03, 0x01, 0x01 }; // ID_SECP192R1
+static const uint8_t d80[] = { 0x2B, 0x81, 0x04, 0x00, 0x1F }; // ID_SECP192K1
+static const uint8_t d81[] = { 0x2B, 0x81, 0x04, 0x00, 0x21 }; // ID_SECP224R1
+static const uint8_t d82[] = { 0x2B, 0x81, 0x04, 0x00, 0x20 }; // ID_SECP224K1
+static const uint8_t d83[] = { 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x03, 0x01, 0x07 }; // ID_SECP256R1
+static const uint8_t d84[] = { 0x2B, 0x81, 0x04, 0x00, 0x0A }; // ID_SECP256K1
+static const uint8_t d85[] = { 0x2B, 0x81, 0x04, 0x00, 0x22 }; // ID_SECP384R1
+static const uint8_t d86[] = { 0x2B, 0x81, 0x04, 0x00, 0x23 }; // ID_SECP521R1
 
 static const oid::oid_def defs[] =
 {
@@ -174,7 +176,9 @@ static const oid::oid_def defs[] =
  { d81, sizeof(d81) },
  { d82, sizeof(d82) },
  { d83, sizeof(d83) },
- { d84, sizeof(d84) }
+ { d84, sizeof(d84) },
+ { d85, sizeof(d85) },
+ { d86, sizeof(d86) }
 };
 
 const oid::oid_def *oid::get(int id)
@@ -18,93 +18,93 @@ struct oid_search_link
  const oid_search_node *next;
 };
 
-static const oid_search_node n133   = { ID_AT_DOMAIN_COMPONENT, 0, NULL }; // 0.9.2342.19200300.100.1.25
-static const oid_search_link sl132[] = { { 25, &n133 } };
+static const oid_search_node n136   = { ID_AT_DOMAIN_COMPONENT, 0, NULL }; // 0.9.2342.19200300.100.1.25
+static const oid_search_link sl135[] = { { 25, &n136 } };
+static const oid_search_node n135   = { 0, 1, sl135 };
+static const oid_search_link sl134[] = { { 1, &n135 } };
+static const oid_search_node n134   = { 0, 1, sl134 };
+static const oid_search_link sl133[] = { { 100, &n134 } };
+static const oid_search_node n133   = { 0, 1, sl133 };
+static const oid_search_link sl132[] = { { 44, &n133 } };
 static const oid_search_node n132   = { 0, 1, sl132 };
-static const oid_search_link sl131[] = { { 1, &n132 } };
+static const oid_search_link sl131[] = { { 242, &n132 } };
 static const oid_search_node n131   = { 0, 1, sl131 };
-static const oid_search_link sl130[] = { { 100, &n131 } };
+static const oid_search_link sl130[] = { { 147, &n131 } };
 static const oid_search_node n130   = { 0, 1, sl130 };
-static const oid_search_link sl129[] = { { 44, &n130 } };
+static const oid_search_link sl129[] = { { 137, &n130 } };
 static const oid_search_node n129   = { 0, 1, sl129 };
-static const oid_search_link sl128[] = { { 242, &n129 } };
+static const oid_search_link sl128[] = { { 38, &n129 } };
 static const oid_search_node n128   = { 0, 1, sl128 };
-static const oid_search_link sl127[] = { { 147, &n128 } };
+static const oid_search_link sl127[] = { { 146, &n128 } };
 static const oid_search_node n127   = { 0, 1, sl127 };
-static const oid_search_link sl126[] = { { 137, &n127 } };
-static const oid_search_node n126   = { 0, 1, sl126 };
-static const oid_search_link sl125[] = { { 38, &n126 } };
-static const oid_search_node n125   = { 0, 1, sl125 };
-static const oid_search_link sl124[] = { { 146, &n125 } };
-static const oid_search_node n124   = { 0, 1, sl124 };
-static const oid_search_node n50    = { ID_HASH_STREEBOG256, 0, NULL }; // 1.2.643.7.1.1.2.2
-static const oid_search_node n51    = { ID_HASH_STREEBOG512, 0, NULL }; // 1.2.643.7.1.1.2.3
-static const oid_search_link sl49[] = { { 2, &n50 }, { 3, &n51 } };
-static const oid_search_node n49    = { 0, 2, sl49 };
-static const oid_search_link sl48[] = { { 2, &n49 } };
+static const oid_search_node n53    = { ID_HASH_STREEBOG256, 0, NULL }; // 1.2.643.7.1.1.2.2
+static const oid_search_node n54    = { ID_HASH_STREEBOG512, 0, NULL }; // 1.2.643.7.1.1.2.3
+static const oid_search_link sl52[] = { { 2, &n53 }, { 3, &n54 } };
+static const oid_search_node n52    = { 0, 2, sl52 };
+static const oid_search_link sl51[] = { { 2, &n52 } };
+static const oid_search_node n51    = { 0, 1, sl51 };
+static const oid_search_link sl50[] = { { 1, &n51 } };
+static const oid_search_node n50    = { 0, 1, sl50 };
+static const oid_search_link sl49[] = { { 1, &n50 } };
+static const oid_search_node n49    = { 0, 1, sl49 };
+static const oid_search_link sl48[] = { { 7, &n49 } };
 static const oid_search_node n48    = { 0, 1, sl48 };
-static const oid_search_link sl47[] = { { 1, &n48 } };
+static const oid_search_link sl47[] = { { 3, &n48 } };
 static const oid_search_node n47    = { 0, 1, sl47 };
-static const oid_search_link sl46[] = { { 1, &n47 } };
-static const oid_search_node n46    = { 0, 1, sl46 };
-static const oid_search_link sl45[] = { { 7, &n46 } };
-static const oid_search_node n45    = { 0, 1, sl45 };
-static const oid_search_link sl44[] = { { 3, &n45 } };
-static const oid_search_node n44    = { 0, 1, sl44 };
 static const oid_search_node n9     = { ID_RSA, 0, NULL }; // 1.2.840.113549.1.1.1
-static const oid_search_node n72    = { ID_SIGN_RSA_MD2, 0, NULL }; // 1.2.840.113549.1.1.2
-static const oid_search_node n73    = { ID_SIGN_RSA_MD5, 0, NULL }; // 1.2.840.113549.1.1.4
-static const oid_search_node n74    = { ID_SIGN_RSA_SHA1, 0, NULL }; // 1.2.840.113549.1.1.5
-static const oid_search_node n106   = { ID_MGF1, 0, NULL }; // 1.2.840.113549.1.1.8
+static const oid_search_node n75    = { ID_SIGN_RSA_MD2, 0, NULL }; // 1.2.840.113549.1.1.2
+static const oid_search_node n76    = { ID_SIGN_RSA_MD5, 0, NULL }; // 1.2.840.113549.1.1.4
+static const oid_search_node n77    = { ID_SIGN_RSA_SHA1, 0, NULL }; // 1.2.840.113549.1.1.5
+static const oid_search_node n109   = { ID_MGF1, 0, NULL }; // 1.2.840.113549.1.1.8
 static const oid_search_node n17    = { ID_RSASSA_PSS, 0, NULL }; // 1.2.840.113549.1.1.10
-static const oid_search_node n76    = { ID_SIGN_RSA_SHA256, 0, NULL }; // 1.2.840.113549.1.1.11
-static const oid_search_node n77    = { ID_SIGN_RSA_SHA384, 0, NULL }; // 1.2.840.113549.1.1.12
-static const oid_search_node n78    = { ID_SIGN_RSA_SHA512, 0, NULL }; // 1.2.840.113549.1.1.13
-static const oid_search_node n75    = { ID_SIGN_RSA_SHA224, 0, NULL }; // 1.2.840.113549.1.1.14
-static const oid_search_node n79    = { ID_SIGN_RSA_SHA512_224, 0, NULL }; // 1.2.840.113549.1.1.15
-static const oid_search_node n80    = { ID_SIGN_RSA_SHA512_256, 0, NULL }; // 1.2.840.113549.1.1.16
-static const oid_search_link sl8[]  = { { 1, &n9 }, { 2, &n72 }, { 4, &n73 }, { 5, &n74 }, { 8, &n106 }, { 10, &n17 }, { 11, &n76 }, { 12, &n77 }, { 13, &n78 }, { 14, &n75 }, { 15, &n79 }, { 16, &n80 } };
+static const oid_search_node n79    = { ID_SIGN_RSA_SHA256, 0, NULL }; // 1.2.840.113549.1.1.11
+static const oid_search_node n80    = { ID_SIGN_RSA_SHA384, 0, NULL }; // 1.2.840.113549.1.1.12
+static const oid_search_node n81    = { ID_SIGN_RSA_SHA512, 0, NULL }; // 1.2.840.113549.1.1.13
+static const oid_search_node n78    = { ID_SIGN_RSA_SHA224, 0, NULL }; // 1.2.840.113549.1.1.14
+static const oid_search_node n82    = { ID_SIGN_RSA_SHA512_224, 0, NULL }; // 1.2.840.113549.1.1.15
+static const oid_search_node n83    = { ID_SIGN_RSA_SHA512_256, 0, NULL }; // 1.2.840.113549.1.1.16
+static const oid_search_link sl8[]  = { { 1, &n9 }, { 2, &n75 }, { 4, &n76 }, { 5, &n77 }, { 8, &n109 }, { 10, &n17 }, { 11, &n79 }, { 12, &n80 }, { 13, &n81 }, { 14, &n78 }, { 15, &n82 }, { 16, &n83 } };
 static const oid_search_node n8     = { 0, 12, sl8 };
-static const oid_search_node n135   = { ID_AT_EMAIL_ADDRESS, 0, NULL }; // 1.2.840.113549.1.9.1
-static const oid_search_link sl134[] = { { 1, &n135 } };
-static const oid_search_node n134   = { 0, 1, sl134 };
-static const oid_search_link sl7[]  = { { 1, &n8 }, { 9, &n134 } };
+static const oid_search_node n138   = { ID_AT_EMAIL_ADDRESS, 0, NULL }; // 1.2.840.113549.1.9.1
+static const oid_search_link sl137[] = { { 1, &n138 } };
+static const oid_search_node n137   = { 0, 1, sl137 };
+static const oid_search_link sl7[]  = { { 1, &n8 }, { 9, &n137 } };
 static const oid_search_node n7     = { 0, 2, sl7 };
-static const oid_search_node n19    = { ID_HASH_MD2, 0, NULL }; // 1.2.840.113549.2.2
-static const oid_search_node n20    = { ID_HASH_MD5, 0, NULL }; // 1.2.840.113549.2.5
-static const oid_search_link sl18[] = { { 2, &n19 }, { 5, &n20 } };
-static const oid_search_node n18    = { 0, 2, sl18 };
-static const oid_search_link sl6[]  = { { 1, &n7 }, { 2, &n18 } };
+static const oid_search_node n23    = { ID_HASH_MD2, 0, NULL }; // 1.2.840.113549.2.2
+static const oid_search_node n24    = { ID_HASH_MD5, 0, NULL }; // 1.2.840.113549.2.5
+static const oid_search_link sl22[] = { { 2, &n23 }, { 5, &n24 } };
+static const oid_search_node n22    = { 0, 2, sl22 };
+static const oid_search_link sl6[]  = { { 1, &n7 }, { 2, &n22 } };
 static const oid_search_node n6     = { 0, 2, sl6 };
 static const oid_search_link sl5[]  = { { 13, &n6 } };
 static const oid_search_node n5     = { 0, 1, sl5 };
 static const oid_search_link sl4[]  = { { 247, &n5 } };
 static const oid_search_node n4     = { 0, 1, sl4 };
 static const oid_search_node n13    = { ID_DSA, 0, NULL }; // 1.2.840.10040.4.1
-static const oid_search_node n86    = { ID_SIGN_DSA_SHA1, 0, NULL }; // 1.2.840.10040.4.3
-static const oid_search_link sl12[] = { { 1, &n13 }, { 3, &n86 } };
+static const oid_search_node n89    = { ID_SIGN_DSA_SHA1, 0, NULL }; // 1.2.840.10040.4.3
+static const oid_search_link sl12[] = { { 1, &n13 }, { 3, &n89 } };
 static const oid_search_node n12    = { 0, 2, sl12 };
 static const oid_search_link sl11[] = { { 4, &n12 } };
 static const oid_search_node n11    = { 0, 1, sl11 };
 static const oid_search_node n16    = { ID_ECDSA, 0, NULL }; // 1.2.840.10045.2.1
 static const oid_search_link sl15[] = { { 1, &n16 } };
 static const oid_search_node n15    = { 0, 1, sl15 };
-static const oid_search_node n138   = { ID_SECP192R1, 0, NULL }; // 1.2.840.10045.3.1.1
-static const oid_search_node n145   = { ID_SECP256R1, 0, NULL }; // 1.2.840.10045.3.1.7
-static const oid_search_link sl137[] = { { 1, &n138 }, { 7, &n145 } };
-static const oid_search_node n137   = { 0, 2, sl137 };
-static const oid_search_link sl136[] = { { 1, &n137 } };
-static const oid_search_node n136   = { 0, 1, sl136 };
-static const oid_search_node n96    = { ID_SIGN_ECDSA_SHA1, 0, NULL }; // 1.2.840.10045.4.1
-static const oid_search_node n98    = { ID_SIGN_ECDSA_SHA224, 0, NULL }; // 1.2.840.10045.4.3.1
-static const oid_search_node n99    = { ID_SIGN_ECDSA_SHA256, 0, NULL }; // 1.2.840.10045.4.3.2
-static const oid_search_node n100   = { ID_SIGN_ECDSA_SHA384, 0, NULL }; // 1.2.840.10045.4.3.3
-static const oid_search_node n101   = { ID_SIGN_ECDSA_SHA512, 0, NULL }; // 1.2.840.10045.4.3.4
-static const oid_search_link sl97[] = { { 1, &n98 }, { 2, &n99 }, { 3, &n100 }, { 4, &n101 } };
-static const oid_search_node n97    = { 0, 4, sl97 };
-static const oid_search_link sl95[] = { { 1, &n96 }, { 3, &n97 } };
-static const oid_search_node n95    = { 0, 2, sl95 };
-static const oid_search_link sl14[] = { { 2, &n15 }, { 3, &n136 }, { 4, &n95 } };
+static const oid_search_node n141   = { ID_SECP192R1, 0, NULL }; // 1.2.840.10045.3.1.1
+static const oid_search_node n148   = { ID_SECP256R1, 0, NULL }; // 1.2.840.10045.3.1.7
+static const oid_search_link sl140[] = { { 1, &n141 }, { 7, &n148 } };
+static const oid_search_node n140   = { 0, 2, sl140 };
+static const oid_search_link sl139[] = { { 1, &n140 } };
+static const oid_search_node n139   = { 0, 1, sl139 };
+static const oid_search_node n99    = { ID_SIGN_ECDSA_SHA1, 0, NULL }; // 1.2.840.10045.4.1
+static const oid_search_node n101   = { ID_SIGN_ECDSA_SHA224, 0, NULL }; // 1.2.840.10045.4.3.1
+static const oid_search_node n102   = { ID_SIGN_ECDSA_SHA256, 0, NULL }; // 1.2.840.10045.4.3.2
+static const oid_search_node n103   = { ID_SIGN_ECDSA_SHA384, 0, NULL }; // 1.2.840.10045.4.3.3
+static const oid_search_node n104   = { ID_SIGN_ECDSA_SHA512, 0, NULL }; // 1.2.840.10045.4.3.4
+static const oid_search_link sl100[] = { { 1, &n101 }, { 2, &n102 }, { 3, &n103 }, { 4, &n104 } };
+static const oid_search_node n100   = { 0, 4, sl100 };
+static const oid_search_link sl98[] = { { 1, &n99 }, { 3, &n100 } };
+static const oid_search_node n98    = { 0, 2, sl98 };
+static const oid_search_link sl14[] = { { 2, &n15 }, { 3, &n139 }, { 4, &n98 } };
 static const oid_search_node n14    = { 0, 3, sl14 };
 static const oid_search_link sl10[] = { { 56, &n11 }, { 61, &n14 } };
 static const oid_search_node n10    = { 0, 2, sl10 };
@@ -112,125 +112,129 @@ static const oid_search_link sl3[]  = { { 134, &n4 }, { 206, &n10 } };
 static const oid_search_node n3     = { 0, 2, sl3 };
 static const oid_search_link sl2[]  = { { 72, &n3 } };
 static const oid_search_node n2     = { 0, 1, sl2 };
-static const oid_search_link sl1[]  = { { 133, &n44 }, { 134, &n2 } };
+static const oid_search_link sl1[]  = { { 133, &n47 }, { 134, &n2 } };
 static const oid_search_node n1     = { 0, 2, sl1 };
-static const oid_search_node n58    = { ID_HASH_SKEIN256_128, 0, NULL }; // 1.3.6.1.3.0.16.128
-static const oid_search_node n59    = { ID_HASH_SKEIN256_160, 0, NULL }; // 1.3.6.1.3.0.16.160
-static const oid_search_node n60    = { ID_HASH_SKEIN256_224, 0, NULL }; // 1.3.6.1.3.0.16.224
-static const oid_search_link sl57[] = { { 0, &n58 }, { 32, &n59 }, { 96, &n60 } };
-static const oid_search_node n57    = { 0, 3, sl57 };
-static const oid_search_node n62    = { ID_HASH_SKEIN256_256, 0, NULL }; // 1.3.6.1.3.0.16.256
-static const oid_search_link sl61[] = { { 0, &n62 } };
-static const oid_search_node n61    = { 0, 1, sl61 };
-static const oid_search_link sl56[] = { { 129, &n57 }, { 130, &n61 } };
-static const oid_search_node n56    = { 0, 2, sl56 };
-static const oid_search_node n65    = { ID_HASH_SKEIN512_224, 0, NULL }; // 1.3.6.1.3.0.17.224
-static const oid_search_link sl64[] = { { 96, &n65 } };
+static const oid_search_node n61    = { ID_HASH_SKEIN256_128, 0, NULL }; // 1.3.6.1.3.0.16.128
+static const oid_search_node n62    = { ID_HASH_SKEIN256_160, 0, NULL }; // 1.3.6.1.3.0.16.160
+static const oid_search_node n63    = { ID_HASH_SKEIN256_224, 0, NULL }; // 1.3.6.1.3.0.16.224
+static const oid_search_link sl60[] = { { 0, &n61 }, { 32, &n62 }, { 96, &n63 } };
+static const oid_search_node n60    = { 0, 3, sl60 };
+static const oid_search_node n65    = { ID_HASH_SKEIN256_256, 0, NULL }; // 1.3.6.1.3.0.16.256
+static const oid_search_link sl64[] = { { 0, &n65 } };
 static const oid_search_node n64    = { 0, 1, sl64 };
-static const oid_search_node n67    = { ID_HASH_SKEIN512_256, 0, NULL }; // 1.3.6.1.3.0.17.256
-static const oid_search_link sl66[] = { { 0, &n67 } };
-static const oid_search_node n66    = { 0, 1, sl66 };
-static const oid_search_node n69    = { ID_HASH_SKEIN512_384, 0, NULL }; // 1.3.6.1.3.0.17.384
-static const oid_search_link sl68[] = { { 0, &n69 } };
-static const oid_search_node n68    = { 0, 1, sl68 };
-static const oid_search_node n71    = { ID_HASH_SKEIN512_512, 0, NULL }; // 1.3.6.1.3.0.17.512
-static const oid_search_link sl70[] = { { 0, &n71 } };
-static const oid_search_node n70    = { 0, 1, sl70 };
-static const oid_search_link sl63[] = { { 129, &n64 }, { 130, &n66 }, { 131, &n68 }, { 132, &n70 } };
-static const oid_search_node n63    = { 0, 4, sl63 };
-static const oid_search_link sl55[] = { { 16, &n56 }, { 17, &n63 } };
-static const oid_search_node n55    = { 0, 2, sl55 };
-static const oid_search_link sl54[] = { { 0, &n55 } };
-static const oid_search_node n54    = { 0, 1, sl54 };
-static const oid_search_link sl53[] = { { 3, &n54 } };
-static const oid_search_node n53    = { 0, 1, sl53 };
-static const oid_search_link sl52[] = { { 1, &n53 } };
-static const oid_search_node n52    = { 0, 1, sl52 };
-static const oid_search_node n25    = { ID_HASH_SHA1, 0, NULL }; // 1.3.14.3.2.26
-static const oid_search_link sl24[] = { { 26, &n25 } };
-static const oid_search_node n24    = { 0, 1, sl24 };
-static const oid_search_link sl23[] = { { 2, &n24 } };
-static const oid_search_node n23    = { 0, 1, sl23 };
-static const oid_search_link sl22[] = { { 3, &n23 } };
-static const oid_search_node n22    = { 0, 1, sl22 };
-static const oid_search_node n146   = { ID_SECP256K1, 0, NULL }; // 1.3.132.0.10
-static const oid_search_node n142   = { ID_SECP192K1, 0, NULL }; // 1.3.132.0.31
-static const oid_search_node n144   = { ID_SECP224K1, 0, NULL }; // 1.3.132.0.32
-static const oid_search_node n143   = { ID_SECP224R1, 0, NULL }; // 1.3.132.0.33
-static const oid_search_node n147   = { ID_SECP384R1, 0, NULL }; // 1.3.132.0.34
-static const oid_search_node n148   = { ID_SECP521R1, 0, NULL }; // 1.3.132.0.35
-static const oid_search_link sl141[] = { { 10, &n146 }, { 31, &n142 }, { 32, &n144 }, { 33, &n143 }, { 34, &n147 }, { 35, &n148 } };
-static const oid_search_node n141   = { 0, 6, sl141 };
-static const oid_search_link sl140[] = { { 0, &n141 } };
-static const oid_search_node n140   = { 0, 1, sl140 };
-static const oid_search_link sl139[] = { { 4, &n140 } };
-static const oid_search_node n139   = { 0, 1, sl139 };
-static const oid_search_link sl21[] = { { 6, &n52 }, { 14, &n22 }, { 129, &n139 } };
-static const oid_search_node n21    = { 0, 3, sl21 };
-static const oid_search_node n109   = { ID_AT_COMMON_NAME, 0, NULL }; // 2.5.4.3
-static const oid_search_node n111   = { ID_AT_SURNAME, 0, NULL }; // 2.5.4.4
-static const oid_search_node n122   = { ID_AT_SERIAL_NUMBER, 0, NULL }; // 2.5.4.5
-static const oid_search_node n121   = { ID_AT_COUNTRY_NAME, 0, NULL }; // 2.5.4.6
-static const oid_search_node n115   = { ID_AT_LOCALITY_NAME, 0, NULL }; // 2.5.4.7
-static const oid_search_node n116   = { ID_AT_STATE_OR_PROVINCE_NAME, 0, NULL }; // 2.5.4.8
-static const oid_search_node n117   = { ID_AT_ORGANIZATION_NAME, 0, NULL }; // 2.5.4.10
-static const oid_search_node n118   = { ID_AT_ORGANIZATIONAL_UNIT_NAME, 0, NULL }; // 2.5.4.11
-static const oid_search_node n119   = { ID_AT_TITLE, 0, NULL }; // 2.5.4.12
-static const oid_search_node n110   = { ID_AT_NAME, 0, NULL }; // 2.5.4.41
-static const oid_search_node n112   = { ID_AT_GIVEN_NAME, 0, NULL }; // 2.5.4.42
-static const oid_search_node n113   = { ID_AT_INITIALS, 0, NULL }; // 2.5.4.43
-static const oid_search_node n114   = { ID_AT_GENERATION_QUALIFIER, 0, NULL }; // 2.5.4.44
-static const oid_search_node n120   = { ID_AT_DN_QUALIFIER, 0, NULL }; // 2.5.4.46
-static const oid_search_node n123   = { ID_AT_PSEUDONYM, 0, NULL }; // 2.5.4.65
-static const oid_search_link sl108[] = { { 3, &n109 }, { 4, &n111 }, { 5, &n122 }, { 6, &n121 }, { 7, &n115 }, { 8, &n116 }, { 10, &n117 }, { 11, &n118 }, { 12, &n119 }, { 41, &n110 }, { 42, &n112 }, { 43, &n113 }, { 44, &n114 }, { 46, &n120 }, { 65, &n123 } };
-static const oid_search_node n108   = { 0, 15, sl108 };
-static const oid_search_link sl107[] = { { 4, &n108 } };
-static const oid_search_node n107   = { 0, 1, sl107 };
-static const oid_search_node n34    = { ID_HASH_SHA256, 0, NULL }; // 2.16.840.1.101.3.4.2.1
-static const oid_search_node n35    = { ID_HASH_SHA384, 0, NULL }; // 2.16.840.1.101.3.4.2.2
-static const oid_search_node n36    = { ID_HASH_SHA512, 0, NULL }; // 2.16.840.1.101.3.4.2.3
-static const oid_search_node n37    = { ID_HASH_SHA224, 0, NULL }; // 2.16.840.1.101.3.4.2.4
-static const oid_search_node n38    = { ID_HASH_SHA512_224, 0, NULL }; // 2.16.840.1.101.3.4.2.5
-static const oid_search_node n39    = { ID_HASH_SHA512_256, 0, NULL }; // 2.16.840.1.101.3.4.2.6
-static const oid_search_node n40    = { ID_HASH_SHA3_224, 0, NULL }; // 2.16.840.1.101.3.4.2.7
-static const oid_search_node n41    = { ID_HASH_SHA3_256, 0, NULL }; // 2.16.840.1.101.3.4.2.8
-static const oid_search_node n42    = { ID_HASH_SHA3_384, 0, NULL }; // 2.16.840.1.101.3.4.2.9
-static const oid_search_node n43    = { ID_HASH_SHA3_512, 0, NULL }; // 2.16.840.1.101.3.4.2.10
-static const oid_search_link sl33[] = { { 1, &n34 }, { 2, &n35 }, { 3, &n36 }, { 4, &n37 }, { 5, &n38 }, { 6, &n39 }, { 7, &n40 }, { 8, &n41 }, { 9, &n42 }, { 10, &n43 } };
-static const oid_search_node n33    = { 0, 10, sl33 };
-static const oid_search_node n87    = { ID_SIGN_DSA_SHA224, 0, NULL }; // 2.16.840.1.101.3.4.3.1
-static const oid_search_node n88    = { ID_SIGN_DSA_SHA256, 0, NULL }; // 2.16.840.1.101.3.4.3.2
-static const oid_search_node n89    = { ID_SIGN_DSA_SHA384, 0, NULL }; // 2.16.840.1.101.3.4.3.3
-static const oid_search_node n90    = { ID_SIGN_DSA_SHA512, 0, NULL }; // 2.16.840.1.101.3.4.3.4
-static const oid_search_node n91    = { ID_SIGN_DSA_SHA3_224, 0, NULL }; // 2.16.840.1.101.3.4.3.5
-static const oid_search_node n92    = { ID_SIGN_DSA_SHA3_256, 0, NULL }; // 2.16.840.1.101.3.4.3.6
-static const oid_search_node n93    = { ID_SIGN_DSA_SHA3_384, 0, NULL }; // 2.16.840.1.101.3.4.3.7
-static const oid_search_node n94    = { ID_SIGN_DSA_SHA3_512, 0, NULL }; // 2.16.840.1.101.3.4.3.8
-static const oid_search_node n102   = { ID_SIGN_ECDSA_SHA3_224, 0, NULL }; // 2.16.840.1.101.3.4.3.9
-static const oid_search_node n103   = { ID_SIGN_ECDSA_SHA3_256, 0, NULL }; // 2.16.840.1.101.3.4.3.10
-static const oid_search_node n104   = { ID_SIGN_ECDSA_SHA3_384, 0, NULL }; // 2.16.840.1.101.3.4.3.11
-static const oid_search_node n105   = { ID_SIGN_ECDSA_SHA3_512, 0, NULL }; // 2.16.840.1.101.3.4.3.12
-static const oid_search_node n82    = { ID_SIGN_RSA_SHA3_224, 0, NULL }; // 2.16.840.1.101.3.4.3.13
-static const oid_search_node n83    = { ID_SIGN_RSA_SHA3_256, 0, NULL }; // 2.16.840.1.101.3.4.3.14
-static const oid_search_node n84    = { ID_SIGN_RSA_SHA3_384, 0, NULL }; // 2.16.840.1.101.3.4.3.15
-static const oid_search_node n85    = { ID_SIGN_RSA_SHA3_512, 0, NULL }; // 2.16.840.1.101.3.4.3.16
-static const oid_search_link sl81[] = { { 1, &n87 }, { 2, &n88 }, { 3, &n89 }, { 4, &n90 }, { 5, &n91 }, { 6, &n92 }, { 7, &n93 }, { 8, &n94 }, { 9, &n102 }, { 10, &n103 }, { 11, &n104 }, { 12, &n105 }, { 13, &n82 }, { 14, &n83 }, { 15, &n84 }, { 16, &n85 } };
-static const oid_search_node n81    = { 0, 16, sl81 };
-static const oid_search_link sl32[] = { { 2, &n33 }, { 3, &n81 } };
-static const oid_search_node n32    = { 0, 2, sl32 };
-static const oid_search_link sl31[] = { { 4, &n32 } };
+static const oid_search_link sl59[] = { { 129, &n60 }, { 130, &n64 } };
+static const oid_search_node n59    = { 0, 2, sl59 };
+static const oid_search_node n68    = { ID_HASH_SKEIN512_224, 0, NULL }; // 1.3.6.1.3.0.17.224
+static const oid_search_link sl67[] = { { 96, &n68 } };
+static const oid_search_node n67    = { 0, 1, sl67 };
+static const oid_search_node n70    = { ID_HASH_SKEIN512_256, 0, NULL }; // 1.3.6.1.3.0.17.256
+static const oid_search_link sl69[] = { { 0, &n70 } };
+static const oid_search_node n69    = { 0, 1, sl69 };
+static const oid_search_node n72    = { ID_HASH_SKEIN512_384, 0, NULL }; // 1.3.6.1.3.0.17.384
+static const oid_search_link sl71[] = { { 0, &n72 } };
+static const oid_search_node n71    = { 0, 1, sl71 };
+static const oid_search_node n74    = { ID_HASH_SKEIN512_512, 0, NULL }; // 1.3.6.1.3.0.17.512
+static const oid_search_link sl73[] = { { 0, &n74 } };
+static const oid_search_node n73    = { 0, 1, sl73 };
+static const oid_search_link sl66[] = { { 129, &n67 }, { 130, &n69 }, { 131, &n71 }, { 132, &n73 } };
+static const oid_search_node n66    = { 0, 4, sl66 };
+static const oid_search_link sl58[] = { { 16, &n59 }, { 17, &n66 } };
+static const oid_search_node n58    = { 0, 2, sl58 };
+static const oid_search_link sl57[] = { { 0, &n58 } };
+static const oid_search_node n57    = { 0, 1, sl57 };
+static const oid_search_link sl56[] = { { 3, &n57 } };
+static const oid_search_node n56    = { 0, 1, sl56 };
+static const oid_search_link sl55[] = { { 1, &n56 } };
+static const oid_search_node n55    = { 0, 1, sl55 };
+static const oid_search_node n28    = { ID_HASH_SHA1, 0, NULL }; // 1.3.14.3.2.26
+static const oid_search_link sl27[] = { { 26, &n28 } };
+static const oid_search_node n27    = { 0, 1, sl27 };
+static const oid_search_link sl26[] = { { 2, &n27 } };
+static const oid_search_node n26    = { 0, 1, sl26 };
+static const oid_search_link sl25[] = { { 3, &n26 } };
+static const oid_search_node n25    = { 0, 1, sl25 };
+static const oid_search_node n20    = { ID_X25519, 0, NULL }; // 1.3.101.110
+static const oid_search_node n21    = { ID_ED25519, 0, NULL }; // 1.3.101.112
+static const oid_search_link sl19[] = { { 110, &n20 }, { 112, &n21 } };
+static const oid_search_node n19    = { 0, 2, sl19 };
+static const oid_search_node n149   = { ID_SECP256K1, 0, NULL }; // 1.3.132.0.10
+static const oid_search_node n145   = { ID_SECP192K1, 0, NULL }; // 1.3.132.0.31
+static const oid_search_node n147   = { ID_SECP224K1, 0, NULL }; // 1.3.132.0.32
+static const oid_search_node n146   = { ID_SECP224R1, 0, NULL }; // 1.3.132.0.33
+static const oid_search_node n150   = { ID_SECP384R1, 0, NULL }; // 1.3.132.0.34
+static const oid_search_node n151   = { ID_SECP521R1, 0, NULL }; // 1.3.132.0.35
+static const oid_search_link sl144[] = { { 10, &n149 }, { 31, &n145 }, { 32, &n147 }, { 33, &n146 }, { 34, &n150 }, { 35, &n151 } };
+static const oid_search_node n144   = { 0, 6, sl144 };
+static const oid_search_link sl143[] = { { 0, &n144 } };
+static const oid_search_node n143   = { 0, 1, sl143 };
+static const oid_search_link sl142[] = { { 4, &n143 } };
+static const oid_search_node n142   = { 0, 1, sl142 };
+static const oid_search_link sl18[] = { { 6, &n55 }, { 14, &n25 }, { 101, &n19 }, { 129, &n142 } };
+static const oid_search_node n18    = { 0, 4, sl18 };
+static const oid_search_node n112   = { ID_AT_COMMON_NAME, 0, NULL }; // 2.5.4.3
+static const oid_search_node n114   = { ID_AT_SURNAME, 0, NULL }; // 2.5.4.4
+static const oid_search_node n125   = { ID_AT_SERIAL_NUMBER, 0, NULL }; // 2.5.4.5
+static const oid_search_node n124   = { ID_AT_COUNTRY_NAME, 0, NULL }; // 2.5.4.6
+static const oid_search_node n118   = { ID_AT_LOCALITY_NAME, 0, NULL }; // 2.5.4.7
+static const oid_search_node n119   = { ID_AT_STATE_OR_PROVINCE_NAME, 0, NULL }; // 2.5.4.8
+static const oid_search_node n120   = { ID_AT_ORGANIZATION_NAME, 0, NULL }; // 2.5.4.10
+static const oid_search_node n121   = { ID_AT_ORGANIZATIONAL_UNIT_NAME, 0, NULL }; // 2.5.4.11
+static const oid_search_node n122   = { ID_AT_TITLE, 0, NULL }; // 2.5.4.12
+static const oid_search_node n113   = { ID_AT_NAME, 0, NULL }; // 2.5.4.41
+static const oid_search_node n115   = { ID_AT_GIVEN_NAME, 0, NULL }; // 2.5.4.42
+static const oid_search_node n116   = { ID_AT_INITIALS, 0, NULL }; // 2.5.4.43
+static const oid_search_node n117   = { ID_AT_GENERATION_QUALIFIER, 0, NULL }; // 2.5.4.44
+static const oid_search_node n123   = { ID_AT_DN_QUALIFIER, 0, NULL }; // 2.5.4.46
+static const oid_search_node n126   = { ID_AT_PSEUDONYM, 0, NULL }; // 2.5.4.65
+static const oid_search_link sl111[] = { { 3, &n112 }, { 4, &n114 }, { 5, &n125 }, { 6, &n124 }, { 7, &n118 }, { 8, &n119 }, { 10, &n120 }, { 11, &n121 }, { 12, &n122 }, { 41, &n113 }, { 42, &n115 }, { 43, &n116 }, { 44, &n117 }, { 46, &n123 }, { 65, &n126 } };
+static const oid_search_node n111   = { 0, 15, sl111 };
+static const oid_search_link sl110[] = { { 4, &n111 } };
+static const oid_search_node n110   = { 0, 1, sl110 };
+static const oid_search_node n37    = { ID_HASH_SHA256, 0, NULL }; // 2.16.840.1.101.3.4.2.1
+static const oid_search_node n38    = { ID_HASH_SHA384, 0, NULL }; // 2.16.840.1.101.3.4.2.2
+static const oid_search_node n39    = { ID_HASH_SHA512, 0, NULL }; // 2.16.840.1.101.3.4.2.3
+static const oid_search_node n40    = { ID_HASH_SHA224, 0, NULL }; // 2.16.840.1.101.3.4.2.4
+static const oid_search_node n41    = { ID_HASH_SHA512_224, 0, NULL }; // 2.16.840.1.101.3.4.2.5
+static const oid_search_node n42    = { ID_HASH_SHA512_256, 0, NULL }; // 2.16.840.1.101.3.4.2.6
+static const oid_search_node n43    = { ID_HASH_SHA3_224, 0, NULL }; // 2.16.840.1.101.3.4.2.7
+static const oid_search_node n44    = { ID_HASH_SHA3_256, 0, NULL }; // 2.16.840.1.101.3.4.2.8
+static const oid_search_node n45    = { ID_HASH_SHA3_384, 0, NULL }; // 2.16.840.1.101.3.4.2.9
+static const oid_search_node n46    = { ID_HASH_SHA3_512, 0, NULL }; // 2.16.840.1.101.3.4.2.10
+static const oid_search_link sl36[] = { { 1, &n37 }, { 2, &n38 }, { 3, &n39 }, { 4, &n40 }, { 5, &n41 }, { 6, &n42 }, { 7, &n43 }, { 8, &n44 }, { 9, &n45 }, { 10, &n46 } };
+static const oid_search_node n36    = { 0, 10, sl36 };
+static const oid_search_node n90    = { ID_SIGN_DSA_SHA224, 0, NULL }; // 2.16.840.1.101.3.4.3.1
+static const oid_search_node n91    = { ID_SIGN_DSA_SHA256, 0, NULL }; // 2.16.840.1.101.3.4.3.2
+static const oid_search_node n92    = { ID_SIGN_DSA_SHA384, 0, NULL }; // 2.16.840.1.101.3.4.3.3
+static const oid_search_node n93    = { ID_SIGN_DSA_SHA512, 0, NULL }; // 2.16.840.1.101.3.4.3.4
+static const oid_search_node n94    = { ID_SIGN_DSA_SHA3_224, 0, NULL }; // 2.16.840.1.101.3.4.3.5
+static const oid_search_node n95    = { ID_SIGN_DSA_SHA3_256, 0, NULL }; // 2.16.840.1.101.3.4.3.6
+static const oid_search_node n96    = { ID_SIGN_DSA_SHA3_384, 0, NULL }; // 2.16.840.1.101.3.4.3.7
+static const oid_search_node n97    = { ID_SIGN_DSA_SHA3_512, 0, NULL }; // 2.16.840.1.101.3.4.3.8
+static const oid_search_node n105   = { ID_SIGN_ECDSA_SHA3_224, 0, NULL }; // 2.16.840.1.101.3.4.3.9
+static const oid_search_node n106   = { ID_SIGN_ECDSA_SHA3_256, 0, NULL }; // 2.16.840.1.101.3.4.3.10
+static const oid_search_node n107   = { ID_SIGN_ECDSA_SHA3_384, 0, NULL }; // 2.16.840.1.101.3.4.3.11
+static const oid_search_node n108   = { ID_SIGN_ECDSA_SHA3_512, 0, NULL }; // 2.16.840.1.101.3.4.3.12
+static const oid_search_node n85    = { ID_SIGN_RSA_SHA3_224, 0, NULL }; // 2.16.840.1.101.3.4.3.13
+static const oid_search_node n86    = { ID_SIGN_RSA_SHA3_256, 0, NULL }; // 2.16.840.1.101.3.4.3.14
+static const oid_search_node n87    = { ID_SIGN_RSA_SHA3_384, 0, NULL }; // 2.16.840.1.101.3.4.3.15
+static const oid_search_node n88    = { ID_SIGN_RSA_SHA3_512, 0, NULL }; // 2.16.840.1.101.3.4.3.16
+static const oid_search_link sl84[] = { { 1, &n90 }, { 2, &n91 }, { 3, &n92 }, { 4, &n93 }, { 5, &n94 }, { 6, &n95 }, { 7, &n96 }, { 8, &n97 }, { 9, &n105 }, { 10, &n106 }, { 11, &n107 }, { 12, &n108 }, { 13, &n85 }, { 14, &n86 }, { 15, &n87 }, { 16, &n88 } };
+static const oid_search_node n84    = { 0, 16, sl84 };
+static const oid_search_link sl35[] = { { 2, &n36 }, { 3, &n84 } };
+static const oid_search_node n35    = { 0, 2, sl35 };
+static const oid_search_link sl34[] = { { 4, &n35 } };
+static const oid_search_node n34    = { 0, 1, sl34 };
+static const oid_search_link sl33[] = { { 3, &n34 } };
+static const oid_search_node n33    = { 0, 1, sl33 };
+static const oid_search_link sl32[] = { { 101, &n33 } };
+static const oid_search_node n32    = { 0, 1, sl32 };
+static const oid_search_link sl31[] = { { 1, &n32 } };
 static const oid_search_node n31    = { 0, 1, sl31 };
-static const oid_search_link sl30[] = { { 3, &n31 } };
+static const oid_search_link sl30[] = { { 72, &n31 } };
 static const oid_search_node n30    = { 0, 1, sl30 };
-static const oid_search_link sl29[] = { { 101, &n30 } };
+static const oid_search_link sl29[] = { { 134, &n30 } };
 static const oid_search_node n29    = { 0, 1, sl29 };
-static const oid_search_link sl28[] = { { 1, &n29 } };
-static const oid_search_node n28    = { 0, 1, sl28 };
-static const oid_search_link sl27[] = { { 72, &n28 } };
-static const oid_search_node n27    = { 0, 1, sl27 };
-static const oid_search_link sl26[] = { { 134, &n27 } };
-static const oid_search_node n26    = { 0, 1, sl26 };
-static const oid_search_link sl0[]  = { { 9, &n124 }, { 42, &n1 }, { 43, &n21 }, { 85, &n107 }, { 96, &n26 } };
+static const oid_search_link sl0[]  = { { 9, &n127 }, { 42, &n1 }, { 43, &n18 }, { 85, &n110 }, { 96, &n29 } };
 static const oid_search_node n0     = { 0, 5, sl0 };
 
 #include "oid_search.inc"
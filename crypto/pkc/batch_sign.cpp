@@ -0,0 +1,97 @@
+#include "batch_sign.h"
+#include <crypto/rng/std_random.h>
+#include <platform/thread.h>
+#include <utils/mutex.h>
+
+struct batch_job
+{
+ const pkc_base *key;
+ const pkc_base::param_data *params;
+ int param_count;
+ size_t chunk;
+ const std::vector<pkc_base::data_buffer> *in;
+ std::vector<std::vector<uint8_t>> *out;
+ mutex lock;
+ size_t next;
+ bool failed;
+};
+
+static void run_worker(batch_job *job)
+{
+ std_random rng;
+ std::vector<uint8_t> buf(job->key->get_max_signature_size());
+ bool failed = false;
+ size_t total = job->in->size();
+ for (;;)
+ {
+  size_t start, end;
+  {
+   mutex_locker ml(job->lock);
+   start = job->next;
+   if (start >= total) break;
+   end = total - start > job->chunk? start + job->chunk : total;
+   job->next = end;
+  }
+  for (size_t i = start; i < end; i++)
+  {
+   const pkc_base::data_buffer &item = (*job->in)[i];
+   size_t size = buf.size();
+   if (job->key->create_signature(buf.data(), size, item.data, item.size,
+                                  job->params, job->param_count, &rng))
+    (*job->out)[i].assign(buf.data(), buf.data() + size);
+   else
+    failed = true;
+  }
+ }
+ if (failed)
+ {
+  mutex_locker ml(job->lock);
+  job->failed = true;
+ }
+}
+
+static platform::thread_result_t THREAD_CALL worker_proc(void *arg)
+{
+ run_worker(static_cast<batch_job*>(arg));
+ return 0;
+}
+
+batch_signer::batch_signer(const pkc_base *key, int thread_count): key(key)
+{
+ params = nullptr;
+ param_count = 0;
+ chunk = DEFAULT_CHUNK;
+ if (thread_count <= 0) thread_count = platform::get_cpu_count();
+ this->thread_count = thread_count;
+}
+
+bool batch_signer::sign(std::vector<std::vector<uint8_t>> &out,
+                        const std::vector<pkc_base::data_buffer> &in) const
+{
+ out.clear();
+ out.resize(in.size());
+ if (in.empty()) return true;
+
+ batch_job job;
+ job.key = key;
+ job.params = params;
+ job.param_count = param_count;
+ job.chunk = chunk;
+ job.in = &in;
+ job.out = &out;
+ job.next = 0;
+ job.failed = false;
+
+ size_t workers = (in.size() + chunk - 1) / chunk;
+ if (workers > static_cast<size_t>(thread_count)) workers = thread_count;
+ // the calling thread is one of the workers; if a thread can't be
+ // started, the remaining ones take over its share
+ std::vector<platform::thread_t> threads(workers - 1);
+ size_t started = 0;
+ for (; started < threads.size(); started++)
+  if (platform::thread_create(&threads[started], worker_proc, &job)) break;
+ run_worker(&job);
+ for (size_t i = 0; i < started; i++)
+  platform::thread_join(&threads[i]);
+ return !job.failed;
+}
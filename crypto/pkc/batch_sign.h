@@ -0,0 +1,43 @@
+#ifndef __batch_sign_h__
+#define __batch_sign_h__
+
+#include "pkc_base.h"
+#include <vector>
+#include <stdint.h>
+
+// Signs many digests (or messages, depending on params) with one key using
+// a pool of worker threads. Every worker owns a std_random instance, so the
+// workers do not share an RNG lock. create_signature of RSA, DSA and ECDSA
+// keeps its temporaries on the stack or in per-call bigints and is safe to
+// call concurrently on the same key.
+class batch_signer
+{
+ public:
+  enum { DEFAULT_CHUNK = 16 };
+
+  // thread_count = 0 uses all online CPUs
+  batch_signer(const pkc_base *key, int thread_count = 0);
+
+  void set_params(const pkc_base::param_data *params, int param_count)
+  {
+   this->params = params;
+   this->param_count = param_count;
+  }
+  // number of items a worker takes at once
+  void set_chunk_size(size_t chunk) { this->chunk = chunk? chunk : 1; }
+  int get_thread_count() const { return thread_count; }
+
+  // out[i] is the signature of in[i]; a failed item is left empty.
+  // Returns false if any item failed.
+  bool sign(std::vector<std::vector<uint8_t>> &out,
+            const std::vector<pkc_base::data_buffer> &in) const;
+
+ private:
+  const pkc_base *key;
+  const pkc_base::param_data *params;
+  int param_count;
+  int thread_count;
+  size_t chunk;
+};
+
+#endif // __batch_sign_h__
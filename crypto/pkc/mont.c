@@ -0,0 +1,671 @@
+#include "mont.h"
+#include "mont_x86.h"
+#include <platform/umul.h>
+#include <platform/alloca.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#define WORD_BITS (SYS_WORD_SIZE*8)
+
+#ifdef _MSC_VER
+#define MONT_INLINE __forceinline
+#elif defined(__GNUC__)
+#define MONT_INLINE __inline __attribute__((always_inline))
+#else
+#define MONT_INLINE __inline
+#endif
+
+void mont_init(mont_ctx_t *ctx)
+{
+ ctx->size = 0;
+ ctx->n0 = 0;
+ ctx->n = NULL;
+ ctx->rr = NULL;
+ ctx->mul = NULL;
+ ctx->sqr = NULL;
+ ctx->ifma = NULL;
+}
+
+void mont_destroy(mont_ctx_t *ctx)
+{
+ mont_ifma_destroy(ctx);
+ free(ctx->n);
+ mont_init(ctx);
+}
+
+int mont_load(sys_word_t *r, int size, const void *data, size_t data_size)
+{
+ const uint8_t *p = (const uint8_t *) data;
+ size_t i;
+ while (data_size && !*p)
+ {
+  p++;
+  data_size--;
+ }
+ if (data_size > (size_t) size*SYS_WORD_SIZE) return 0;
+ memset(r, 0, size*SYS_WORD_SIZE);
+ for (i = 0; i < data_size; i++)
+  r[i/SYS_WORD_SIZE] |= (sys_word_t) p[data_size-1-i] << (i%SYS_WORD_SIZE)*8;
+ return 1;
+}
+
+int mont_store(void *data, size_t data_size, const sys_word_t *a, int size)
+{
+ uint8_t *p = (uint8_t *) data;
+ size_t i;
+ for (i = data_size; i < (size_t) size*SYS_WORD_SIZE; i++)
+  if ((uint8_t) (a[i/SYS_WORD_SIZE] >> (i%SYS_WORD_SIZE)*8)) return 0;
+ for (i = 0; i < data_size; i++)
+  p[data_size-1-i] = i < (size_t) size*SYS_WORD_SIZE?
+   (uint8_t) (a[i/SYS_WORD_SIZE] >> (i%SYS_WORD_SIZE)*8) : 0;
+ return 1;
+}
+
+sys_word_t words_add(sys_word_t *r, const sys_word_t *a, int size_a, const sys_word_t *b, int size_b)
+{
+ sys_word_t carry = 0, x;
+ int i;
+ for (i = 0; i < size_b; i++)
+ {
+  x = a[i] + carry;
+  carry = x < carry;
+  r[i] = x + b[i];
+  carry += r[i] < x;
+ }
+ for (; i < size_a; i++)
+ {
+  r[i] = a[i] + carry;
+  carry = r[i] < carry;
+ }
+ return carry;
+}
+
+sys_word_t words_sub(sys_word_t *r, const sys_word_t *a, const sys_word_t *b, int size)
+{
+ sys_word_t borrow = 0, x, y;
+ int i;
+ for (i = 0; i < size; i++)
+ {
+  x = a[i];
+  y = b[i] + borrow;
+  borrow = (y < borrow) | (x < y);
+  r[i] = x - y;
+ }
+ return borrow;
+}
+
+int words_cmp(const sys_word_t *a, const sys_word_t *b, int size)
+{
+ while (--size >= 0)
+  if (a[size] != b[size]) return a[size] < b[size]? -1 : 1;
+ return 0;
+}
+
+void words_mul(sys_word_t *r, const sys_word_t *a, int size_a, const sys_word_t *b, int size_b)
+{
+ sys_word_t carry, lo, hi;
+ int i, j;
+ memset(r, 0, size_a*SYS_WORD_SIZE);
+ for (i = 0; i < size_b; i++)
+ {
+  carry = 0;
+  for (j = 0; j < size_a; j++)
+  {
+   lo = umulw(&hi, a[j], b[i]);
+   lo += carry;
+   hi += lo < carry;
+   lo += r[i+j];
+   hi += lo < r[i+j];
+   r[i+j] = lo;
+   carry = hi;
+  }
+  r[i+size_a] = carry;
+ }
+}
+
+/* r = t - n if t >= n, else r = t; t has size words plus the top word */
+static MONT_INLINE void final_sub_n(const sys_word_t *n, sys_word_t *r, const sys_word_t *t, sys_word_t top, int size)
+{
+ sys_word_t borrow = 0, mask, x, y;
+ int i;
+ for (i = 0; i < size; i++)
+ {
+  x = t[i];
+  y = n[i] + borrow;
+  borrow = (y < borrow) | (x < y);
+  r[i] = x - y;
+ }
+ mask = 0 - (borrow & (top ^ 1));
+ for (i = 0; i < size; i++)
+  r[i] = (t[i] & mask) | (r[i] & ~mask);
+}
+
+static void final_sub(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *t, sys_word_t top)
+{
+ final_sub_n(ctx->n, r, t, top, ctx->size);
+}
+
+/* FIOS: the multiplication and the reduction share one pass over tmp */
+static MONT_INLINE void mul_n(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, const sys_word_t *b, sys_word_t *tmp, int size)
+{
+ const sys_word_t *n = ctx->n;
+ sys_word_t c1, c2, lo, hi, m, bi, x, top = 0;
+ int i, j;
+ memset(tmp, 0, size*SYS_WORD_SIZE);
+ for (i = 0; i < size; i++)
+ {
+  bi = b[i];
+  lo = umulw(&hi, a[0], bi);
+  lo += tmp[0];
+  c1 = hi + (lo < tmp[0]);
+  m = lo*ctx->n0;
+  x = umulw(&hi, m, n[0]);
+  x += lo;
+  c2 = hi + (x < lo);
+  for (j = 1; j < size; j++)
+  {
+   lo = umulw(&hi, a[j], bi);
+   lo += c1;
+   hi += lo < c1;
+   lo += tmp[j];
+   hi += lo < tmp[j];
+   c1 = hi;
+   x = umulw(&hi, m, n[j]);
+   x += c2;
+   hi += x < c2;
+   x += lo;
+   hi += x < lo;
+   c2 = hi;
+   tmp[j-1] = x;
+  }
+  x = top + c1;
+  hi = x < c1;
+  x += c2;
+  hi += x < c2;
+  tmp[size-1] = x;
+  top = hi;
+ }
+ final_sub_n(n, r, tmp, top, size);
+}
+
+/* t has 2*size words and is destroyed */
+static MONT_INLINE void reduce_n(const mont_ctx_t *ctx, sys_word_t *r, sys_word_t *t, int size)
+{
+ const sys_word_t *n = ctx->n;
+ sys_word_t c0, c1, k, top = 0, lo, hi, x, m0, m1;
+ int i, j;
+ /* two rows at a time, so that there are two independent carry chains */
+ for (i = 0; i+1 < size; i += 2)
+ {
+  m0 = t[i]*ctx->n0;
+  lo = umulw(&hi, m0, n[0]);
+  lo += t[i];
+  c0 = hi + (lo < t[i]);
+  lo = umulw(&hi, m0, n[1]);
+  lo += c0;
+  hi += lo < c0;
+  lo += t[i+1];
+  hi += lo < t[i+1];
+  c0 = hi;
+  m1 = lo*ctx->n0;
+  x = umulw(&hi, m1, n[0]);
+  x += lo;
+  c1 = hi + (x < lo);
+  for (j = 2; j < size; j++)
+  {
+   lo = umulw(&hi, m0, n[j]);
+   lo += c0;
+   hi += lo < c0;
+   lo += t[i+j];
+   hi += lo < t[i+j];
+   c0 = hi;
+   x = umulw(&hi, m1, n[j-1]);
+   x += c1;
+   hi += x < c1;
+   x += lo;
+   hi += x < lo;
+   c1 = hi;
+   t[i+j] = x;
+  }
+  /* position i+size gets the carry of row i, the last product of row i+1
+     and the carry left from the previous rows */
+  x = t[i+size] + c0;
+  k = x < c0;
+  x += top;
+  k += x < top;
+  lo = umulw(&hi, m1, n[size-1]);
+  lo += c1;
+  hi += lo < c1;
+  x += lo;
+  hi += x < lo;
+  t[i+size] = x;
+  x = t[i+size+1] + hi;
+  top = x < hi;
+  x += k;
+  top += x < k;
+  t[i+size+1] = x;
+ }
+ if (i < size)
+ {
+  m0 = t[i]*ctx->n0;
+  c0 = 0;
+  for (j = 0; j < size; j++)
+  {
+   lo = umulw(&hi, m0, n[j]);
+   lo += c0;
+   hi += lo < c0;
+   lo += t[i+j];
+   hi += lo < t[i+j];
+   t[i+j] = lo;
+   c0 = hi;
+  }
+  lo = t[i+size] + c0;
+  hi = lo < c0;
+  lo += top;
+  hi += lo < top;
+  t[i+size] = lo;
+  top = hi;
+ }
+ final_sub_n(n, r, t + size, top, size);
+}
+
+/* each cross product is computed once, then doubled */
+static MONT_INLINE void sqr_n(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, sys_word_t *t, int size)
+{
+ sys_word_t carry, lo, hi, x, y, top;
+ int i, j;
+ memset(t, 0, 2*size*SYS_WORD_SIZE);
+ for (i = 0; i < size-1; i++)
+ {
+  carry = 0;
+  for (j = i+1; j < size; j++)
+  {
+   lo = umulw(&hi, a[i], a[j]);
+   lo += carry;
+   hi += lo < carry;
+   lo += t[i+j];
+   hi += lo < t[i+j];
+   t[i+j] = lo;
+   carry = hi;
+  }
+  t[i+size] = carry;
+ }
+ carry = top = 0;
+ for (i = 0; i < size; i++)
+ {
+  lo = umulw(&hi, a[i], a[i]);
+  x = t[2*i] << 1 | top;
+  y = t[2*i+1] << 1 | t[2*i] >> (WORD_BITS-1);
+  top = t[2*i+1] >> (WORD_BITS-1);
+  x += carry;
+  carry = x < carry;
+  x += lo;
+  carry += x < lo;
+  y += carry;
+  carry = y < carry;
+  y += hi;
+  carry += y < hi;
+  t[2*i] = x;
+  t[2*i+1] = y;
+ }
+ reduce_n(ctx, r, t, size);
+}
+
+static void mul_generic(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, const sys_word_t *b, sys_word_t *tmp)
+{
+ mul_n(ctx, r, a, b, tmp, ctx->size);
+}
+
+static void sqr_generic(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, sys_word_t *tmp)
+{
+ sqr_n(ctx, r, a, tmp, ctx->size);
+}
+
+/* the word count is a constant here, so the compiler can unroll the inner loops */
+#define DEFINE_KERNELS(bits) \
+static void mul_##bits(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, const sys_word_t *b, sys_word_t *tmp) \
+{ \
+ mul_n(ctx, r, a, b, tmp, bits/WORD_BITS); \
+} \
+static void sqr_##bits(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, sys_word_t *tmp) \
+{ \
+ sqr_n(ctx, r, a, tmp, bits/WORD_BITS); \
+}
+
+/* RSA and DSA moduli and the CRT halves of RSA moduli */
+DEFINE_KERNELS(512)
+DEFINE_KERNELS(1024)
+DEFINE_KERNELS(1536)
+DEFINE_KERNELS(2048)
+DEFINE_KERNELS(3072)
+DEFINE_KERNELS(4096)
+
+static const struct
+{
+ int bits;
+ mont_mul_func_t mul;
+ mont_sqr_func_t sqr;
+} kernels[] =
+{
+ {  512, mul_512,  sqr_512  },
+ { 1024, mul_1024, sqr_1024 },
+ { 1536, mul_1536, sqr_1536 },
+ { 2048, mul_2048, sqr_2048 },
+ { 3072, mul_3072, sqr_3072 },
+ { 4096, mul_4096, sqr_4096 }
+};
+
+static void set_kernels(mont_ctx_t *ctx)
+{
+ size_t i;
+ ctx->mul = mul_generic;
+ ctx->sqr = sqr_generic;
+ for (i = 0; i < sizeof(kernels)/sizeof(kernels[0]); i++)
+  if (kernels[i].bits == ctx->size*WORD_BITS)
+  {
+   ctx->mul = kernels[i].mul;
+   ctx->sqr = kernels[i].sqr;
+   break;
+  }
+ mont_x86_set_kernels(ctx);
+}
+
+void mont_mul(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, const sys_word_t *b, sys_word_t *tmp)
+{
+ ctx->mul(ctx, r, a, b, tmp);
+}
+
+void mont_sqr(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, sys_word_t *tmp)
+{
+ ctx->sqr(ctx, r, a, tmp);
+}
+
+static void reduce(const mont_ctx_t *ctx, sys_word_t *r, sys_word_t *t)
+{
+ reduce_n(ctx, r, t, ctx->size);
+}
+
+void mont_reduce(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, sys_word_t *tmp)
+{
+ memcpy(tmp, a, 2*ctx->size*SYS_WORD_SIZE);
+ reduce(ctx, r, tmp);
+}
+
+void mont_to(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, sys_word_t *tmp)
+{
+ mont_mul(ctx, r, a, ctx->rr, tmp);
+}
+
+void mont_from(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, sys_word_t *tmp)
+{
+ memcpy(tmp, a, ctx->size*SYS_WORD_SIZE);
+ memset(tmp + ctx->size, 0, ctx->size*SYS_WORD_SIZE);
+ reduce(ctx, r, tmp);
+}
+
+void mont_mod(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, int a_size, sys_word_t *tmp)
+{
+ int size = ctx->size;
+ int chunk = a_size % size;
+ if (!chunk) chunk = size;
+ memset(r, 0, size*SYS_WORD_SIZE);
+ /* Horner's rule on size-word digits, starting from the top one */
+ while (a_size > 0)
+ {
+  a_size -= chunk;
+  memcpy(tmp, a + a_size, chunk*SYS_WORD_SIZE);
+  memset(tmp + chunk, 0, (size - chunk)*SYS_WORD_SIZE);
+  memcpy(tmp + size, r, size*SYS_WORD_SIZE);
+  reduce(ctx, r, tmp);                 /* (r*R + digit)/R */
+  mont_mul(ctx, r, r, ctx->rr, tmp);   /* r*R + digit */
+  chunk = size;
+ }
+}
+
+void mont_sub(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, const sys_word_t *b)
+{
+ sys_word_t mask = 0 - words_sub(r, a, b, ctx->size);
+ sys_word_t carry = 0, x;
+ int i;
+ for (i = 0; i < ctx->size; i++)
+ {
+  x = r[i] + carry;
+  carry = x < carry;
+  r[i] = x + (ctx->n[i] & mask);
+  carry += r[i] < x;
+ }
+}
+
+static int get_exp_bits(const uint8_t *e, size_t e_size)
+{
+ int bits;
+ uint8_t top;
+ while (e_size && !*e)
+ {
+  e++;
+  e_size--;
+ }
+ if (!e_size) return 0;
+ bits = (int) (e_size-1)*8;
+ for (top = *e; top; top >>= 1) bits++;
+ return bits;
+}
+
+static unsigned get_exp_digit(const uint8_t *e, size_t e_size, int pos, int width)
+{
+ unsigned digit = 0;
+ int i;
+ for (i = width-1; i >= 0; i--)
+ {
+  size_t bit = pos + i;
+  digit <<= 1;
+  if (bit < e_size*8) digit |= (e[e_size-1-bit/8] >> (bit%8)) & 1;
+ }
+ return digit;
+}
+
+static int get_window_width(int bits)
+{
+ if (bits <= 32) return 1;
+ if (bits <= 512) return 4;
+ return 5;
+}
+
+/* fixed window exponentiation in the Montgomery domain, e != 0 */
+static void pow_mont(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, const uint8_t *e, size_t e_size)
+{
+ int size = ctx->size;
+ int bits = get_exp_bits(e, e_size);
+ int width, pos, i;
+ unsigned digit;
+ sys_word_t *table, *tmp;
+ assert(bits);
+ width = get_window_width(bits);
+ table = (sys_word_t *) alloca(((size_t) size << width)*SYS_WORD_SIZE);
+ tmp = (sys_word_t *) alloca(MONT_TMP_WORDS(size)*SYS_WORD_SIZE);
+ memcpy(table + size, a, size*SYS_WORD_SIZE);
+ for (i = 2; i < 1<<width; i++)
+  mont_mul(ctx, table + i*size, table + (i-1)*size, table + size, tmp);
+ pos = (bits-1)/width*width;
+ digit = get_exp_digit(e, e_size, pos, width);
+ memcpy(r, table + digit*size, size*SYS_WORD_SIZE);
+ while (pos)
+ {
+  pos -= width;
+  for (i = 0; i < width; i++)
+   ctx->sqr(ctx, r, r, tmp);
+  digit = get_exp_digit(e, e_size, pos, width);
+  if (digit) ctx->mul(ctx, r, r, table + digit*size, tmp);
+ }
+}
+
+/*
+  Precomputed powers for mont_pow_ct are stored interleaved: word j of
+  entry i is at table[j << width | i]. Every lookup reads the whole table
+  and keeps the wanted entry with a mask, so neither the addresses nor
+  the cache lines touched depend on the exponent.
+ */
+static void scatter(sys_word_t *table, const sys_word_t *a, int size, int width, unsigned index)
+{
+ int j;
+ for (j = 0; j < size; j++)
+  table[j << width | index] = a[j];
+}
+
+static void gather(sys_word_t *r, const sys_word_t *table, int size, int width, unsigned index)
+{
+ int count = 1 << width;
+ sys_word_t x, mask;
+ int i, j;
+ for (j = 0; j < size; j++)
+ {
+  x = 0;
+  for (i = 0; i < count; i++)
+  {
+   mask = ((sys_word_t) (i ^ index) - 1) >> (WORD_BITS-1);
+   x |= table[i] & (0 - mask);
+  }
+  r[j] = x;
+  table += count;
+ }
+}
+
+void mont_pow_ct(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, const void *e, size_t e_size)
+{
+ const uint8_t *ep = (const uint8_t *) e;
+ int size = ctx->size;
+ int bits = (int) e_size*8;
+ int width, pos, i;
+ unsigned digit;
+ sys_word_t *table, *x, *y, *tmp;
+ if (ctx->ifma)
+ {
+  mont_ifma_pow(ctx, r, a, ep, e_size);
+  return;
+ }
+ if (!bits)
+ {
+  memset(r, 0, size*SYS_WORD_SIZE);
+  r[0] = 1;
+  return;
+ }
+ width = get_window_width(bits);
+ table = (sys_word_t *) alloca(((size_t) size << width)*SYS_WORD_SIZE);
+ x = (sys_word_t *) alloca(2*size*SYS_WORD_SIZE);
+ y = x + size;
+ tmp = (sys_word_t *) alloca(MONT_TMP_WORDS(size)*SYS_WORD_SIZE);
+
+ /* a^0 = R mod n, a^1 = aR mod n, ... */
+ mont_from(ctx, x, ctx->rr, tmp);
+ scatter(table, x, size, width, 0);
+ mont_to(ctx, y, a, tmp);
+ scatter(table, y, size, width, 1);
+ memcpy(x, y, size*SYS_WORD_SIZE);
+ for (i = 2; i < 1<<width; i++)
+ {
+  ctx->mul(ctx, x, x, y, tmp);
+  scatter(table, x, size, width, i);
+ }
+
+ /* no shortcut for zero digits */
+ pos = (bits-1)/width*width;
+ gather(x, table, size, width, get_exp_digit(ep, e_size, pos, width));
+ while (pos)
+ {
+  pos -= width;
+  for (i = 0; i < width; i++)
+   ctx->sqr(ctx, x, x, tmp);
+  digit = get_exp_digit(ep, e_size, pos, width);
+  gather(y, table, size, width, digit);
+  ctx->mul(ctx, x, x, y, tmp);
+ }
+ mont_from(ctx, r, x, tmp);
+}
+
+void mont_pow(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, const void *e, size_t e_size)
+{
+ sys_word_t *am, *tmp;
+ int size = ctx->size;
+ int bits = get_exp_bits((const uint8_t *) e, e_size);
+ if (!bits)
+ {
+  memset(r, 0, size*SYS_WORD_SIZE);
+  r[0] = 1;
+  return;
+ }
+ /* short public exponents don't pay for the conversions */
+ if (ctx->ifma && bits > 32)
+ {
+  while (!*(const uint8_t *) e)
+  {
+   e = (const uint8_t *) e + 1;
+   e_size--;
+  }
+  mont_ifma_pow(ctx, r, a, (const uint8_t *) e, e_size);
+  return;
+ }
+ am = (sys_word_t *) alloca(size*SYS_WORD_SIZE);
+ tmp = (sys_word_t *) alloca(MONT_TMP_WORDS(size)*SYS_WORD_SIZE);
+ mont_to(ctx, am, a, tmp);
+ pow_mont(ctx, am, am, (const uint8_t *) e, e_size);
+ mont_from(ctx, r, am, tmp);
+}
+
+/* r = 2*a mod n, a < n */
+static void dbl_mod(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a)
+{
+ sys_word_t top = a[ctx->size-1] >> (WORD_BITS-1);
+ sys_word_t *t = (sys_word_t *) alloca(ctx->size*SYS_WORD_SIZE);
+ int i;
+ for (i = ctx->size-1; i > 0; i--)
+  t[i] = a[i] << 1 | a[i-1] >> (WORD_BITS-1);
+ t[0] = a[0] << 1;
+ final_sub(ctx, r, t, top);
+}
+
+int mont_set_modulus(mont_ctx_t *ctx, const void *modulus, size_t modulus_size)
+{
+ const uint8_t *p = (const uint8_t *) modulus;
+ sys_word_t inv, *n, *x;
+ int size, bits, i;
+ uint8_t e[4];
+ while (modulus_size && !*p)
+ {
+  p++;
+  modulus_size--;
+ }
+ if (!modulus_size || !(p[modulus_size-1] & 1)) return 0;
+ bits = get_exp_bits(p, modulus_size);
+ if (bits < 2) return 0;
+ size = (int) ((modulus_size + SYS_WORD_SIZE-1)/SYS_WORD_SIZE);
+ n = (sys_word_t *) malloc(2*size*SYS_WORD_SIZE);
+ if (!n) return 0;
+ mont_destroy(ctx);
+ ctx->size = size;
+ ctx->n = n;
+ ctx->rr = n + size;
+ mont_load(n, size, p, modulus_size);
+ set_kernels(ctx);
+
+ /* Newton iteration, each step doubles the number of correct bits */
+ inv = n[0];
+ for (i = 3; i < WORD_BITS; i <<= 1)
+  inv *= 2 - n[0]*inv;
+ ctx->n0 = 0 - inv;
+
+ /* 2R mod n by doubling, then R^2 = (2R)^(w*size) in the Montgomery domain */
+ x = ctx->rr;
+ memset(x, 0, size*SYS_WORD_SIZE);
+ x[(bits-1)/WORD_BITS] = (sys_word_t) 1 << (bits-1)%WORD_BITS;
+ for (i = bits-1; i <= size*WORD_BITS; i++)
+  dbl_mod(ctx, x, x);
+ i = size*WORD_BITS;
+ e[0] = (uint8_t) (i >> 24);
+ e[1] = (uint8_t) (i >> 16);
+ e[2] = (uint8_t) (i >> 8);
+ e[3] = (uint8_t) i;
+ pow_mont(ctx, x, x, e, sizeof(e));
+ mont_ifma_init(ctx);
+ return 1;
+}
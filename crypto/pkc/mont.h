@@ -0,0 +1,88 @@
+#ifndef __mont_h__
+#define __mont_h__
+
+#include <platform/word.h>
+#include <stddef.h>
+
+/*
+  Montgomery arithmetic modulo an odd number.
+  Numbers are little-endian arrays of machine words,
+  operands of mont_* functions have ctx->size words.
+ */
+
+typedef struct _mont_ctx mont_ctx_t;
+struct _mont_ifma;
+
+typedef void (*mont_mul_func_t)(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, const sys_word_t *b, sys_word_t *tmp);
+typedef void (*mont_sqr_func_t)(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, sys_word_t *tmp);
+
+struct _mont_ctx
+{
+ int size;          /* words in the modulus, 0 if not set */
+ sys_word_t n0;     /* -n^-1 mod 2^w */
+ sys_word_t *n;     /* modulus */
+ sys_word_t *rr;    /* R^2 mod n, R = 2^(w*size) */
+ mont_mul_func_t mul; /* kernels picked by the modulus width and the CPU */
+ mont_sqr_func_t sqr;
+ struct _mont_ifma *ifma; /* AVX-512 IFMA exponentiation, NULL if not used */
+};
+
+/* scratch words needed by mont_* functions */
+#define MONT_TMP_WORDS(size) (2*(size) + 2)
+
+#define MONT_MB_MAX_LANES 8
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+void mont_init(mont_ctx_t *ctx);
+int  mont_set_modulus(mont_ctx_t *ctx, const void *modulus, size_t modulus_size); /* big-endian */
+void mont_destroy(mont_ctx_t *ctx);
+
+/* big-endian bytes <-> words */
+int  mont_load(sys_word_t *r, int size, const void *data, size_t data_size);
+int  mont_store(void *data, size_t data_size, const sys_word_t *a, int size);
+
+/* r = a*b/R mod n, a*b < n*R */
+void mont_mul(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, const sys_word_t *b, sys_word_t *tmp);
+/* r = a*a/R mod n, a < n */
+void mont_sqr(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, sys_word_t *tmp);
+/* r = a/R mod n, a has 2*size words, a < n*R */
+void mont_reduce(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, sys_word_t *tmp);
+/* r = a*R mod n, any a */
+void mont_to(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, sys_word_t *tmp);
+/* r = a/R mod n, any a */
+void mont_from(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, sys_word_t *tmp);
+/* r = a mod n, a has a_size words */
+void mont_mod(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, int a_size, sys_word_t *tmp);
+/* r = a - b mod n, a < n, b < n */
+void mont_sub(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, const sys_word_t *b);
+
+/* r = a^e mod n, a and r are in the normal form, e is big-endian */
+void mont_pow(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, const void *e, size_t e_size);
+/* same for a secret e: the sequence of operations and the memory access
+   pattern depend only on e_size */
+void mont_pow_ct(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, const void *e, size_t e_size);
+
+/* multi-buffer mont_pow for a public e (mont_x86.c): r[i] = a[i]^e mod n_i,
+   ctx[0..count-1] have the same size, count <= mont_pow_mb_lanes(size);
+   mont_pow_mb_lanes returns 0 if there is no SIMD kernel for this size,
+   otherwise at most MONT_MB_MAX_LANES */
+int  mont_pow_mb_lanes(int size);
+void mont_pow_mb(const mont_ctx_t *const *ctx, sys_word_t *const *r, const sys_word_t *const *a, int count, const void *e, size_t e_size);
+
+/* r = a*b, r has size_a + size_b words and doesn't overlap a or b */
+void words_mul(sys_word_t *r, const sys_word_t *a, int size_a, const sys_word_t *b, int size_b);
+/* r = a + b, size_a >= size_b, returns carry */
+sys_word_t words_add(sys_word_t *r, const sys_word_t *a, int size_a, const sys_word_t *b, int size_b);
+/* r = a - b, returns borrow */
+sys_word_t words_sub(sys_word_t *r, const sys_word_t *a, const sys_word_t *b, int size);
+int  words_cmp(const sys_word_t *a, const sys_word_t *b, int size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,586 @@
+#include "mont_x86.h"
+#include <cpuid/cpu_features.h>
+#include <platform/umul.h>
+#include <platform/alloca.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#if defined(__GNUC__) || defined(__clang__)
+#include <immintrin.h>
+#define MONT_ADX
+#if defined(__clang__) || __GNUC__ >= 5
+#define MONT_IFMA
+#define IFMA_FUNC __attribute__((target("avx512f,avx512ifma")))
+#endif
+#elif defined(_MSC_VER)
+#include <immintrin.h>
+#define MONT_ADX
+#if _MSC_VER >= 1910 /* VS2017 */
+#define MONT_IFMA
+#define IFMA_FUNC
+#endif
+#endif
+
+#endif
+
+#ifdef MONT_ADX
+
+/* t[0..count-1] += a*b, returns the carry word; count > 0 */
+#ifdef _MSC_VER
+static sys_word_t mul_add_row(sys_word_t *t, const sys_word_t *a, int count, sys_word_t b)
+{
+ unsigned __int64 lo, hi, x, carry = 0;
+ unsigned char c1 = 0, c2 = 0;
+ int j;
+ for (j = 0; j < count; j++)
+ {
+  lo = _mulx_u64(a[j], b, &hi);
+  c1 = _addcarryx_u64(c1, lo, t[j], &x);
+  c2 = _addcarryx_u64(c2, x, carry, &x);
+  t[j] = x;
+  carry = hi;
+ }
+ _addcarryx_u64(c1, carry, 0, &carry);
+ _addcarryx_u64(c2, carry, 0, &carry);
+ return carry;
+}
+#else
+/* the low halves go through CF (adcx), the high halves through OF (adox);
+   lea, mov and jrcxz leave both flags alone */
+#define ROW_STEP(offset) \
+  "mulx " offset "(%[a]), %[lo], %[hi]\n\t" \
+  "adcx " offset "(%[t]), %[lo]\n\t" \
+  "adox %[carry], %[lo]\n\t" \
+  "mov %[lo], " offset "(%[t])\n\t" \
+  "mov %[hi], %[carry]\n\t"
+
+static sys_word_t mul_add_row(sys_word_t *t, const sys_word_t *a, int count, sys_word_t b)
+{
+ sys_word_t lo, hi, carry;
+ size_t n = count & 3, blocks = count >> 2;
+ __asm__ __volatile__(
+  "xor %k[carry], %k[carry]\n\t"
+  "jrcxz 2f\n"
+  "1:\n\t"
+  ROW_STEP("0")
+  "lea 8(%[a]), %[a]\n\t"
+  "lea 8(%[t]), %[t]\n\t"
+  "lea -1(%[n]), %[n]\n\t"
+  "jrcxz 2f\n\t"
+  "jmp 1b\n"
+  "2:\n\t"
+  "mov %[blocks], %[n]\n\t"
+  "jrcxz 4f\n"
+  "3:\n\t"
+  ROW_STEP("0")
+  ROW_STEP("8")
+  ROW_STEP("16")
+  ROW_STEP("24")
+  "lea 32(%[a]), %[a]\n\t"
+  "lea 32(%[t]), %[t]\n\t"
+  "lea -1(%[n]), %[n]\n\t"
+  "jrcxz 4f\n\t"
+  "jmp 3b\n"
+  "4:\n\t"
+  "mov $0, %k[lo]\n\t"
+  "adcx %[lo], %[carry]\n\t"
+  "adox %[lo], %[carry]\n\t"
+  : [t] "+r"(t), [a] "+r"(a), [n] "+c"(n), [lo] "=&r"(lo), [hi] "=&r"(hi), [carry] "=&r"(carry)
+  : "d"(b), [blocks] "r"(blocks)
+  : "cc", "memory");
+ return carry;
+}
+#endif
+
+/* r = t - n if t >= n, else r = t */
+static void final_sub(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *t, sys_word_t top)
+{
+ sys_word_t borrow = words_sub(r, t, ctx->n, ctx->size);
+ sys_word_t mask = 0 - (borrow & (top ^ 1));
+ int i;
+ for (i = 0; i < ctx->size; i++)
+  r[i] = (t[i] & mask) | (r[i] & ~mask);
+}
+
+/* t has 2*size words and is destroyed */
+static void reduce_adx(const mont_ctx_t *ctx, sys_word_t *r, sys_word_t *t)
+{
+ int size = ctx->size;
+ sys_word_t carry, top = 0, x;
+ int i;
+ for (i = 0; i < size; i++)
+ {
+  carry = mul_add_row(t + i, ctx->n, size, t[i]*ctx->n0);
+  x = t[i+size] + carry;
+  carry = x < carry;
+  x += top;
+  top = carry + (x < top);
+  t[i+size] = x;
+ }
+ final_sub(ctx, r, t + size, top);
+}
+
+/* product first, then the reduction */
+static void mul_adx(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, const sys_word_t *b, sys_word_t *tmp)
+{
+ int size = ctx->size;
+ int i;
+ memset(tmp, 0, size*SYS_WORD_SIZE);
+ for (i = 0; i < size; i++)
+  tmp[i+size] = mul_add_row(tmp + i, a, size, b[i]);
+ reduce_adx(ctx, r, tmp);
+}
+
+static void sqr_adx(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, sys_word_t *t)
+{
+ int size = ctx->size;
+ sys_word_t carry, lo, hi, x, y, top;
+ int i;
+ memset(t, 0, 2*size*SYS_WORD_SIZE);
+ for (i = 0; i < size-1; i++)
+  t[i+size] = mul_add_row(t + 2*i + 1, a + i + 1, size-i-1, a[i]);
+ carry = top = 0;
+ for (i = 0; i < size; i++)
+ {
+  lo = umulw(&hi, a[i], a[i]);
+  x = t[2*i] << 1 | top;
+  y = t[2*i+1] << 1 | t[2*i] >> 63;
+  top = t[2*i+1] >> 63;
+  x += carry;
+  carry = x < carry;
+  x += lo;
+  carry += x < lo;
+  y += carry;
+  carry = y < carry;
+  y += hi;
+  carry += y < hi;
+  t[2*i] = x;
+  t[2*i+1] = y;
+ }
+ reduce_adx(ctx, r, t);
+}
+
+int mont_x86_set_kernels(mont_ctx_t *ctx)
+{
+ uint32_t need = CPU_FEAT_BMI2 | CPU_FEAT_ADX;
+ if ((get_cpu_features() & need) != need) return 0;
+ ctx->mul = mul_adx;
+ ctx->sqr = sqr_adx;
+ return 1;
+}
+
+#else
+
+int mont_x86_set_kernels(mont_ctx_t *ctx)
+{
+ return 0;
+}
+
+#endif /* MONT_ADX */
+
+#ifdef MONT_IFMA
+
+/*
+  AVX-512 IFMA exponentiation. Numbers are kept in 52-bit limbs, 8 limbs
+  per vector, with their own Montgomery radix R = 2^(52*size). The
+  multiplication is "almost Montgomery": results are below 2n rather
+  than n, which is enough for the next multiplication since R > 4n.
+ */
+
+#define MASK52 (((uint64_t) 1 << 52) - 1)
+#define IFMA_MAX_VECTORS 10 /* 4096-bit moduli */
+
+struct _mont_ifma
+{
+ int size;      /* limbs, a multiple of 8 */
+ uint64_t n0;   /* -n^-1 mod 2^52 */
+ uint64_t *n;
+ uint64_t *rr;  /* R^2 mod n */
+};
+
+static unsigned get_exp_digit(const uint8_t *e, size_t e_size, int pos, int width)
+{
+ unsigned digit = 0;
+ int i;
+ for (i = width-1; i >= 0; i--)
+ {
+  size_t bit = pos + i;
+  digit <<= 1;
+  if (bit < e_size*8) digit |= (e[e_size-1-bit/8] >> (bit%8)) & 1;
+ }
+ return digit;
+}
+
+static void to_limbs(uint64_t *r, int count, const sys_word_t *a, int size)
+{
+ int i, word, shift;
+ uint64_t x;
+ for (i = 0; i < count; i++)
+ {
+  word = 52*i >> 6;
+  shift = 52*i & 63;
+  x = 0;
+  if (word < size)
+  {
+   x = a[word] >> shift;
+   if (shift > 12 && word+1 < size) x |= a[word+1] << (64-shift);
+  }
+  r[i] = x & MASK52;
+ }
+}
+
+static void from_limbs(sys_word_t *r, int size, const uint64_t *a, int count)
+{
+ int i, word, shift;
+ memset(r, 0, size*SYS_WORD_SIZE);
+ for (i = 0; i < count; i++)
+ {
+  word = 52*i >> 6;
+  shift = 52*i & 63;
+  if (word < size) r[word] |= a[i] << shift;
+  if (shift > 12 && word+1 < size) r[word+1] |= a[i] >> (64-shift);
+ }
+}
+
+/* r = a*b/R mod 2n, a < 2n, b < 2n */
+static IFMA_FUNC void amm(const struct _mont_ifma *m, uint64_t *r, const uint64_t *a, const uint64_t *b)
+{
+ __m512i acc[IFMA_MAX_VECTORS], bi, mi, zero = _mm512_setzero_si512();
+ uint64_t x, t, carry;
+ int vectors = m->size >> 3;
+ int i, k;
+ for (k = 0; k < vectors; k++) acc[k] = zero;
+ for (i = 0; i < m->size; i++)
+ {
+  bi = _mm512_set1_epi64((long long) b[i]);
+  for (k = 0; k < vectors; k++)
+   acc[k] = _mm512_madd52lo_epu64(acc[k], _mm512_loadu_si512(a + 8*k), bi);
+  x = (uint64_t) _mm_cvtsi128_si64(_mm512_castsi512_si128(acc[0]));
+  t = (x * m->n0) & MASK52;
+  mi = _mm512_set1_epi64((long long) t);
+  for (k = 0; k < vectors; k++)
+   acc[k] = _mm512_madd52lo_epu64(acc[k], _mm512_loadu_si512(m->n + 8*k), mi);
+  /* the low limb is now divisible by 2^52: drop it, keep its carry */
+  carry = (x + ((t * m->n[0]) & MASK52)) >> 52;
+  for (k = 0; k < vectors-1; k++)
+   acc[k] = _mm512_alignr_epi64(acc[k+1], acc[k], 1);
+  acc[vectors-1] = _mm512_alignr_epi64(zero, acc[vectors-1], 1);
+  acc[0] = _mm512_add_epi64(acc[0], _mm512_maskz_set1_epi64(1, (long long) carry));
+  for (k = 0; k < vectors; k++)
+  {
+   acc[k] = _mm512_madd52hi_epu64(acc[k], _mm512_loadu_si512(a + 8*k), bi);
+   acc[k] = _mm512_madd52hi_epu64(acc[k], _mm512_loadu_si512(m->n + 8*k), mi);
+  }
+ }
+ for (k = 0; k < vectors; k++)
+  _mm512_storeu_si512(r + 8*k, acc[k]);
+ carry = 0;
+ for (i = 0; i < m->size; i++)
+ {
+  x = r[i] + carry;
+  r[i] = x & MASK52;
+  carry = x >> 52;
+ }
+}
+
+/* reads every entry of the table, keeps the one at index */
+static IFMA_FUNC void gather(uint64_t *r, const uint64_t *table, int size, int entries, unsigned index)
+{
+ __m512i acc[IFMA_MAX_VECTORS], idx = _mm512_set1_epi64(index);
+ __mmask8 sel;
+ int vectors = size >> 3;
+ int i, k;
+ for (k = 0; k < vectors; k++) acc[k] = _mm512_setzero_si512();
+ for (i = 0; i < entries; i++)
+ {
+  sel = _mm512_cmpeq_epi64_mask(_mm512_set1_epi64(i), idx);
+  for (k = 0; k < vectors; k++)
+   acc[k] = _mm512_mask_mov_epi64(acc[k], sel, _mm512_loadu_si512(table + 8*k));
+  table += size;
+ }
+ for (k = 0; k < vectors; k++)
+  _mm512_storeu_si512(r + 8*k, acc[k]);
+}
+
+int mont_ifma_init(mont_ctx_t *ctx)
+{
+ uint32_t need = CPU_FEAT_AVX512F | CPU_FEAT_AVX512IFMA;
+ struct _mont_ifma *m;
+ sys_word_t *two;
+ int size = ctx->size;
+ int count;
+ uint8_t e[2];
+ if ((get_cpu_features() & need) != need) return 0;
+ /* below 2048 bits the scalar part of the loop dominates and the
+    ADX kernels are faster */
+ if (size < 2048/64 || size > 4096/64) return 0;
+ /* R > 4n */
+ count = ((size*64 + 2 + 51)/52 + 7) & ~7;
+ m = (struct _mont_ifma *) malloc(sizeof(*m) + 2*count*sizeof(uint64_t));
+ if (!m) return 0;
+ m->size = count;
+ m->n = (uint64_t *) (m + 1);
+ m->rr = m->n + count;
+ m->n0 = ctx->n0 & MASK52;
+ to_limbs(m->n, count, ctx->n, size);
+
+ /* R^2 mod n = 2^(104*count) mod n */
+ two = (sys_word_t *) alloca(2*size*SYS_WORD_SIZE);
+ memset(two, 0, size*SYS_WORD_SIZE);
+ two[0] = 2;
+ e[0] = (uint8_t) (104*count >> 8);
+ e[1] = (uint8_t) (104*count);
+ mont_pow(ctx, two + size, two, e, sizeof(e));
+ to_limbs(m->rr, count, two + size, size);
+ ctx->ifma = m;
+ return 1;
+}
+
+void mont_ifma_destroy(mont_ctx_t *ctx)
+{
+ free(ctx->ifma);
+ ctx->ifma = NULL;
+}
+
+IFMA_FUNC void mont_ifma_pow(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, const uint8_t *e, size_t e_size)
+{
+ const struct _mont_ifma *m = ctx->ifma;
+ int size = ctx->size;
+ int count = m->size;
+ int bits = (int) e_size*8;
+ int width, pos, i;
+ uint64_t *table, *x, *y;
+ sys_word_t *t, *tmp, mask;
+ t = (sys_word_t *) alloca(size*SYS_WORD_SIZE);
+ tmp = (sys_word_t *) alloca(MONT_TMP_WORDS(size)*SYS_WORD_SIZE);
+ if (!bits)
+ {
+  memset(r, 0, size*SYS_WORD_SIZE);
+  r[0] = 1;
+  return;
+ }
+ if (bits <= 32) width = 1; else
+ if (bits <= 512) width = 4; else width = 5;
+ table = (uint64_t *) alloca(((size_t) count << width)*sizeof(uint64_t));
+ x = (uint64_t *) alloca(2*count*sizeof(uint64_t));
+ y = x + count;
+
+ /* y = aR mod 2n, table[i] = a^i*R mod 2n */
+ mont_to(ctx, t, a, tmp);
+ mont_from(ctx, t, t, tmp);
+ to_limbs(y, count, t, size);
+ amm(m, y, y, m->rr);
+ memset(x, 0, count*sizeof(uint64_t));
+ x[0] = 1;
+ amm(m, table, m->rr, x);
+ memcpy(table + count, y, count*sizeof(uint64_t));
+ for (i = 2; i < 1<<width; i++)
+  amm(m, table + i*count, table + (i-1)*count, y);
+
+ pos = (bits-1)/width*width;
+ gather(x, table, count, 1<<width, get_exp_digit(e, e_size, pos, width));
+ while (pos)
+ {
+  pos -= width;
+  for (i = 0; i < width; i++)
+   amm(m, x, x, x);
+  gather(y, table, count, 1<<width, get_exp_digit(e, e_size, pos, width));
+  amm(m, x, x, y);
+ }
+
+ /* out of the Montgomery domain; the result is at most n here */
+ memset(y, 0, count*sizeof(uint64_t));
+ y[0] = 1;
+ amm(m, x, x, y);
+ from_limbs(t, size, x, count);
+ mask = 0 - words_sub(r, t, ctx->n, size);
+ for (i = 0; i < size; i++)
+  r[i] = (t[i] & mask) | (r[i] & ~mask);
+}
+
+/*
+  Multi-buffer exponentiation: lane k of every vector belongs to the k-th
+  modulus, so one instruction advances 8 independent multiplications and
+  the per-limb multiplier comes from a vector instead of a scalar chain.
+  A number is stored limb-major: limb j of lane k is at [8*j + k].
+ */
+
+#define MB_LANES MONT_MB_MAX_LANES
+
+struct mont_mb
+{
+ int size;      /* limbs */
+ uint64_t *n;
+ uint64_t *n0;  /* -n^-1 mod 2^52 for every lane */
+ uint64_t *acc; /* 2*size+1 limbs */
+};
+
+/* r = a*b/R mod 2n in every lane, a < 2n, b < 2n; the high halves of
+   the products go one limb up, a limb collects at most 4*(size+1) halves */
+static IFMA_FUNC void amm_mb(const struct mont_mb *m, uint64_t *r, const uint64_t *a, const uint64_t *b)
+{
+ const __m512i mask = _mm512_set1_epi64(MASK52);
+ const __m512i n0 = _mm512_loadu_si512(m->n0);
+ const __m512i zero = _mm512_setzero_si512();
+ __m512i bi, mi, x, hi, aj, nj;
+ uint64_t *acc = m->acc, *p;
+ int size = m->size;
+ int i, j;
+ memset(acc, 0, (2*size+1)*MB_LANES*sizeof(uint64_t));
+ for (i = 0; i < size; i++)
+ {
+  p = acc + MB_LANES*i;
+  bi = _mm512_loadu_si512(b + MB_LANES*i);
+  x = _mm512_madd52lo_epu64(_mm512_loadu_si512(p), _mm512_loadu_si512(a), bi);
+  mi = _mm512_madd52lo_epu64(zero, x, n0);
+  hi = zero;
+  for (j = 0; j < size; j++)
+  {
+   aj = _mm512_loadu_si512(a + MB_LANES*j);
+   nj = _mm512_loadu_si512(m->n + MB_LANES*j);
+   x = _mm512_add_epi64(_mm512_loadu_si512(p + MB_LANES*j), hi);
+   x = _mm512_madd52lo_epu64(x, aj, bi);
+   x = _mm512_madd52lo_epu64(x, nj, mi);
+   _mm512_storeu_si512(p + MB_LANES*j, x);
+   hi = _mm512_madd52hi_epu64(_mm512_madd52hi_epu64(zero, aj, bi), nj, mi);
+  }
+  p += MB_LANES*size;
+  _mm512_storeu_si512(p, _mm512_add_epi64(_mm512_loadu_si512(p), hi));
+  /* the low limb is now divisible by 2^52 */
+  p = acc + MB_LANES*i;
+  x = _mm512_srli_epi64(_mm512_loadu_si512(p), 52);
+  _mm512_storeu_si512(p + MB_LANES, _mm512_add_epi64(_mm512_loadu_si512(p + MB_LANES), x));
+ }
+ hi = zero;
+ for (j = 0; j < size; j++)
+ {
+  x = _mm512_add_epi64(_mm512_loadu_si512(acc + MB_LANES*(size+j)), hi);
+  _mm512_storeu_si512(r + MB_LANES*j, _mm512_and_si512(x, mask));
+  hi = _mm512_srli_epi64(x, 52);
+ }
+}
+
+/* limbs of lane k <-> words, t has size limbs */
+static void mb_load(uint64_t *r, int lane, const sys_word_t *a, int words, uint64_t *t, int size)
+{
+ int i;
+ to_limbs(t, size, a, words);
+ for (i = 0; i < size; i++) r[MB_LANES*i + lane] = t[i];
+}
+
+static void mb_store(sys_word_t *r, int words, const uint64_t *a, int lane, uint64_t *t, int size)
+{
+ int i;
+ for (i = 0; i < size; i++) t[i] = a[MB_LANES*i + lane];
+ from_limbs(r, words, t, size);
+}
+
+int mont_pow_mb_lanes(int size)
+{
+ uint32_t need = CPU_FEAT_AVX512F | CPU_FEAT_AVX512IFMA;
+ if ((get_cpu_features() & need) != need) return 0;
+ if (size < 1024/64 || size > 4096/64) return 0;
+ return MB_LANES;
+}
+
+void mont_pow_mb(const mont_ctx_t *const *ctx, sys_word_t *const *r, const sys_word_t *const *a, int count, const void *e, size_t e_size)
+{
+ const uint8_t *ep = (const uint8_t *) e;
+ const mont_ctx_t *c;
+ struct mont_mb m;
+ int size = ctx[0]->size;
+ int lane, i, d;
+ uint64_t *x, *y, *t;
+ sys_word_t *w, *tmp;
+ assert(count > 0 && count <= mont_pow_mb_lanes(size));
+ while (e_size && !*ep) { ep++; e_size--; }
+ if (!e_size)
+ {
+  for (lane = 0; lane < count; lane++)
+  {
+   memset(r[lane], 0, size*SYS_WORD_SIZE);
+   r[lane][0] = 1;
+  }
+  return;
+ }
+ /* R > 4n */
+ m.size = (size*64 + 2 + 51)/52;
+ m.n = (uint64_t *) alloca(((5*m.size + 2)*MB_LANES + m.size)*sizeof(uint64_t));
+ m.n0 = m.n + MB_LANES*m.size;
+ m.acc = m.n0 + MB_LANES;
+ x = m.acc + MB_LANES*(2*m.size + 1);
+ y = x + MB_LANES*m.size;
+ t = y + MB_LANES*m.size;
+ w = (sys_word_t *) alloca((size + MONT_TMP_WORDS(size))*SYS_WORD_SIZE);
+ tmp = w + size;
+
+ /* unused lanes repeat the first one; y = R^2 mod n = 2^d*R'^2 mod n,
+    R' = 2^(64*size) is the radix of ctx */
+ d = 2*(52*m.size - 64*size);
+ for (lane = 0; lane < MB_LANES; lane++)
+ {
+  c = ctx[lane < count? lane : 0];
+  assert(c->size == size);
+  mb_load(m.n, lane, c->n, size, t, m.size);
+  m.n0[lane] = c->n0 & MASK52;
+  memset(w, 0, size*SYS_WORD_SIZE);
+  w[d >> 6] = (sys_word_t) 1 << (d & 63);
+  mont_mul(c, w, w, c->rr, tmp);
+  mont_mul(c, w, w, c->rr, tmp);
+  mb_load(y, lane, w, size, t, m.size);
+  mb_load(x, lane, a[lane < count? lane : 0], size, t, m.size);
+ }
+
+ /* y = aR mod 2n, then left-to-right square and multiply */
+ amm_mb(&m, y, x, y);
+ memcpy(x, y, MB_LANES*m.size*sizeof(uint64_t));
+ for (i = 7; !(ep[0] >> i & 1); i--);
+ i += (int) (e_size-1)*8;
+ while (i--)
+ {
+  amm_mb(&m, x, x, x);
+  if (ep[e_size-1-i/8] >> (i%8) & 1) amm_mb(&m, x, x, y);
+ }
+
+ /* out of the Montgomery domain; the result is at most n here */
+ memset(y, 0, MB_LANES*m.size*sizeof(uint64_t));
+ for (lane = 0; lane < MB_LANES; lane++) y[lane] = 1;
+ amm_mb(&m, x, x, y);
+ for (lane = 0; lane < count; lane++)
+ {
+  mb_store(w, size, x, lane, t, m.size);
+  if (words_sub(r[lane], w, ctx[lane]->n, size))
+   memcpy(r[lane], w, size*SYS_WORD_SIZE);
+ }
+}
+
+#else
+
+int mont_ifma_init(mont_ctx_t *ctx)
+{
+ return 0;
+}
+
+void mont_ifma_destroy(mont_ctx_t *ctx)
+{
+}
+
+void mont_ifma_pow(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, const uint8_t *e, size_t e_size)
+{
+ assert(0);
+}
+
+int mont_pow_mb_lanes(int size)
+{
+ return 0;
+}
+
+void mont_pow_mb(const mont_ctx_t *const *ctx, sys_word_t *const *r, const sys_word_t *const *a, int count, const void *e, size_t e_size)
+{
+ assert(0);
+}
+
+#endif /* MONT_IFMA */
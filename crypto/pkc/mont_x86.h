@@ -0,0 +1,29 @@
+#ifndef __mont_x86_h__
+#define __mont_x86_h__
+
+#include "mont.h"
+
+/*
+  Montgomery kernels for x86-64 extensions, used by mont.c.
+  They are picked at run time with get_cpu_features().
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* replaces ctx->mul and ctx->sqr with BMI2/ADX kernels; returns 0 if not supported */
+int  mont_x86_set_kernels(mont_ctx_t *ctx);
+
+/* allocates ctx->ifma if AVX-512 IFMA can be used for this modulus */
+int  mont_ifma_init(mont_ctx_t *ctx);
+void mont_ifma_destroy(mont_ctx_t *ctx);
+/* r = a^e mod n with ctx->ifma; all e_size*8 bits of e are processed */
+void mont_ifma_pow(const mont_ctx_t *ctx, sys_word_t *r, const sys_word_t *a, const uint8_t *e, size_t e_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -47,6 +47,13 @@ pkc_dsa::pkc_dsa()
  y.clear();
  x.clear();
  ytemp = nullptr;
+ mont_init(&mont_p);
+}
+
+pkc_dsa::~pkc_dsa()
+{
+ operator delete(ytemp);
+ mont_destroy(&mont_p);
 }
 
 int pkc_dsa::get_id() const
@@ -76,6 +83,27 @@ bool pkc_dsa::check_bit_len(int pbits, int qbits)
  return false;
 }
 
+// r = base^e mod p, e has at most e_size bytes
+static void power_mod(bigint_t r, const mont_ctx_t *ctx, pkc_base::data_buffer base,
+                      const bigint_t e, size_t e_size, bool secret)
+{
+ int size = ctx->size;
+ size_t word_bytes = size*sizeof(sys_word_t);
+ uint8_t *buf = static_cast<uint8_t*>(alloca(word_bytes > e_size? word_bytes : e_size));
+ sys_word_t *x = static_cast<sys_word_t*>(alloca(word_bytes));
+ mont_load(x, size, base.data, base.size);
+ size_t e_bytes = bigint_get_byte_count(e);
+ assert(e_bytes <= e_size);
+ memset(buf, 0, e_size - e_bytes);
+ if (e_bytes) bigint_get_bytes_be(e, buf + e_size - e_bytes, e_bytes);
+ if (secret)
+  mont_pow_ct(ctx, x, x, buf, e_size);
+ else
+  mont_pow(ctx, x, x, buf, e_size);
+ mont_store(buf, word_bytes, x, size);
+ bigint_set_bytes_be(r, buf, word_bytes);
+}
+
 bool pkc_dsa::get_params(const asn1::element* &el, pkc_base::data_buffer &res_p, pkc_base::data_buffer &res_q, pkc_base::data_buffer &res_g)
 {
  if (!(el && el->is_valid_positive_int())) return false; 
@@ -105,7 +133,7 @@ bool pkc_dsa::set_public_key(const void *data, size_t size, const asn1::element
  if (el_pub && !el_pub->sibling && el_pub->is_valid_positive_int())
  {
   get_integer(res_y, el_pub);
-  if (is_less(res_y, res_p))
+  if (is_less(res_y, res_p) && mont_set_modulus(&mont_p, res_p.data, res_p.size))
   {
    result = true;
    p = res_p;
@@ -142,6 +170,7 @@ bool pkc_dsa::set_private_key(const void *data, size_t size, const asn1::element
   if (!(el && el->is_valid_positive_int())) goto fin;
   get_integer(res_x, el);
   if (!is_less(res_x, res_q)) goto fin;
+  if (!mont_set_modulus(&mont_p, res_p.data, res_p.size)) goto fin;
   result = true;
   p = res_p;
   g = res_g;
@@ -157,25 +186,22 @@ bool pkc_dsa::set_private_key(const void *data, size_t size, const asn1::element
   if (!get_params(el, res_p, res_q, res_g)) goto fin;
   get_integer(res_x, root);
   if (!is_less(res_x, res_q)) goto fin;
+  if (!mont_set_modulus(&mont_p, res_p.data, res_p.size)) goto fin;
   result = true;
   p = res_p;
   g = res_g;
   q = res_q;
   x = res_x; 
   // calculate public key
-  bigint_t pv = bigint_create_bytes_be(res_p.data, res_p.size);
   bigint_t xv = bigint_create_bytes_be(res_x.data, res_x.size);
-  bigint_t gv = bigint_create_bytes_be(res_g.data, res_g.size);
   bigint_t yv = bigint_create(0);
-  bigint_mpow(yv, gv, xv, pv);
+  power_mod(yv, &mont_p, res_g, xv, res_q.size, true);
   operator delete(ytemp);
   size_t out_size = bigint_get_byte_count(yv);
   ytemp = static_cast<uint8_t*>(operator new(out_size));
   bigint_get_bytes_be(yv, ytemp, out_size);
   bigint_destroy(yv);
-  bigint_destroy(gv);
   bigint_destroy(xv);
-  bigint_destroy(pv);
   y.data = ytemp;
   y.size = out_size;
  }
@@ -256,9 +282,7 @@ bool pkc_dsa::create_signature(void *out, size_t &out_size,
  bigint_t t1 = bigint_create(0);
  bigint_t t2 = bigint_create(0);
  bigint_t xv = bigint_create_bytes_be(x.data, x.size);
- bigint_t pv = bigint_create_bytes_be(p.data, p.size);
  bigint_t qv = bigint_create_bytes_be(q.data, q.size);
- bigint_t gv = bigint_create_bytes_be(g.data, g.size);
  #ifdef BROKEN_HASH_TRUNCATION
  int shift = hd->hash_size - static_cast<int>(q.size);
  if (shift > 0) bigint_rshift(h, h, shift<<3);
@@ -285,7 +309,7 @@ bool pkc_dsa::create_signature(void *out, size_t &out_size,
    bigint_set_bytes_be(k, kbuf, q.size);
    if (bigint_eq_word(k, 0)) continue;
   }
-  bigint_mpow(t1, gv, k, pv);
+  power_mod(t1, &mont_p, g, k, q.size, true);
   bigint_mod(r, t1, qv);
   if (bigint_eq_word(r, 0))
   {
@@ -305,9 +329,7 @@ bool pkc_dsa::create_signature(void *out, size_t &out_size,
  }
 
  free(ctx_hmac);
- bigint_destroy(gv);
  bigint_destroy(qv);
- bigint_destroy(pv);
  bigint_destroy(xv);
  bigint_destroy(t2);
  bigint_destroy(t1);
@@ -526,14 +548,13 @@ bool pkc_dsa::verify_signature(const void *sig, size_t sig_size,
 
 bool pkc_dsa::verify_signature(data_buffer r_buf, data_buffer s_buf, const void *digest, size_t digest_size) const
 {
+ if (!mont_p.size) return false;
  if (!(is_less(r_buf, q) && is_less(s_buf, q))) return false;
  bigint_t h = bigint_create_bytes_be(digest, digest_size);
  bigint_t r = bigint_create_bytes_be(r_buf.data, r_buf.size);
  bigint_t s = bigint_create_bytes_be(s_buf.data, s_buf.size);
  bigint_t pv = bigint_create_bytes_be(p.data, p.size);
  bigint_t qv = bigint_create_bytes_be(q.data, q.size);
- bigint_t gv = bigint_create_bytes_be(g.data, g.size);
- bigint_t yv = bigint_create_bytes_be(y.data, y.size);
  bigint_t w = bigint_create(0);
  bigint_t t1 = bigint_create(0);
  bigint_t t2 = bigint_create(0);
@@ -551,8 +572,8 @@ bool pkc_dsa::verify_signature(data_buffer r_buf, data_buffer s_buf, const void
  {
   bigint_mmul(t1, h, w, qv);
   bigint_mmul(t2, r, w, qv);
-  bigint_mpow(t1, gv, t1, pv);
-  bigint_mpow(t2, yv, t2, pv);
+  power_mod(t1, &mont_p, g, t1, q.size, false);
+  power_mod(t2, &mont_p, y, t2, q.size, false);
   bigint_mmul(t1, t1, t2, pv);
   bigint_mod(t1, t1, qv);
   result = bigint_cmp(t1, r) == 0;
@@ -560,8 +581,6 @@ bool pkc_dsa::verify_signature(data_buffer r_buf, data_buffer s_buf, const void
  bigint_destroy(t2);
  bigint_destroy(t1);
  bigint_destroy(w);
- bigint_destroy(yv);
- bigint_destroy(gv);
  bigint_destroy(qv);
  bigint_destroy(pv);
  bigint_destroy(s);
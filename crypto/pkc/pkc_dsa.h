@@ -2,6 +2,7 @@
 #define __pkc_dsa_h__
 
 #include "pkc_base.h"
+#include "mont.h"
 
 class pkc_dsa : public pkc_base
 {
@@ -13,7 +14,7 @@ class pkc_dsa : public pkc_base
   };
   
   pkc_dsa();
-  virtual ~pkc_dsa() { operator delete(ytemp); }
+  virtual ~pkc_dsa();
   virtual int  get_id() const;
   virtual bool set_public_key(const void *data, size_t size, const asn1::element *param);
   virtual bool set_private_key(const void *data, size_t size, const asn1::element *param);
@@ -38,6 +39,7 @@ class pkc_dsa : public pkc_base
  private:
   data_buffer p, g, q, y, x;
   uint8_t *ytemp;
+  mont_ctx_t mont_p;
 
   bool get_params(const asn1::element* &el, data_buffer &res_p, data_buffer &res_q, data_buffer &res_g);
   bool verify_signature(data_buffer r_buf, data_buffer s_buf, const void *digest, size_t digest_size) const;
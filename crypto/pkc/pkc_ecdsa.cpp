@@ -4,6 +4,7 @@
 #include <crypto/asn1/decoder.h>
 #include <crypto/asn1/encoder.h>
 #include <crypto/ec/curves_wei.h>
+#include <crypto/ec/ec_p256.h>
 #include <crypto/oid_const.h>
 #include <crypto/oid_search.h>
 #include <crypto/utils/random_range.h>
@@ -12,26 +13,41 @@
 
 #ifdef CRYPTO_EC_PROJECTIVE
 #include <crypto/ec/ec_weip.h>
+#include <crypto/ec/ec_weij.h> // fixed tables
 #define ec_point_mul       ec_weip_point_mul
+#define ec_point_mul2      ec_weip_point_mul2
 #define ec_point_add       ec_weip_point_add
 #define ec_point_dbl       ec_weip_point_dbl
 #define ec_point_affine_xy ec_weip_point_affine_xy
 #define ec_point_affine_x  ec_weip_point_affine_x
 #define ec_point_normalize ec_weip_point_normalize
+#define ec_point_mul_fixed ec_weip_point_mul_fixed
+#define ec_point_mul_glv   ec_weip_point_mul_glv
+#define ec_point_mul_ladder ec_weip_point_mul_ladder
+#define ec_points_normalize ec_weip_points_normalize
+#define EC_POINT_JACOBIAN  false
 #else
 #include <crypto/ec/ec_weij.h>
 #define ec_point_mul       ec_weij_point_mul
+#define ec_point_mul2      ec_weij_point_mul2
 #define ec_point_add       ec_weij_point_add
 #define ec_point_dbl       ec_weij_point_dbl
 #define ec_point_affine_xy ec_weij_point_affine_xy
 #define ec_point_affine_x  ec_weij_point_affine_x
 #define ec_point_normalize ec_weij_point_normalize
+#define ec_point_mul_fixed ec_weij_point_mul_fixed
+#define ec_point_mul_glv   ec_weij_point_mul_glv
+#define ec_point_mul_ladder ec_weij_point_mul_ladder
+#define ec_points_normalize ec_weij_points_normalize
+#define EC_POINT_JACOBIAN  true
 #endif
 
 using namespace oid;
 
 #define countof(a) (sizeof(a)/sizeof(a[0]))
 
+static const int PUB_TABLE_WINDOW = 5;
+
 static const uint16_t ecdsa_oid_pairs[] =
 {
  ID_SIGN_ECDSA_SHA1,     ID_HASH_SHA1,
@@ -50,9 +66,10 @@ static inline void init_point(ec_point_t &pt)
  pt.x = pt.y = pt.z = nullptr;
 }
 
-static bool get_point(ec_point_t &pt, const uint8_t *data, size_t size, const ec_wei_def_t *def)
+static bool get_point(ec_point_t &pt, const uint8_t *data, size_t size, const curve_context *ctx)
 {
  if (!size) return false;
+ const ec_wei_def_t *def = &ctx->def;
  size_t coord_size = bigint_get_byte_count(def->p);
  if (data[0] == 4)
  {
@@ -65,35 +82,57 @@ static bool get_point(ec_point_t &pt, const uint8_t *data, size_t size, const ec
  if (data[0] == 2 || data[0] == 3)
  {
   if (size != coord_size + 1) return false;
-  if ((bigint_get_ls_word(def->p) & 3) != 3) return false;
-  pt.x = bigint_create_bytes_be(data + 1, coord_size);
-  pt.y = bigint_create(0);
+  bigint_t x = bigint_create_bytes_be(data + 1, coord_size);
+  bigint_t y = bigint_create(0);
+  bool result;
+  if (ctx->params->id == ID_SECP256R1)
+  {
+   result = ec_p256_point_decompress(y, x, data[0]-2) != 0;
+  } else
+  {
+   // y^2 = x^3 + a*x + b
+   wei_scratch scratch(ctx);
+   ec_scratch_t *s = scratch.get();
+   bigint_t t = bigint_create(0);
+   result = bigint_cmp(x, def->p) < 0;
+   if (result)
+   {
+    bigint_mmul(s->v[0], x, x, def->p);
+    bigint_add(s->v[0], s->v[0], def->a);
+    bigint_mmul(t, s->v[0], x, def->p);
+    bigint_madd(t, t, def->b, def->p);
+    result = ec_wei_sqrt(y, t, &ctx->sqrt, def, s) != 0;
+   }
+   if (result && (int) (bigint_get_ls_word(y) & 1) != data[0]-2)
+   {
+    result = !bigint_eq_word(y, 0);
+    bigint_sub(y, def->p, y);
+   }
+   bigint_destroy(t);
+  }
+  if (!result)
+  {
+   bigint_destroy(y);
+   bigint_destroy(x);
+   return false;
+  }
+  pt.x = x;
+  pt.y = y;
   pt.z = bigint_create_word(1);
-  bigint_t t1 = bigint_create(0);
-  bigint_t t2 = bigint_create(0);
-  bigint_mmul(t1, pt.x, pt.x, def->p);
-  bigint_mmul(t2, t1, pt.x, def->p);
-  bigint_mmul(t1, pt.x, def->a, def->p);
-  bigint_add(t2, t2, t1);
-  bigint_madd(t2, t2, def->b, def->p);
-  bigint_addw(t1, def->p, 1);
-  bigint_rshift(t1, t1, 2);
-  bigint_mpow(pt.y, t2, t1, def->p);
-  if ((bigint_get_ls_word(pt.y) & 1) ^ (data[0]-2))
-   bigint_sub(pt.y, def->p, pt.y);
-  bigint_destroy(t2);
-  bigint_destroy(t1);
   return true;
- } 
+ }
  return false;
 }
 
 pkc_ecdsa::pkc_ecdsa()
 {
- ec_wei_def_init(&def, nullptr, nullptr, nullptr);
- init_point(gen);
  init_point(pub);
- order = priv = nullptr;
+ curve_ctx = nullptr;
+ priv = nullptr;
+ gen_table = nullptr;
+ gen_table_p256 = nullptr;
+ pub_table = nullptr;
+ verify_count = 0;
  rng = nullptr;
  curve_id = 0;
  key_bits = 0;
@@ -125,11 +164,20 @@ int pkc_ecdsa::hash_oid_to_sign_oid(int id)
 
 void pkc_ecdsa::clear()
 {
- ec_wei_def_destroy(&def);
- ec_wei_point_destroy(&gen);
  ec_wei_point_destroy(&pub);
- bigint_destroy(order);
  bigint_destroy(priv);
+ destroy_pub_tables(pub_table.exchange(nullptr));
+ verify_count = 0;
+}
+
+void pkc_ecdsa::destroy_pub_tables(pub_tables *t)
+{
+ if (!t) return;
+ if (t->pub_p256)
+  ec_p256_table_destroy(t->pub_p256);
+ else
+  ec_wei_fixed_table_destroy(&t->pub);
+ delete t;
 }
 
 static const curve_wei *get_curve(const asn1::element *el)
@@ -144,23 +192,16 @@ bool pkc_ecdsa::set_public_key(const void *data, size_t size, const asn1::elemen
 {
  const curve_wei *curve = get_curve(param);
  if (!curve) return false;
- ec_wei_def_t new_def;
- ec_point_t new_gen, new_pub;
- bigint_t new_order;
- init_curve(&new_def, &new_gen, &new_order, curve);
- if (!get_point(new_pub, static_cast<const uint8_t*>(data), size, &new_def))
- {
-  ec_wei_def_destroy(&new_def);
-  ec_wei_point_destroy(&new_gen);
-  bigint_destroy(new_order);
-  return false;
- }
+ const curve_context *new_ctx = get_wei_curve_context(curve);
+ ec_point_t new_pub;
+ if (!get_point(new_pub, static_cast<const uint8_t*>(data), size, new_ctx)) return false;
  clear();
- def = new_def;
- gen = new_gen;
+ curve_ctx = new_ctx;
  pub = new_pub;
- order = new_order;
  priv = nullptr;
+ // verification with the endomorphism computes u1*G separately
+ gen_table = new_ctx->glv && !new_ctx->fast? get_wei_fixed_table(curve) : nullptr;
+ gen_table_p256 = nullptr;
  curve_id = curve->id;
  key_bits = curve->bits;
  return true;
@@ -172,12 +213,12 @@ bool pkc_ecdsa::set_private_key(const void *data, size_t size, const asn1::eleme
  if (!root) return false;
  int curve_id = 0;
  bool result = false;
- ec_wei_def_t new_def;
- ec_point_t new_gen, new_pub;
- bigint_t new_order = nullptr;
+ const curve_wei *curve;
+ const ec_fixed_table_t *new_table = nullptr;
+ const ec_p256_table_t *new_table_p256 = nullptr;
+ const curve_context *new_ctx;
+ ec_point_t new_pub;
  bigint_t new_priv = nullptr;
- ec_wei_def_init(&new_def, nullptr, nullptr, nullptr);
- init_point(new_gen);
  init_point(new_pub);
  const asn1::element *el, *el_priv;
  if (!root->is_sequence()) goto fin; // ECPrivateKey, rfc5919
@@ -190,65 +231,179 @@ bool pkc_ecdsa::set_private_key(const void *data, size_t size, const asn1::eleme
  if (el && el->cls == asn1::CLASS_CONTEXT_SPECIFIC && el->tag == 0)
  {
   const asn1::element *el_curve = el->child;
-  const curve_wei *curve = get_curve(el_curve);
+  curve = get_curve(el_curve);
   if (!curve) goto fin;
   if (param &&
       (!param->is_obj_id() || param->size != el_curve->size ||
         memcmp(param->data, el_curve->data, param->size))) goto fin;
   el = el->sibling;
-  init_curve(&new_def, &new_gen, &new_order, curve);
-  curve_id = curve->id;
-  key_bits = curve->bits;
  } else
  {
   // PKCS #8: get curve from params
-  const curve_wei *curve = get_curve(param);
+  curve = get_curve(param);
   if (!curve) goto fin;
-  init_curve(&new_def, &new_gen, &new_order, curve);
-  curve_id = curve->id;
-  key_bits = curve->bits;
  }
- if (el_priv->size != (size_t) bigint_get_byte_count(new_order)) goto fin;
+ new_ctx = get_wei_curve_context(curve);
+ curve_id = curve->id;
+ if (el_priv->size != (size_t) bigint_get_byte_count(new_ctx->order)) goto fin;
+ // signing uses constant time multiplication, the generic table is only for verification
+ if (curve_id == ID_SECP256R1)
+  new_table_p256 = get_p256_fixed_table();
+ else
+ if (new_ctx->glv && !new_ctx->fast)
+  new_table = get_wei_fixed_table(curve);
  new_priv = bigint_create_bytes_be(el_priv->data, el_priv->size);
+ if (bigint_eq_word(new_priv, 0) || bigint_cmp(new_priv, new_ctx->order) >= 0) goto fin;
  if (el && el->cls == asn1::CLASS_CONTEXT_SPECIFIC && el->tag == 1)
  {
   const asn1::element *el_pub = el->child;
   if (!(el_pub && el_pub->is_aligned_bit_string())) goto fin;
-  if (!get_point(new_pub, el_pub->data + 1, el_pub->size - 1, &new_def)) goto fin;
+  if (!get_point(new_pub, el_pub->data + 1, el_pub->size - 1, new_ctx)) goto fin;
  } else
  {
   // calculate public key
-  ec_scratch_t s;
-  ec_wei_scratch_init(&s, &new_def);
-  ec_wei_point_init(&new_pub, &new_def);
-  ec_point_mul(&new_pub, &new_gen, &new_def, new_priv, &s);
-  int res = ec_point_normalize(&new_pub, &new_def, &s);
-  ec_wei_scratch_destroy(&s);
+  int res;
+  ec_wei_point_init(&new_pub, &new_ctx->def);
+  if (new_table_p256)
+  {
+   res = ec_p256_point_mul_fixed_ct(new_pub.x, new_pub.y, new_table_p256, new_priv);
+   bigint_set_word(new_pub.z, 1);
+  } else
+  if (new_ctx->fast)
+  {
+   res = new_ctx->fast->mul_base_ct(new_pub.x, new_pub.y, new_priv, new_ctx);
+   bigint_set_word(new_pub.z, 1);
+  } else
+  {
+   wei_scratch s(new_ctx);
+   ec_point_mul_ladder(&new_pub, &new_ctx->gen, new_ctx->order, &new_ctx->def, new_priv, s.get());
+   res = ec_point_normalize(&new_pub, &new_ctx->def, s.get());
+  }
   if (!res) goto fin;
  }
 
  result = true;
  clear();
- def = new_def;
- gen = new_gen;
+ curve_ctx = new_ctx;
  pub = new_pub;
- order = new_order;
  priv = new_priv;
+ gen_table = new_table;
+ gen_table_p256 = new_table_p256;
  this->curve_id = curve_id;
+ key_bits = curve->bits;
 
  fin:
  asn1::delete_tree(root);
  if (!result)
  {
-  ec_wei_def_destroy(&new_def);
-  ec_wei_point_destroy(&new_gen);
   ec_wei_point_destroy(&new_pub);
-  bigint_destroy(new_order);
   bigint_destroy(new_priv);
  }
  return result;
 }
 
+// takes ownership of new_priv and new_pub
+void pkc_ecdsa::set_key_pair(const curve_context *ctx, bigint_t new_priv, const ec_point_t &new_pub)
+{
+ clear();
+ curve_ctx = ctx;
+ pub = new_pub;
+ priv = new_priv;
+ curve_id = ctx->params->id;
+ key_bits = ctx->params->bits;
+ // signing uses constant time multiplication, the generic table is only for verification
+ gen_table_p256 = curve_id == ID_SECP256R1? get_p256_fixed_table() : nullptr;
+ gen_table = !gen_table_p256 && ctx->glv && !ctx->fast? get_wei_fixed_table(ctx->params) : nullptr;
+}
+
+bool pkc_ecdsa::generate_key(int curve_id, random_gen *rng)
+{
+ return generate_keys(this, 1, curve_id, rng);
+}
+
+bool pkc_ecdsa::generate_keys(pkc_ecdsa *keys, size_t count, int curve_id, random_gen *rng)
+{
+ const curve_wei *curve = get_wei_curve_by_id(curve_id);
+ if (!curve || !rng) return false;
+ if (!count) return true;
+ const curve_context *ctx = get_wei_curve_context(curve);
+ const ec_wei_def_t *def = &ctx->def;
+
+ // d = c mod (n-1) + 1 with 64 extra random bits in c (FIPS 186-4, B.4.1)
+ size_t rsize = bigint_get_byte_count(ctx->order) + 8;
+ uint8_t *rbuf = new uint8_t[count * rsize];
+ if (!rng->get_secure_random(rbuf, count * rsize))
+ {
+  delete[] rbuf;
+  return false;
+ }
+ bigint_t *new_priv = new bigint_t[count];
+ ec_point_t *new_pub = new ec_point_t[count];
+ bigint_t nm1 = bigint_create(0);
+ bigint_subw(nm1, ctx->order, 1);
+ for (size_t i = 0; i < count; i++)
+ {
+  new_priv[i] = bigint_create_bytes_be(rbuf + i*rsize, rsize);
+  bigint_mod(new_priv[i], new_priv[i], nm1);
+  bigint_addw(new_priv[i], new_priv[i], 1);
+  ec_wei_point_init(&new_pub[i], def);
+ }
+ memset(rbuf, 0, count * rsize);
+ delete[] rbuf;
+ bigint_destroy(nm1);
+
+ bool result;
+ if (curve_id == ID_SECP256R1)
+ {
+  bigint_t *xy = new bigint_t[count << 1];
+  for (size_t i = 0; i < count; i++)
+  {
+   xy[i] = new_pub[i].x;
+   xy[count + i] = new_pub[i].y;
+   bigint_set_word(new_pub[i].z, 1);
+  }
+  result = ec_p256_points_mul_fixed_ct(xy, xy + count, get_p256_fixed_table(), new_priv, count) != 0;
+  delete[] xy;
+ } else
+ if (ctx->fast)
+ {
+  result = ctx->fast->mul_base_ct_batch(new_pub, new_priv, count, ctx);
+ } else
+ {
+  wei_scratch s(ctx);
+  for (size_t i = 0; i < count; i++)
+   ec_point_mul_ladder(&new_pub[i], &ctx->gen, ctx->order, def, new_priv[i], s.get());
+  result = ec_points_normalize(new_pub, count, def, s.get()) != 0;
+ }
+ for (size_t i = 0; i < count; i++)
+  if (result)
+   keys[i].set_key_pair(ctx, new_priv[i], new_pub[i]);
+  else
+  {
+   ec_wei_point_destroy(&new_pub[i]);
+   bigint_destroy(new_priv[i]);
+  }
+ delete[] new_pub;
+ delete[] new_priv;
+ return result;
+}
+
+bool pkc_ecdsa::get_public_key(void *out, size_t &size) const
+{
+ if (!pub.x) return false;
+ size_t coord_size = bigint_get_byte_count(curve_ctx->def.p);
+ if (size < 2*coord_size + 1) return false;
+ uint8_t *data = static_cast<uint8_t*>(out);
+ memset(data, 0, 2*coord_size + 1);
+ data[0] = 4;
+ int x_size = bigint_get_byte_count(pub.x);
+ int y_size = bigint_get_byte_count(pub.y);
+ if (x_size) bigint_get_bytes_be(pub.x, data + 1 + coord_size - x_size, x_size);
+ if (y_size) bigint_get_bytes_be(pub.y, data + 1 + 2*coord_size - y_size, y_size);
+ size = 2*coord_size + 1;
+ return true;
+}
+
 #define GET_INT_PARAM(result) \
  if (params[i].size) return 0; \
  result = params[i].ival;
@@ -263,6 +418,8 @@ bool pkc_ecdsa::create_signature(void *out, size_t &out_size,
                                  random_gen *rng) const
 {
  if (!priv) return false;
+ const ec_wei_def_t *def = &curve_ctx->def;
+ const bigint_t order = curve_ctx->order;
  bool data_is_hash = false;
  bool deterministic = true;
  int hash_alg = 0;
@@ -302,8 +459,8 @@ bool pkc_ecdsa::create_signature(void *out, size_t &out_size,
  if (shift > 0) bigint_rshift(h, h, shift);
  if (bigint_cmp(h, order) > 0) bigint_sub(h, h, order);
 
- uint8_t *kbuf, *vbuf, *qdata;
- size_t qsize;
+ uint8_t *kbuf = nullptr, *vbuf = nullptr, *qdata = nullptr;
+ size_t qsize = 0;
  void *ctx_hmac = nullptr;
  bigint_t r = bigint_create(0);
  bigint_t s = bigint_create(0);
@@ -326,10 +483,9 @@ bool pkc_ecdsa::create_signature(void *out, size_t &out_size,
   bigint_get_bytes_be(order, qdata, qsize);
  }
  bool result = false;
- ec_scratch_t scratch;
  ec_point_t pt;
- ec_wei_scratch_init(&scratch, &def);
- ec_wei_point_init(&pt, &def);
+ wei_scratch scratch(curve_ctx);
+ ec_wei_point_init(&pt, def);
  for (;;)
  {
   if (deterministic)
@@ -341,8 +497,20 @@ bool pkc_ecdsa::create_signature(void *out, size_t &out_size,
    bigint_set_bytes_be(k, kbuf, qsize);
    if (bigint_eq_word(k, 0)) continue;
   }
-  ec_point_mul(&pt, &gen, &def, k, &scratch);
-  if (!ec_point_affine_x(r, &pt, &def, &scratch))
+  int res;
+  if (gen_table_p256)
+  {
+   res = ec_p256_point_mul_fixed_ct(r, nullptr, gen_table_p256, k);
+  } else
+  if (curve_ctx->fast)
+  {
+   res = curve_ctx->fast->mul_base_ct(r, nullptr, k, curve_ctx);
+  } else
+  {
+   ec_point_mul_ladder(&pt, &curve_ctx->gen, order, def, k, scratch.get());
+   res = ec_point_affine_x(r, &pt, def, scratch.get());
+  }
+  if (!res)
   {
    if (deterministic) gen_k_next_key(kbuf, vbuf, hd->hash_size, ctx_hmac);
    continue;
@@ -370,7 +538,6 @@ bool pkc_ecdsa::create_signature(void *out, size_t &out_size,
  bigint_destroy(t1);
  bigint_destroy(k);
  ec_wei_point_destroy(&pt);
- ec_wei_scratch_destroy(&scratch);
 
  if (!result)
  {
@@ -437,28 +604,25 @@ asn1::element *pkc_ecdsa::create_params_struct(const param_data *params, int par
  return root;
 }
 
-bool pkc_ecdsa::verify_signature(const void *sig, size_t sig_size,
-                                 const void *data, size_t data_size,
-                                 const param_data *params, int param_count) const
+static bool get_verify_params(const hash_def* &hd, bool &data_is_hash,
+                              const pkc_base::param_data *params, int param_count)
 {
- if (!pub.x) return false;
-
  int hash_alg = 0;
  const asn1::element *alg_info = nullptr;
- bool data_is_hash = false;
+ data_is_hash = false;
 
  for (int i = 0; i < param_count; i++)
   switch (params[i].type)
   {
-   case PARAM_DATA_IS_HASH:
+   case pkc_base::PARAM_DATA_IS_HASH:
     GET_BOOL_PARAM(data_is_hash);
     break;
 
-   case PARAM_HASH_ALG:
+   case pkc_base::PARAM_HASH_ALG:
     GET_INT_PARAM(hash_alg);
     break;
 
-   case PARAM_ALG_INFO:
+   case pkc_base::PARAM_ALG_INFO:
     if (params[i].size) return false;
     alg_info = static_cast<const asn1::element*>(params[i].data);
     break;
@@ -472,90 +636,365 @@ bool pkc_ecdsa::verify_signature(const void *sig, size_t sig_size,
   int enc_alg;
   const asn1::element *alg_param;
   if (!parse_alg_id(enc_alg, alg_param, alg_info)) return false;
-  hash_alg = sign_oid_to_hash_oid(enc_alg);
+  hash_alg = pkc_ecdsa::sign_oid_to_hash_oid(enc_alg);
  }
 
  if (!hash_alg) return false;
- const hash_def *hd = hash_factory(hash_alg);
- if (!hd) return false;
- if (data_is_hash && hd->hash_size != data_size) return false;
+ hd = hash_factory(hash_alg);
+ return hd != nullptr;
+}
 
+// Decodes the signature and hashes the data, r and s are checked to be in [1, n-1]
+static bool get_sig_values(bigint_t &r, bigint_t &s, bigint_t &h, const bigint_t order,
+                           const void *sig, size_t sig_size,
+                           const void *data, size_t data_size,
+                           const hash_def *hd, bool data_is_hash)
+{
+ if (data_is_hash && hd->hash_size != data_size) return false;
  asn1::element *el_sig = asn1::decode(sig, sig_size, 0, nullptr);
  if (!el_sig) return false;
- bool result = false;
+ r = s = nullptr;
  if (el_sig->is_sequence())
  {
   const asn1::element *el = el_sig->child;
   if (el && el->is_valid_positive_int())
   {
-   bigint_t r = bigint_create_bytes_be(el->data, el->size);
-   if (!bigint_eq_word(r, 0) && bigint_cmp(r, order) < 0)
+   r = bigint_create_bytes_be(el->data, el->size);
+   el = el->sibling;
+   if (el && el->is_valid_positive_int())
+    s = bigint_create_bytes_be(el->data, el->size);
+  }
+ }
+ asn1::delete_tree(el_sig);
+ if (!(s && 
+       !bigint_eq_word(r, 0) && bigint_cmp(r, order) < 0 &&
+       !bigint_eq_word(s, 0) && bigint_cmp(s, order) < 0))
+ {
+  bigint_destroy(s);
+  bigint_destroy(r);
+  return false;
+ }
+ if (data_is_hash)
+ {
+  h = bigint_create_bytes_be(data, hd->hash_size);
+ } else
+ {
+  void *ctx = alloca(hd->context_size);
+  hd->func_init(ctx);
+  hd->func_update(ctx, data, data_size);
+  h = bigint_create_bytes_be(hd->func_final(ctx), hd->hash_size);
+ }
+ int shift = (hd->hash_size<<3) - bigint_get_bit_count(order);
+ if (shift > 0) bigint_rshift(h, h, shift);
+ if (bigint_cmp(h, order) > 0) bigint_sub(h, h, order);
+ return true;
+}
+
+bool pkc_ecdsa::precompute_public_key()
+{
+ if (pub_table.load(std::memory_order_acquire)) return true;
+ return create_pub_table() != nullptr;
+}
+
+// Builds the tables without a lock, concurrent verifiers use the slower
+// path until they are published. Returns the published tables.
+const pkc_ecdsa::pub_tables *pkc_ecdsa::create_pub_table() const
+{
+ if (!pub.x) return nullptr;
+ pub_tables *t = new pub_tables;
+ t->pub_p256 = nullptr;
+ t->gen = nullptr;
+ t->gen_p256 = nullptr;
+ if (curve_id == ID_SECP256R1)
+ {
+  t->pub_p256 = ec_p256_table_create(&pub);
+  if (!t->pub_p256)
+  {
+   delete t;
+   return nullptr;
+  }
+  t->gen_p256 = get_p256_fixed_table();
+ } else
+ {
+  wei_scratch s(curve_ctx);
+  ec_weij_fixed_table_init(&t->pub, &pub, bigint_get_bit_count(curve_ctx->order), PUB_TABLE_WINDOW, &curve_ctx->def, s.get());
+  t->gen = get_wei_fixed_table(curve_ctx->params);
+ }
+ pub_tables *prev = nullptr;
+ if (!pub_table.compare_exchange_strong(prev, t, std::memory_order_acq_rel, std::memory_order_acquire))
+ {
+  // precompute_public_key raced with a verification
+  destroy_pub_tables(t);
+  return prev;
+ }
+ return t;
+}
+
+const pkc_ecdsa::pub_tables *pkc_ecdsa::use_pub_table() const
+{
+ const pub_tables *t = pub_table.load(std::memory_order_acquire);
+ if (t) return t;
+ // only the verification reaching the threshold builds the tables
+ if (verify_count.fetch_add(1, std::memory_order_relaxed) + 1 != PUB_TABLE_THRESHOLD) return nullptr;
+ return create_pub_table();
+}
+
+// res = u1*G + u2*Q without doublings if the key is hot
+bool pkc_ecdsa::mul_pub_table(ec_point_t *res, bool &jacobian, const bigint_t u1, const bigint_t u2, ec_scratch_t *s) const
+{
+ const pub_tables *t = use_pub_table();
+ if (!t) return false;
+ if (t->pub_p256)
+ {
+  jacobian = true;
+  return ec_p256_point_mul2_tables(res, t->gen_p256, u1, t->pub_p256, u2) != 0;
+ }
+ const ec_wei_def_t *def = &curve_ctx->def;
+ ec_point_t p2;
+ ec_wei_point_init(&p2, def);
+ ec_point_mul_fixed(res, t->gen, def, u1, s);
+ ec_point_mul_fixed(&p2, &t->pub, def, u2, s);
+ ec_point_add(res, res, &p2, def, s);
+ ec_wei_point_destroy(&p2);
+ jacobian = EC_POINT_JACOBIAN;
+ return true;
+}
+
+// Checks x(pt) mod n = r without the conversion to affine coordinates:
+// x(pt) = X/Z^2 (Jacobian) or X/Z (projective), x(pt) < p
+static bool check_x(const ec_point_t *pt, bool jacobian, const bigint_t r,
+                    const bigint_t order, const ec_wei_def_t *def, ec_scratch_t *s)
+{
+ if (bigint_eq_word(pt->z, 0)) return false;
+ if (jacobian)
+  bigint_mmul(s->v[0], pt->z, pt->z, def->p);
+ else
+  bigint_copy(s->v[0], pt->z);
+ bigint_copy(s->v[1], r);
+ while (bigint_cmp(s->v[1], def->p) < 0)
+ {
+  bigint_mmul(s->v[2], s->v[0], s->v[1], def->p);
+  bigint_sub(s->v[2], s->v[2], pt->x);
+  bigint_mod(s->v[2], s->v[2], def->p);
+  if (bigint_eq_word(s->v[2], 0)) return true;
+  bigint_add(s->v[1], s->v[1], order);
+ }
+ return false;
+}
+
+bool pkc_ecdsa::verify_signature(const void *sig, size_t sig_size,
+                                 const void *data, size_t data_size,
+                                 const param_data *params, int param_count) const
+{
+ if (!pub.x) return false;
+ const ec_wei_def_t *def = &curve_ctx->def;
+ const bigint_t order = curve_ctx->order;
+
+ const hash_def *hd;
+ bool data_is_hash;
+ if (!get_verify_params(hd, data_is_hash, params, param_count)) return false;
+
+ bigint_t r, s, h;
+ if (!get_sig_values(r, s, h, order, sig, sig_size, data, data_size, hd, data_is_hash)) return false;
+ bool result = false;
+ bigint_t w = bigint_create(0);
+ bigint_t t = bigint_create(0);
+ if (bigint_minv(w, s, order))
+ {
+  wei_scratch scratch(curve_ctx);
+  ec_scratch_t *s = scratch.get();
+  ec_point_t pt;
+  bigint_t u1 = bigint_create(0);
+  bigint_mmul(u1, h, w, order);
+  bigint_mmul(t, r, w, order);
+  ec_wei_point_init(&pt, def);
+  bool jacobian;
+  if (mul_pub_table(&pt, jacobian, u1, t, s))
+  {
+   result = check_x(&pt, jacobian, r, order, def, s);
+  } else
+  if (curve_ctx->fast)
+  {
+   // Jacobian result, check_x needs no inversion
+   if (curve_ctx->fast->mul2(&pt, u1, &pub, t, curve_ctx))
+    result = check_x(&pt, true, r, order, def, s);
+  } else
+  {
+   int res;
+   if (curve_id == ID_SECP256R1)
    {
-    el = el->sibling;
-    if (el && el->is_valid_positive_int())
+    res = ec_p256_point_mul2(t, nullptr, &curve_ctx->gen, u1, &pub, t);
+   } else
+   {
+    if (curve_ctx->glv)
     {
-     bigint_t s = bigint_create_bytes_be(el->data, el->size);
-     if (!bigint_eq_word(s, 0) && bigint_cmp(s, order) < 0)
-     {
-      bigint_t h;
-      if (data_is_hash)
-      {
-       h = bigint_create_bytes_be(data, hd->hash_size);
-      } else
-      {
-       void *ctx = alloca(hd->context_size);
-       hd->func_init(ctx);
-       hd->func_update(ctx, data, data_size);
-       h = bigint_create_bytes_be(hd->func_final(ctx), hd->hash_size);
-      }
-      
-      int qbits = bigint_get_bit_count(order);
-      int shift = (hd->hash_size<<3) - qbits;
-      if (shift > 0) bigint_rshift(h, h, shift);
-      if (bigint_cmp(h, order) > 0) bigint_sub(h, h, order);
-      bigint_t w = bigint_create(0);
-      bigint_t t = bigint_create(0);
-      if (bigint_minv(w, s, order))
-      {
-       ec_scratch_t s;
-       ec_point_t p1, p2;
-       bigint_mmul(t, h, w, order);
-       ec_wei_point_init(&p1, &def);
-       ec_wei_scratch_init(&s, &def);
-       ec_point_mul(&p1, &gen, &def, t, &s);
-       bigint_mmul(t, r, w, order);
-       ec_wei_point_init(&p2, &def);
-       ec_point_mul(&p2, &pub, &def, t, &s);
-       ec_point_add(&p1, &p1, &p2, &def, &s);
-       if (ec_point_affine_x(t, &p1, &def, &s))
-       {
-        bigint_mod(t, t, order);
-        result = bigint_cmp(t, r) == 0;
-       }
-       ec_wei_point_destroy(&p2);
-       ec_wei_point_destroy(&p1);
-       ec_wei_scratch_destroy(&s);
-      }
-      bigint_destroy(t);
-      bigint_destroy(w);
-      bigint_destroy(h);
-     }
-     bigint_destroy(s);
-    } 
+     ec_point_t p2;
+     ec_wei_point_init(&p2, def);
+     ec_point_mul_fixed(&pt, gen_table, def, u1, s);
+     ec_point_mul_glv(&p2, &pub, curve_ctx->glv, def, t, s);
+     ec_point_add(&pt, &pt, &p2, def, s);
+     ec_wei_point_destroy(&p2);
+    } else
+     ec_point_mul2(&pt, &curve_ctx->gen, u1, &pub, t, def, s);
+    res = ec_point_affine_x(t, &pt, def, s);
+   }
+   if (res)
+   {
+    bigint_mod(t, t, order);
+    result = bigint_cmp(t, r) == 0;
    }
-   bigint_destroy(r);
   }
+  ec_wei_point_destroy(&pt);
+  bigint_destroy(u1);
  }
- asn1::delete_tree(el_sig);
+ bigint_destroy(t);
+ bigint_destroy(w);
+ bigint_destroy(h);
+ bigint_destroy(s);
+ bigint_destroy(r);
  return result;
 }
 
+void pkc_ecdsa::verify_curve_batch(bool *results, const verify_item *items,
+                                   const size_t *index, size_t count,
+                                   bigint_t *r, bigint_t *s, bigint_t *h)
+{
+ const pkc_ecdsa *key = items[index[0]].key;
+ const bigint_t order = key->curve_ctx->order;
+ const ec_wei_def_t *def = &key->curve_ctx->def;
+ bigint_t *c = new bigint_t[count];
+ bigint_t u1 = bigint_create(0);
+ bigint_t u2 = bigint_create(0);
+ size_t i;
+
+ // s[i] = 1/s[i] with a single inversion:
+ // c[i] = s[0]*...*s[i], 1/s[i] = c[i-1]/c[i]
+ for (i = 0; i < count; i++) c[i] = bigint_create(0);
+ bigint_copy(c[0], s[index[0]]);
+ for (i = 1; i < count; i++) bigint_mmul(c[i], c[i-1], s[index[i]], order);
+ if (!bigint_minv(u1, c[count-1], order))
+ {
+  for (i = 0; i < count; i++) bigint_destroy(c[i]);
+  delete[] c;
+  bigint_destroy(u2);
+  bigint_destroy(u1);
+  return;
+ }
+ for (i = count-1; i > 0; i--)
+ {
+  bigint_mmul(u2, u1, c[i-1], order);
+  bigint_mmul(u1, u1, s[index[i]], order);
+  bigint_copy(s[index[i]], u2);
+ }
+ bigint_copy(s[index[0]], u1);
+ for (i = 0; i < count; i++) bigint_destroy(c[i]);
+ delete[] c;
+
+ ec_point_t p1, p2;
+ wei_scratch scratch(key->curve_ctx);
+ ec_wei_point_init(&p1, def);
+ ec_wei_point_init(&p2, def);
+ const ec_fixed_table_t *table = nullptr;
+ const ec_p256_table_t *table_p256 = nullptr;
+ if (key->curve_id == ID_SECP256R1)
+  table_p256 = get_p256_fixed_table();
+ else
+ if (!key->curve_ctx->fast)
+  table = get_wei_fixed_table(key->curve_ctx->params);
+ for (i = 0; i < count; i++)
+ {
+  size_t j = index[i];
+  key = items[j].key;
+  bigint_mmul(u1, h[j], s[j], order);
+  bigint_mmul(u2, r[j], s[j], order);
+  // u1*G doesn't need doublings, only u2*Q does
+  bool jacobian;
+  if (!key->mul_pub_table(&p1, jacobian, u1, u2, scratch.get()))
+  {
+   if (table_p256)
+   {
+    if (!ec_p256_point_mul2_fixed(&p1, table_p256, u1, &key->pub, u2)) continue;
+    jacobian = true;
+   } else
+   if (key->curve_ctx->fast)
+   {
+    if (!key->curve_ctx->fast->mul2(&p1, u1, &key->pub, u2, key->curve_ctx)) continue;
+    jacobian = true;
+   } else
+   {
+    ec_point_mul_fixed(&p1, table, def, u1, scratch.get());
+    if (key->curve_ctx->glv)
+     ec_point_mul_glv(&p2, &key->pub, key->curve_ctx->glv, def, u2, scratch.get());
+    else
+     ec_point_mul(&p2, &key->pub, def, u2, scratch.get());
+    ec_point_add(&p1, &p1, &p2, def, scratch.get());
+    jacobian = EC_POINT_JACOBIAN;
+   }
+  }
+  results[j] = check_x(&p1, jacobian, r[j], order, def, scratch.get());
+ }
+ ec_wei_point_destroy(&p2);
+ ec_wei_point_destroy(&p1);
+ bigint_destroy(u2);
+ bigint_destroy(u1);
+}
+
+size_t pkc_ecdsa::verify_signatures(bool *results, const verify_item *items, size_t count,
+                                    const param_data *params, int param_count)
+{
+ size_t i, j, valid = 0;
+ for (i = 0; i < count; i++) results[i] = false;
+ const hash_def *hd;
+ bool data_is_hash;
+ if (!count || !get_verify_params(hd, data_is_hash, params, param_count)) return 0;
+
+ bigint_t *r = new bigint_t[count*3];
+ bigint_t *s = r + count;
+ bigint_t *h = s + count;
+ size_t *index = new size_t[count];
+ bool *pending = new bool[count];
+ for (i = 0; i < count; i++)
+ {
+  const pkc_ecdsa *key = items[i].key;
+  pending[i] = key && key->pub.x &&
+   get_sig_values(r[i], s[i], h[i], key->curve_ctx->order, items[i].sig, items[i].sig_size,
+                  items[i].data, items[i].data_size, hd, data_is_hash);
+ }
+
+ // keys on the same curve share the inversions
+ for (i = 0; i < count; i++)
+ {
+  if (!pending[i]) continue;
+  int curve_id = items[i].key->curve_id;
+  size_t group_count = 0;
+  for (j = i; j < count; j++)
+   if (pending[j] && items[j].key->curve_id == curve_id)
+   {
+    index[group_count++] = j;
+    pending[j] = false;
+   }
+  verify_curve_batch(results, items, index, group_count, r, s, h);
+  for (j = 0; j < group_count; j++)
+  {
+   size_t k = index[j];
+   bigint_destroy(r[k]);
+   bigint_destroy(s[k]);
+   bigint_destroy(h[k]);
+   if (results[k]) valid++;
+  }
+ }
+ delete[] pending;
+ delete[] index;
+ delete[] r;
+ return valid;
+}
+
 size_t pkc_ecdsa::get_max_signature_size() const
 {
  // sequence: 2 header bytes
  // integers: 2 header bytes, 1 zero pad byte
- if (!order) return 0;
- return (bigint_get_byte_count(order) << 1) + 8;
+ if (!curve_ctx) return 0;
+ return (bigint_get_byte_count(curve_ctx->order) << 1) + 8;
 }
 
 size_t pkc_ecdsa::get_min_signature_size() const
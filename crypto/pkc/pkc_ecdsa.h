@@ -3,6 +3,10 @@
 
 #include "pkc_base.h"
 #include <crypto/ec/ec_wei.h>
+#include <crypto/ec/ec_p256.h>
+#include <atomic>
+
+struct curve_context;
 
 class pkc_ecdsa : public pkc_base
 {
@@ -11,6 +15,21 @@ class pkc_ecdsa : public pkc_base
   {
    PARAM_DETERMINISTIC = 64
   };
+
+  // the public key table is built after this many verifications
+  enum
+  {
+   PUB_TABLE_THRESHOLD = 16
+  };
+
+  struct verify_item
+  {
+   const pkc_ecdsa *key;
+   const void *sig;
+   size_t sig_size;
+   const void *data;
+   size_t data_size;
+  };
   
   pkc_ecdsa();
   virtual ~pkc_ecdsa();
@@ -30,20 +49,57 @@ class pkc_ecdsa : public pkc_base
   virtual size_t get_min_signature_size() const;
   virtual int get_key_bits() const { return key_bits; }
 
+  // New key pair on the curve given by its OID id, the secret is taken from rng
+  bool generate_key(int curve_id, random_gen *rng);
+  // Fills count keys with one RNG request, the public points share one
+  // inversion. Returns false and leaves the keys unchanged on error.
+  static bool generate_keys(pkc_ecdsa *keys, size_t count, int curve_id, random_gen *rng);
+  // Uncompressed point (0x04, x, y). size is the buffer size on input
+  bool get_public_key(void *out, size_t &size) const;
+
+  // Builds the table of multiples of the public key now instead of waiting
+  // for PUB_TABLE_THRESHOLD verifications. Returns false if there is no public key.
+  bool precompute_public_key();
+
   static int sign_oid_to_hash_oid(int id);
   static int hash_oid_to_sign_oid(int id);
+
+  // Verifies a batch of signatures with the same params, results[i] is set for every item.
+  // Returns the number of valid signatures.
+  static size_t verify_signatures(bool *results, const verify_item *items, size_t count,
+                                  const param_data *params, int param_count);
  
  private:  
   random_gen *rng;
-  ec_wei_def_t def;
-  ec_point_t gen;
+  // shared, owned by curves_wei
+  const curve_context *curve_ctx;
+  const ec_fixed_table_t *gen_table;
+  const ec_p256_table_t *gen_table_p256;
   ec_point_t pub;
-  bigint_t order;
   bigint_t priv;
   int curve_id;
   int key_bits;
+  // multiples of pub for hot keys with the generator table they are used with
+  struct pub_tables
+  {
+   ec_fixed_table_t pub;
+   ec_p256_table_t *pub_p256;
+   const ec_fixed_table_t *gen; // shared
+   const ec_p256_table_t *gen_p256;
+  };
+  // owned, published once, readers don't lock
+  mutable std::atomic<pub_tables*> pub_table;
+  mutable std::atomic<unsigned> verify_count;
 
   void clear();
+  void set_key_pair(const curve_context *ctx, bigint_t new_priv, const ec_point_t &new_pub);
+  const pub_tables *create_pub_table() const;
+  const pub_tables *use_pub_table() const;
+  bool mul_pub_table(ec_point_t *res, bool &jacobian, const bigint_t u1, const bigint_t u2, ec_scratch_t *s) const;
+  static void destroy_pub_tables(pub_tables *t);
+  static void verify_curve_batch(bool *results, const verify_item *items,
+                                 const size_t *index, size_t count,
+                                 bigint_t *r, bigint_t *s, bigint_t *h);
 };
 
 #endif // __pkc_ecdsa_h__
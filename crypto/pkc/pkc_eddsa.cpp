@@ -0,0 +1,243 @@
+#include "pkc_eddsa.h"
+#include "utils.h"
+#include <crypto/asn1/decoder.h>
+#include <crypto/oid_const.h>
+#include <crypto/sha512.h>
+#include <utils/mutex.h>
+#include <string.h>
+
+using namespace oid;
+
+// L = 2^252 + 27742317777372353535851937790883648493
+static const uint8_t ed25519_order[] =
+{
+ 0xED, 0xD3, 0xF5, 0x5C, 0x1A, 0x63, 0x12, 0x58,
+ 0xD6, 0x9C, 0xF7, 0xA2, 0xDE, 0xF9, 0xDE, 0x14,
+ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10
+};
+
+class base_table_cache
+{
+ public:
+  base_table_cache(): table(nullptr) {}
+  ~base_table_cache() { if (table) ec_ed25519_table_destroy(table); }
+  const ec_ed25519_table_t *get()
+  {
+   mutex_locker lock(this->lock);
+   if (!table) table = ec_ed25519_table_create();
+   return table;
+  }
+
+ private:
+  mutex lock;
+  ec_ed25519_table_t *table;
+};
+
+static base_table_cache base_table;
+
+pkc_eddsa::pkc_eddsa()
+{
+ table = nullptr;
+ has_priv = has_pub = false;
+}
+
+pkc_eddsa::~pkc_eddsa()
+{
+ clear();
+}
+
+int pkc_eddsa::get_id() const
+{
+ return ID_ED25519;
+}
+
+void pkc_eddsa::clear()
+{
+ memset(scalar, 0, sizeof(scalar));
+ memset(prefix, 0, sizeof(prefix));
+ has_priv = has_pub = false;
+}
+
+bool pkc_eddsa::set_public_key(const void *data, size_t size, const asn1::element *param)
+{
+ if (param || size != KEY_SIZE) return false;
+ ec_ext_point_t pt;
+ pt.x = bigint_create(0);
+ pt.y = bigint_create(0);
+ pt.z = bigint_create(0);
+ pt.t = bigint_create(0);
+ bool result = ec_ed25519_point_decode(&pt, static_cast<const uint8_t*>(data)) != 0;
+ bigint_destroy(pt.t);
+ bigint_destroy(pt.z);
+ bigint_destroy(pt.y);
+ bigint_destroy(pt.x);
+ if (!result) return false;
+ clear();
+ table = base_table.get();
+ memcpy(pub, data, KEY_SIZE);
+ has_pub = true;
+ return true;
+}
+
+bool pkc_eddsa::set_private_key(const void *data, size_t size, const asn1::element *param)
+{
+ if (param) return false;
+ asn1::element *root = asn1::decode(data, size, 0, nullptr);
+ if (!root) return false;
+ bool result = false;
+ if (root->is_octet_string() && root->size == KEY_SIZE) // CurvePrivateKey
+ {
+  clear();
+  SHA512_CTX hc;
+  sha512_init(&hc);
+  sha512_update(&hc, root->data, KEY_SIZE);
+  const uint8_t *h = static_cast<const uint8_t*>(sha512_final(&hc));
+  memcpy(scalar, h, KEY_SIZE);
+  memcpy(prefix, h + KEY_SIZE, KEY_SIZE);
+  memset(&hc, 0, sizeof(hc));
+  scalar[0] &= 248;
+  scalar[31] &= 127;
+  scalar[31] |= 64;
+  table = base_table.get();
+  ec_ed25519_point_mul_fixed(pub, table, scalar);
+  has_priv = has_pub = true;
+  result = true;
+ }
+ asn1::delete_tree(root);
+ return result;
+}
+
+#define GET_BOOL_PARAM(result) \
+ if (params[i].size) return false; \
+ result = params[i].bval;
+
+// PureEdDSA signs the data itself
+static bool check_params(const pkc_base::param_data *params, int param_count, bool allow_alg_info)
+{
+ bool data_is_hash;
+ int alg;
+ const asn1::element *alg_param;
+ for (int i = 0; i < param_count; i++)
+  switch (params[i].type)
+  {
+   case pkc_base::PARAM_DATA_IS_HASH:
+    GET_BOOL_PARAM(data_is_hash);
+    if (data_is_hash) return false;
+    break;
+
+   case pkc_base::PARAM_HASH_ALG:
+    break;
+
+   case pkc_base::PARAM_ALG_INFO:
+    if (!allow_alg_info || params[i].size) return false;
+    if (!parse_alg_id(alg, alg_param, static_cast<const asn1::element*>(params[i].data))) return false;
+    if (alg != ID_ED25519 || alg_param) return false;
+    break;
+
+   default:
+    return false;
+  }
+ return true;
+}
+
+// little-endian bytes mod L
+static bigint_t get_scalar(const void *data, size_t size, const bigint_t order)
+{
+ bigint_t r = bigint_create_bytes_le(data, size);
+ bigint_mod(r, r, order);
+ return r;
+}
+
+static void put_scalar(uint8_t *out, const bigint_t a)
+{
+ uint8_t buf[pkc_eddsa::KEY_SIZE];
+ int size = bigint_get_byte_count(a);
+ memset(buf, 0, sizeof(buf));
+ if (size) bigint_get_bytes_be(a, buf + sizeof(buf) - size, size);
+ for (size_t i = 0; i < sizeof(buf); i++) out[i] = buf[sizeof(buf)-1-i];
+}
+
+static bool is_reduced(const uint8_t *s)
+{
+ for (int i = sizeof(ed25519_order)-1; i >= 0; i--)
+  if (s[i] != ed25519_order[i]) return s[i] < ed25519_order[i];
+ return false;
+}
+
+bool pkc_eddsa::create_signature(void *out, size_t &out_size,
+                                 const void *data, size_t data_size,
+                                 const param_data *params, int param_count,
+                                 random_gen *rng) const
+{
+ if (!has_priv) return false;
+ if (!check_params(params, param_count, false)) return false;
+ if (out_size < SIGNATURE_SIZE) return false;
+ uint8_t *sig = static_cast<uint8_t*>(out);
+ bigint_t order = bigint_create_bytes_le(ed25519_order, sizeof(ed25519_order));
+
+ // r = H(prefix || M), R = r*B
+ SHA512_CTX hc;
+ sha512_init(&hc);
+ sha512_update(&hc, prefix, KEY_SIZE);
+ sha512_update(&hc, data, data_size);
+ bigint_t r = get_scalar(sha512_final(&hc), 64, order);
+ uint8_t rbuf[KEY_SIZE];
+ put_scalar(rbuf, r);
+ ec_ed25519_point_mul_fixed(sig, table, rbuf);
+ memset(rbuf, 0, sizeof(rbuf));
+
+ // k = H(R || A || M), S = r + k*a
+ sha512_init(&hc);
+ sha512_update(&hc, sig, KEY_SIZE);
+ sha512_update(&hc, pub, KEY_SIZE);
+ sha512_update(&hc, data, data_size);
+ bigint_t k = get_scalar(sha512_final(&hc), 64, order);
+ bigint_t a = get_scalar(scalar, KEY_SIZE, order);
+ bigint_mmul(k, k, a, order);
+ bigint_add(k, k, r);
+ if (bigint_cmp(k, order) >= 0) bigint_sub(k, k, order);
+ put_scalar(sig + KEY_SIZE, k);
+ memset(&hc, 0, sizeof(hc));
+ bigint_destroy(a);
+ bigint_destroy(k);
+ bigint_destroy(r);
+ bigint_destroy(order);
+ out_size = SIGNATURE_SIZE;
+ return true;
+}
+
+asn1::element *pkc_eddsa::create_params_struct(const param_data *params, int param_count, int where) const
+{
+ if (!check_params(params, param_count, false)) return nullptr;
+ // same identifier for keys and signatures, parameters are absent
+ const oid_def *oid_alg = get(ID_ED25519);
+ if (!oid_alg) return nullptr;
+ return create_alg_id(oid_alg);
+}
+
+bool pkc_eddsa::verify_signature(const void *sig, size_t sig_size,
+                                 const void *data, size_t data_size,
+                                 const param_data *params, int param_count) const
+{
+ if (!has_pub || sig_size != SIGNATURE_SIZE) return false;
+ if (!check_params(params, param_count, true)) return false;
+ const uint8_t *rs = static_cast<const uint8_t*>(sig);
+ if (!is_reduced(rs + KEY_SIZE)) return false;
+
+ SHA512_CTX hc;
+ sha512_init(&hc);
+ sha512_update(&hc, rs, KEY_SIZE);
+ sha512_update(&hc, pub, KEY_SIZE);
+ sha512_update(&hc, data, data_size);
+ bigint_t order = bigint_create_bytes_le(ed25519_order, sizeof(ed25519_order));
+ bigint_t k = get_scalar(sha512_final(&hc), 64, order);
+ uint8_t kbuf[KEY_SIZE], r[KEY_SIZE];
+ put_scalar(kbuf, k);
+ bigint_destroy(k);
+ bigint_destroy(order);
+
+ // R = S*B - k*A
+ if (!ec_ed25519_point_mul2_fixed(r, table, rs + KEY_SIZE, kbuf, pub)) return false;
+ return memcmp(r, rs, KEY_SIZE) == 0;
+}
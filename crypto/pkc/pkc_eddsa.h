@@ -0,0 +1,47 @@
+#ifndef __pkc_eddsa_h__
+#define __pkc_eddsa_h__
+
+#include "pkc_base.h"
+#include <crypto/ec/ec_ed25519.h>
+
+// Ed25519 (RFC 8032), keys are encoded as in RFC 8410.
+// The message is hashed with SHA-512 internally, PARAM_HASH_ALG is ignored.
+class pkc_eddsa : public pkc_base
+{
+ public:
+  enum
+  {
+   KEY_SIZE = 32,
+   SIGNATURE_SIZE = 64
+  };
+
+  pkc_eddsa();
+  virtual ~pkc_eddsa();
+  virtual int  get_id() const;
+  virtual bool set_public_key(const void *data, size_t size, const asn1::element *param);
+  virtual bool set_private_key(const void *data, size_t size, const asn1::element *param);
+  virtual bool create_signature(void *out, size_t &out_size,
+                                const void *data, size_t data_size,
+                                const param_data *params, int param_count,
+                                random_gen *rng) const;
+  virtual asn1::element *create_params_struct(const param_data *params, int param_count, int where) const;
+  virtual bool verify_signature(const void *sig, size_t sig_size,
+                                const void *data, size_t data_size,
+                                const param_data *params, int param_count) const;
+  virtual size_t get_max_signature_size() const { return SIGNATURE_SIZE; }
+  virtual size_t get_min_signature_size() const { return SIGNATURE_SIZE; }
+  virtual int get_key_bits() const { return 256; }
+
+ private:
+  // shared, owned by pkc_eddsa.cpp
+  const ec_ed25519_table_t *table;
+  uint8_t pub[KEY_SIZE];
+  uint8_t scalar[KEY_SIZE]; // clamped secret scalar
+  uint8_t prefix[KEY_SIZE]; // second half of the seed hash
+  bool has_priv;
+  bool has_pub;
+
+  void clear();
+};
+
+#endif // __pkc_eddsa_h__
@@ -13,6 +13,7 @@
 using namespace oid;
 
 #define countof(a) (sizeof(a)/sizeof(a[0]))
+#define ALLOCA_WORDS(count) static_cast<sys_word_t*>(alloca((count)*sizeof(sys_word_t)))
 
 static const size_t MIN_BITS = 512;
 static const size_t MAX_BITS = 16384;
@@ -47,6 +48,52 @@ pkc_rsa::pkc_rsa()
  pub_exp_large.clear();
  pub_exp_small = 0;
  priv_exp.clear();
+ mont_init(&mont_n);
+ for (int i = 0; i < MAX_PRIMES; i++)
+ {
+  mont_init(&primes[i].mont);
+  primes[i].coeff_mont = nullptr;
+ }
+ blinding = nullptr;
+ clear_crt();
+}
+
+pkc_rsa::~pkc_rsa()
+{
+ disable_blinding();
+ clear_crt();
+ mont_destroy(&mont_n);
+}
+
+void pkc_rsa::clear_crt()
+{
+ for (int i = 0; i < MAX_PRIMES; i++)
+ {
+  crt_prime &cp = primes[i];
+  cp.prime.clear();
+  cp.exponent.clear();
+  cp.coefficient.clear();
+  mont_destroy(&cp.mont);
+  delete[] cp.coeff_mont;
+  cp.coeff_mont = nullptr;
+ }
+ prime_count = 0;
+}
+
+bool pkc_rsa::init_crt()
+{
+ // the primes are smaller than n, so tmp is large enough for each of them
+ sys_word_t *tmp = ALLOCA_WORDS(MONT_TMP_WORDS(mont_n.size));
+ for (int i = 0; i < prime_count; i++)
+ {
+  crt_prime &cp = primes[i];
+  if (!mont_set_modulus(&cp.mont, cp.prime.data, cp.prime.size)) return false;
+  if (i == 1) continue; // q has no coefficient
+  cp.coeff_mont = new sys_word_t[cp.mont.size];
+  mont_load(cp.coeff_mont, cp.mont.size, cp.coefficient.data, cp.coefficient.size);
+  mont_to(&cp.mont, cp.coeff_mont, cp.coeff_mont, tmp);
+ }
+ return true;
 }
 
 int pkc_rsa::get_id() const
@@ -101,6 +148,64 @@ static bool get_priv_exponent(pkc_base::data_buffer &priv_exp,
  return is_less(priv_exp, modulus);
 }
 
+static bool get_crt_component(pkc_base::data_buffer &out,
+                              const pkc_base::data_buffer &bound, const asn1::element *el)
+{
+ if (!(el && el->is_valid_positive_int())) return false;
+ get_integer(out, el);
+ return is_less(out, bound);
+}
+
+// prime, exponent and coefficient of each prime in crt[3*i..3*i+2],
+// coefficient of the second prime is empty; returns the number of primes or 0
+static int get_crt_params(pkc_base::data_buffer crt[], const pkc_base::data_buffer &modulus,
+                          unsigned version, const asn1::element *el)
+{
+ // prime1, prime2, exponent1, exponent2, coefficient
+ if (!get_crt_component(crt[0], modulus, el)) return 0;
+ el = el->sibling;
+ if (!get_crt_component(crt[3], modulus, el)) return 0;
+ el = el->sibling;
+ if (!get_crt_component(crt[1], crt[0], el)) return 0;
+ el = el->sibling;
+ if (!get_crt_component(crt[4], crt[3], el)) return 0;
+ el = el->sibling;
+ if (!get_crt_component(crt[2], crt[0], el)) return 0;
+ crt[5].clear();
+ int count = 2;
+ // version 1 keys have otherPrimeInfos: sequence of (prime, exponent, coefficient)
+ if (version)
+ {
+  el = el->sibling;
+  if (!(el && el->is_sequence() && el->child)) return 0;
+  for (el = el->child; el; el = el->sibling)
+  {
+   if (count == pkc_rsa::MAX_PRIMES || !el->is_sequence()) return 0;
+   pkc_base::data_buffer *info = crt + 3*count;
+   const asn1::element *item = el->child;
+   if (!get_crt_component(info[0], modulus, item)) return 0;
+   item = item->sibling;
+   if (!get_crt_component(info[1], info[0], item)) return 0;
+   item = item->sibling;
+   if (!get_crt_component(info[2], info[0], item)) return 0;
+   count++;
+  }
+ }
+ // the CRT result is garbage if the primes don't match the modulus
+ bigint_t val_modulus = bigint_create_bytes_be(modulus.data, modulus.size);
+ bigint_t val_prod = bigint_create_bytes_be(crt[0].data, crt[0].size);
+ for (int i = 1; i < count; i++)
+ {
+  bigint_t val_prime = bigint_create_bytes_be(crt[3*i].data, crt[3*i].size);
+  bigint_mul(val_prod, val_prod, val_prime);
+  bigint_destroy(val_prime);
+ }
+ bool result = bigint_cmp(val_prod, val_modulus) == 0;
+ bigint_destroy(val_prod);
+ bigint_destroy(val_modulus);
+ return result? count : 0;
+}
+
 bool pkc_rsa::set_public_key(const void *data, size_t size, const asn1::element *param)
 {
  if (param && param->tag != asn1::TYPE_NULL) return false;
@@ -115,14 +220,21 @@ bool pkc_rsa::set_public_key(const void *data, size_t size, const asn1::element
   if (el && get_modulus(res_modulus, el))
   {
    el = el->sibling;
-   if (el && get_pub_exponent(res_pub_exp_large, res_pub_exp_small, res_modulus, el))
+   mont_ctx_t res_mont;
+   mont_init(&res_mont);
+   if (el && get_pub_exponent(res_pub_exp_large, res_pub_exp_small, res_modulus, el) &&
+       mont_set_modulus(&res_mont, res_modulus.data, res_modulus.size))
    {
     result = true;
     modulus = res_modulus;
     pub_exp_large = res_pub_exp_large;
     pub_exp_small = res_pub_exp_small;
+    mont_destroy(&mont_n);
+    mont_n = res_mont;
     // new public key is set, clear private key
     priv_exp.clear();
+    clear_crt();
+    disable_blinding();
    }
   }
  }
@@ -140,7 +252,7 @@ bool pkc_rsa::set_private_key(const void *data, size_t size, const asn1::element
  {
   const asn1::element *el = root->child;
   unsigned version;
-  if (el && el->get_small_uint(version) && version == 0)
+  if (el && el->get_small_uint(version) && version <= 1)
   {
    data_buffer res_modulus, res_pub_exp_large, res_priv_exp;
    unsigned res_pub_exp_small;
@@ -148,18 +260,48 @@ bool pkc_rsa::set_private_key(const void *data, size_t size, const asn1::element
    if (el && get_modulus(res_modulus, el))
    {
     el = el->sibling;
-    if (el && get_pub_exponent(res_pub_exp_large, res_pub_exp_small, res_modulus, el))
+    mont_ctx_t res_mont;
+    mont_init(&res_mont);
+    if (el && get_pub_exponent(res_pub_exp_large, res_pub_exp_small, res_modulus, el) &&
+        mont_set_modulus(&res_mont, res_modulus.data, res_modulus.size))
     {
      el = el->sibling;
      if (el && get_priv_exponent(res_priv_exp, res_modulus, el))
      {
-      result = true;
-      modulus = res_modulus;
-      pub_exp_large = res_pub_exp_large;
-      pub_exp_small = res_pub_exp_small;
-      priv_exp = res_priv_exp;
+      // CRT components are optional, without them the full private exponent is used;
+      // multi-prime (version 1) keys must have them
+      data_buffer res_crt[3*MAX_PRIMES];
+      int res_count = 0;
+      el = el->sibling;
+      if (el) res_count = get_crt_params(res_crt, res_modulus, version, el);
+      if (el? res_count != 0 : version == 0)
+      {
+       result = true;
+       modulus = res_modulus;
+       pub_exp_large = res_pub_exp_large;
+       pub_exp_small = res_pub_exp_small;
+       priv_exp = res_priv_exp;
+       mont_destroy(&mont_n);
+       mont_n = res_mont;
+       mont_init(&res_mont);
+       clear_crt();
+       disable_blinding();
+       if (res_count)
+       {
+        for (int i = 0; i < res_count; i++)
+        {
+         primes[i].prime = res_crt[3*i];
+         primes[i].exponent = res_crt[3*i+1];
+         primes[i].coefficient = res_crt[3*i+2];
+        }
+        prime_count = res_count;
+        // fall back to the private exponent if the primes can't be used
+        if (!init_crt()) clear_crt();
+       }
+      }
      }
     }
+    mont_destroy(&res_mont);
    }  
   }
  }
@@ -167,57 +309,183 @@ bool pkc_rsa::set_private_key(const void *data, size_t size, const asn1::element
  return result;
 }
 
+static const uint8_t *get_pub_exp_bytes(uint8_t buf[], size_t &size, unsigned small, const pkc_base::data_buffer &large)
+{
+ if (!small)
+ {
+  size = large.size;
+  return static_cast<const uint8_t*>(large.data);
+ }
+ buf[0] = small >> 24;
+ buf[1] = small >> 16;
+ buf[2] = small >> 8;
+ buf[3] = small;
+ size = 4;
+ return buf;
+}
+
 bool pkc_rsa::power_public(void *out, size_t &out_size, const void *in, size_t in_size) const
 {
- if (!modulus.data || in_size > modulus.size) return false;
+ if (!mont_n.size || in_size > modulus.size || out_size < modulus.size) return false;
  assert(pub_exp_large.data || pub_exp_small);
- bigint_t val_modulus = bigint_create_bytes_be(modulus.data, modulus.size);
- bigint_t val_public = pub_exp_small?
-  bigint_create_word(pub_exp_small) : bigint_create_bytes_be(pub_exp_large.data, pub_exp_large.size);
- bigint_t val_input = bigint_create_bytes_be(in, in_size);
- bigint_t val_result = bigint_create(0);
- bigint_mpow(val_result, val_input, val_public, val_modulus);
- size_t pad_size = 0;
- size_t result_size = bigint_get_byte_count(val_result);
- if (result_size < modulus.size)
- {
-  pad_size = modulus.size-result_size;
-  memset(out, 0, pad_size);
+ uint8_t exp_buf[4];
+ size_t exp_size;
+ const uint8_t *exp = get_pub_exp_bytes(exp_buf, exp_size, pub_exp_small, pub_exp_large);
+ sys_word_t *x = ALLOCA_WORDS(mont_n.size);
+ mont_load(x, mont_n.size, in, in_size);
+ mont_pow(&mont_n, x, x, exp, exp_size);
+ out_size = modulus.size;
+ return mont_store(out, out_size, x, mont_n.size) != 0;
+}
+
+bool pkc_rsa::power_private(void *out, size_t &out_size, const void *in, size_t in_size) const
+{
+ if (!priv_exp.data || in_size > modulus.size || out_size < modulus.size) return false;
+ assert(mont_n.size);
+ int size = mont_n.size;
+ sys_word_t *x = ALLOCA_WORDS(size);
+ sys_word_t *blind = ALLOCA_WORDS(size*2);
+ sys_word_t *tmp = ALLOCA_WORDS(MONT_TMP_WORDS(size));
+ mont_load(x, size, in, in_size);
+ bool blinded = get_blinding(blind, blind + size, tmp);
+ if (blinded) mont_mul(&mont_n, x, x, blind, tmp);             // x*r^e mod n
+ if (prime_count)
+ {
+  if (!power_private_crt(x, x)) return false;
+ } else
+  mont_pow_ct(&mont_n, x, x, priv_exp.data, priv_exp.size);
+ if (blinded) mont_mul(&mont_n, x, x, blind + size, tmp);      // x*r^-1 mod n
+ out_size = modulus.size;
+ return mont_store(out, out_size, x, size) != 0;
+}
+
+bool pkc_rsa::power_private_crt(sys_word_t *r, const sys_word_t *x) const
+{
+ int size = mont_n.size;
+ sys_word_t *tmp = ALLOCA_WORDS(MONT_TMP_WORDS(size));
+ sys_word_t *c = ALLOCA_WORDS(size);
+ sys_word_t *m = ALLOCA_WORDS(size);
+ sys_word_t *h = ALLOCA_WORDS(size);
+ sys_word_t *prod = ALLOCA_WORDS(size);
+ sys_word_t *t = ALLOCA_WORDS(size*2);
+ sys_word_t *mi = ALLOCA_WORDS(size*prime_count);
+ mont_to(&mont_n, c, x, tmp);
+ mont_from(&mont_n, c, c, tmp);                        // c < n
+ for (int i = 0; i < prime_count; i++)
+ {
+  const crt_prime &cp = primes[i];
+  sys_word_t *mp = mi + i*size;
+  mont_mod(&cp.mont, mp, c, size, tmp);
+  mont_pow_ct(&cp.mont, mp, mp, cp.exponent.data, cp.exponent.size);  // m_i = c^d_i mod r_i
  }
- int result = bigint_get_bytes_be(val_result, static_cast<uint8_t*>(out) + pad_size, out_size - pad_size);
- bigint_destroy(val_result);
- bigint_destroy(val_input);
- bigint_destroy(val_public);
- bigint_destroy(val_modulus);
- if (result < 0) return false;
- out_size = result + pad_size;
+ // Garner's recombination (RFC 8017 5.1.2): start with m = m_2 and prod = q,
+ // then for p and the other primes m += prod*((m_i - m)*coefficient mod r_i), prod *= r_i
+ int prod_size = primes[1].mont.size;
+ memset(m, 0, size*sizeof(sys_word_t));
+ memcpy(m, mi + size, prod_size*sizeof(sys_word_t));
+ memcpy(prod, primes[1].mont.n, prod_size*sizeof(sys_word_t));
+ for (int i = 0; i < prime_count; i++)
+ {
+  if (i == 1) continue;
+  const crt_prime &cp = primes[i];
+  int psize = cp.mont.size;
+  mont_mod(&cp.mont, h, m, size, tmp);
+  mont_sub(&cp.mont, h, mi + i*size, h);
+  mont_mul(&cp.mont, h, h, cp.coeff_mont, tmp);        // h = (m_i - m)*coefficient mod r_i
+  // the products are below n, so their words above size are zero
+  int t_size = prod_size + psize;
+  if (t_size > size) t_size = size;
+  words_mul(t, prod, prod_size, h, psize);
+  words_add(m, m, size, t, t_size);
+  if (i + 1 < prime_count)
+  {
+   words_mul(t, prod, prod_size, cp.mont.n, psize);
+   prod_size = t_size;
+   memcpy(prod, t, prod_size*sizeof(sys_word_t));
+  }
+ }
+ // recombination check: a fault in one of the residues would leak the factorization
+ uint8_t exp_buf[4];
+ size_t exp_size;
+ const uint8_t *exp = get_pub_exp_bytes(exp_buf, exp_size, pub_exp_small, pub_exp_large);
+ sys_word_t *check = ALLOCA_WORDS(size);
+ mont_pow(&mont_n, check, m, exp, exp_size);
+ if (words_cmp(check, c, size)) return false;
+ memcpy(r, m, size*sizeof(sys_word_t));
  return true;
 }
 
-bool pkc_rsa::power_private(void *out, size_t &out_size, const void *in, size_t in_size) const
+bool pkc_rsa::get_blinding(sys_word_t *a, sys_word_t *ai, sys_word_t *tmp) const
+{
+ mutex_locker ml(blinding_lock);
+ if (!blinding) return false;
+ int size = mont_n.size;
+ memcpy(a, blinding, size*sizeof(sys_word_t));
+ memcpy(ai, blinding + size, size*sizeof(sys_word_t));
+ // (r^2)^e and r^-2 for the next call
+ mont_sqr(&mont_n, blinding, a, tmp);
+ mont_sqr(&mont_n, blinding + size, ai, tmp);
+ return true;
+}
+
+bool pkc_rsa::enable_blinding(random_gen *rng)
 {
- if (!priv_exp.data) return false;
- assert(modulus.data);
+ if (!priv_exp.data || !rng) return false;
+ int size = mont_n.size;
+ sys_word_t *tmp = ALLOCA_WORDS(MONT_TMP_WORDS(size));
+ uint8_t *buf = static_cast<uint8_t*>(alloca(modulus.size));
  bigint_t val_modulus = bigint_create_bytes_be(modulus.data, modulus.size);
- bigint_t val_private = bigint_create_bytes_be(priv_exp.data, priv_exp.size);
- bigint_t val_input = bigint_create_bytes_be(in, in_size);
- bigint_t val_result = bigint_create(0);
- bigint_mpow(val_result, val_input, val_private, val_modulus);
- size_t pad_size = 0;
- size_t result_size = bigint_get_byte_count(val_result);
- if (result_size < modulus.size)
- {
-  pad_size = modulus.size-result_size;
-  memset(out, 0, pad_size);
+ bigint_t val_r = bigint_create(0);
+ bigint_t val_ri = bigint_create(0);
+ bool result = false;
+ // r is coprime to n unless it hits a factor, a few attempts are enough
+ for (int i = 0; i < 8 && !result; i++)
+ {
+  if (!rng->get_secure_random(buf, modulus.size)) break;
+  bigint_set_bytes_be(val_r, buf, modulus.size);
+  bigint_mod(val_r, val_r, val_modulus);
+  result = !bigint_eq_word(val_r, 0) && bigint_minv(val_ri, val_r, val_modulus);
  }
- int result = bigint_get_bytes_be(val_result, static_cast<uint8_t*>(out) + pad_size, out_size - pad_size);
- bigint_destroy(val_result);
- bigint_destroy(val_input);
- bigint_destroy(val_private);
+ if (result)
+ {
+  uint8_t exp_buf[4];
+  size_t exp_size;
+  const uint8_t *exp = get_pub_exp_bytes(exp_buf, exp_size, pub_exp_small, pub_exp_large);
+  sys_word_t *pair = new sys_word_t[size*2];
+  sys_word_t *prev;
+  // both halves are kept multiplied by R
+  int count = bigint_get_byte_count(val_r);
+  bigint_get_bytes_be(val_r, buf, count);
+  mont_load(pair, size, buf, count);
+  mont_pow(&mont_n, pair, pair, exp, exp_size);
+  mont_to(&mont_n, pair, pair, tmp);
+  count = bigint_get_byte_count(val_ri);
+  bigint_get_bytes_be(val_ri, buf, count);
+  mont_load(pair + size, size, buf, count);
+  mont_to(&mont_n, pair + size, pair + size, tmp);
+  {
+   mutex_locker ml(blinding_lock);
+   prev = blinding;
+   blinding = pair;
+  }
+  delete[] prev;
+ }
+ memset(buf, 0, modulus.size);
+ bigint_destroy(val_ri);
+ bigint_destroy(val_r);
  bigint_destroy(val_modulus);
- if (result < 0) return false;
- out_size = result + pad_size;
- return true;
+ return result;
+}
+
+void pkc_rsa::disable_blinding()
+{
+ sys_word_t *pair;
+ {
+  mutex_locker ml(blinding_lock);
+  pair = blinding;
+  blinding = nullptr;
+ }
+ delete[] pair;
 }
 
 static void mgf1(uint8_t *out, size_t out_size, const void *seed, size_t seed_len, const hash_def *hd)
@@ -592,40 +860,44 @@ static const uint8_t *decode_v15_wrapping(const uint8_t *data, size_t size, int
  return result;
 }
 
-bool pkc_rsa::verify_signature(const void *sig, size_t sig_size,
-                               const void *data, size_t data_size,
-                               const param_data *params, int param_count) const
+struct rsa_verify_params
 {
- if (!modulus.data) return false;
- const hash_def *hd_hash = nullptr;
- const hash_def *hd_mgf = nullptr;
- int salt_len = -1;
- uint8_t top_mask;
- uint8_t digest[MAX_DIGEST_SIZE];
- bool result;
- int enc_alg = ID_RSA, hash_alg = 0;
+ int enc_alg;
+ const hash_def *hd_hash;
+ const hash_def *hd_mgf;
+ int salt_len;
+ bool data_is_hash;
+ bool raw_signature;
+};
+
+static bool get_verify_params(rsa_verify_params &vp, const pkc_base::param_data *params, int param_count)
+{
+ int hash_alg = 0;
  const asn1::element *alg_info = nullptr;
  const asn1::element *alg_param = nullptr;
  bool data_is_hash = false;
  bool raw_signature = false;
+ vp.enc_alg = ID_RSA;
+ vp.hd_hash = vp.hd_mgf = nullptr;
+ vp.salt_len = -1;
 
  for (int i = 0; i < param_count; i++)
   switch (params[i].type)
   {
-   case PARAM_DATA_IS_HASH:
+   case pkc_base::PARAM_DATA_IS_HASH:
     GET_BOOL_PARAM(data_is_hash);
     break;
 
-   case PARAM_HASH_ALG:
+   case pkc_base::PARAM_HASH_ALG:
     GET_INT_PARAM(hash_alg);
     break;
 
-   case PARAM_ALG_INFO:
+   case pkc_base::PARAM_ALG_INFO:
     if (params[i].size) return false;
     alg_info = static_cast<const asn1::element*>(params[i].data);
     break;
 
-   case PARAM_RAW_SIGNATURE:
+   case pkc_rsa::PARAM_RAW_SIGNATURE:
     GET_BOOL_PARAM(raw_signature);
     break;
 
@@ -633,15 +905,16 @@ bool pkc_rsa::verify_signature(const void *sig, size_t sig_size,
     return false;
   }
 
+ vp.data_is_hash = data_is_hash;
+ vp.raw_signature = raw_signature;
  if (raw_signature)
  {
-  if (sig_size != modulus.size) return false;
-  enc_alg = 0;
+  vp.enc_alg = 0;
   alg_info = nullptr;
  }
 
- if (alg_info && !parse_alg_id(enc_alg, alg_param, alg_info)) return false;
- if (enc_alg == ID_RSASSA_PSS)
+ if (alg_info && !parse_alg_id(vp.enc_alg, alg_param, alg_info)) return false;
+ if (vp.enc_alg == ID_RSASSA_PSS)
  {
   hash_alg = ID_HASH_SHA1;
   int mg_hash_alg = ID_HASH_SHA1;
@@ -663,7 +936,7 @@ bool pkc_rsa::verify_signature(const void *sig, size_t sig_size,
       if (!parse_mg_alg(mg_hash_alg, el)) return false;
       break;
      case 2:
-      if (!parse_salt_len(salt_len, el)) return false;
+      if (!parse_salt_len(vp.salt_len, el)) return false;
       break;
      case 3:
       if (!parse_trailer(el)) return false;
@@ -672,35 +945,52 @@ bool pkc_rsa::verify_signature(const void *sig, size_t sig_size,
     prev_tag = tag;
    }
   }
-  hd_hash = hash_factory(hash_alg);
-  if (!hd_hash) return false;
-  hd_mgf = hash_factory(mg_hash_alg);
-  if (!hd_mgf) return false;
-  if (salt_len < 0) salt_len = hd_hash->hash_size;
-  if (static_cast<size_t>(hd_hash->hash_size) > sig_size - 2) return false;
-  if (static_cast<size_t>(salt_len) > sig_size - (hd_hash->hash_size + 2)) return false;
-  int top_bit = bsr32(static_cast<const uint8_t*>(modulus.data)[0]);
-  top_mask = 0xFF >> (8-top_bit);
-  if (data_is_hash && hd_hash->hash_size != data_size) return false;
-  assert(hd_hash->hash_size <= MAX_DIGEST_SIZE);
+  vp.hd_hash = hash_factory(hash_alg);
+  if (!vp.hd_hash) return false;
+  vp.hd_mgf = hash_factory(mg_hash_alg);
+  if (!vp.hd_mgf) return false;
+  if (vp.salt_len < 0) vp.salt_len = vp.hd_hash->hash_size;
+  assert(vp.hd_hash->hash_size <= MAX_DIGEST_SIZE);
  } else
  if (!raw_signature)
  {
-  if (alg_info) hash_alg = sign_oid_to_hash_oid(enc_alg);
+  if (alg_info) hash_alg = pkc_rsa::sign_oid_to_hash_oid(vp.enc_alg);
   if (!hash_alg) return false;
-  hd_hash = hash_factory(hash_alg);
-  if (!hd_hash) return false;
-  if (data_is_hash && hd_hash->hash_size != data_size) return false;
-  assert(hd_hash->hash_size <= MAX_DIGEST_SIZE);
+  vp.hd_hash = hash_factory(hash_alg);
+  if (!vp.hd_hash) return false;
+  assert(vp.hd_hash->hash_size <= MAX_DIGEST_SIZE);
  }
+ return true;
+}
 
+// Checks that don't need the decrypted signature
+static bool check_verify_sizes(const rsa_verify_params &vp, size_t modulus_size, size_t sig_size, size_t data_size)
+{
+ if (sig_size > modulus_size) return false;
+ if (vp.raw_signature) return sig_size == modulus_size;
+ const hash_def *hd_hash = vp.hd_hash;
+ if (vp.enc_alg == ID_RSASSA_PSS)
+ {
+  if (static_cast<size_t>(hd_hash->hash_size) > sig_size - 2) return false;
+  if (static_cast<size_t>(vp.salt_len) > sig_size - (hd_hash->hash_size + 2)) return false;
+ }
+ return !vp.data_is_hash || hd_hash->hash_size == data_size;
+}
+
+// Checks the padding of the decrypted signature out, which has modulus.size bytes
+static bool check_encoded_signature(const rsa_verify_params &vp, const pkc_base::data_buffer &modulus,
+                                    uint8_t *out, size_t sig_size, const void *data, size_t data_size)
+{
+ const hash_def *hd_hash = vp.hd_hash;
+ uint8_t digest[MAX_DIGEST_SIZE];
  size_t out_size = modulus.size;
- uint8_t *out = static_cast<uint8_t*>(alloca(out_size));
- if (!power_public(out, out_size, sig, sig_size)) return false;
- assert(out_size == modulus.size);
+ int salt_len = vp.salt_len;
+ bool result;
 
- if (enc_alg == ID_RSASSA_PSS)
+ if (vp.enc_alg == ID_RSASSA_PSS)
  {
+  int top_bit = bsr32(static_cast<const uint8_t*>(modulus.data)[0]);
+  uint8_t top_mask = 0xFF >> (8-top_bit);
   if (!top_mask)
   {
    out++;
@@ -713,7 +1003,7 @@ bool pkc_rsa::verify_signature(const void *sig, size_t sig_size,
   size_t mask_len = out_size - (hd_hash->hash_size + 1);
   const uint8_t *hash = out + mask_len;
   uint8_t *mask = static_cast<uint8_t*>(alloca(mask_len));
-  mgf1(mask, mask_len, hash, hd_hash->hash_size, hd_mgf);
+  mgf1(mask, mask_len, hash, hd_hash->hash_size, vp.hd_mgf);
   xor_data(out, mask, mask_len);
   out[0] &= top_mask;
   size_t pad_len = mask_len - salt_len - 1;
@@ -721,7 +1011,7 @@ bool pkc_rsa::verify_signature(const void *sig, size_t sig_size,
 
   void *ctx = alloca(hd_hash->context_size);
   const void *use_digest;
-  if (data_is_hash)
+  if (vp.data_is_hash)
   {
    use_digest = data;
   } else
@@ -741,7 +1031,7 @@ bool pkc_rsa::verify_signature(const void *sig, size_t sig_size,
  {
   size_t pad_len = decode_v15_sign_padding(out, out_size);
   if (!pad_len) return false;
-  if (raw_signature)
+  if (vp.raw_signature)
   {
    if (sig_size - pad_len != data_size) return false;
    result = memcmp(out + pad_len, data, data_size) == 0;
@@ -751,7 +1041,7 @@ bool pkc_rsa::verify_signature(const void *sig, size_t sig_size,
    const void *hash = decode_v15_wrapping(out + pad_len, out_size - pad_len, hd_hash->id, hash_size);
    if (!hash || static_cast<int>(hash_size) != hd_hash->hash_size) return false;
    const void *use_digest;
-   if (data_is_hash)
+   if (vp.data_is_hash)
    {
     use_digest = data;
    } else
@@ -769,6 +1059,98 @@ bool pkc_rsa::verify_signature(const void *sig, size_t sig_size,
  return result;
 }
 
+bool pkc_rsa::verify_signature(const void *sig, size_t sig_size,
+                               const void *data, size_t data_size,
+                               const param_data *params, int param_count) const
+{
+ if (!modulus.data) return false;
+ rsa_verify_params vp;
+ if (!get_verify_params(vp, params, param_count) ||
+     !check_verify_sizes(vp, modulus.size, sig_size, data_size)) return false;
+
+ size_t out_size = modulus.size;
+ uint8_t *out = static_cast<uint8_t*>(alloca(out_size));
+ if (!power_public(out, out_size, sig, sig_size)) return false;
+ assert(out_size == modulus.size);
+ return check_encoded_signature(vp, modulus, out, sig_size, data, data_size);
+}
+
+bool pkc_rsa::same_public_exponent(const pkc_rsa *other) const
+{
+ if (pub_exp_small || other->pub_exp_small) return pub_exp_small == other->pub_exp_small;
+ return pub_exp_large.size == other->pub_exp_large.size &&
+        !memcmp(pub_exp_large.data, other->pub_exp_large.data, pub_exp_large.size);
+}
+
+size_t pkc_rsa::verify_signatures(bool *results, const verify_item *items, size_t count,
+                                  const param_data *params, int param_count)
+{
+ size_t i, j, valid = 0;
+ for (i = 0; i < count; i++) results[i] = false;
+ rsa_verify_params vp;
+ if (!count || !get_verify_params(vp, params, param_count)) return 0;
+
+ bool *pending = new bool[count];
+ int max_size = 0;
+ for (i = 0; i < count; i++)
+ {
+  const pkc_rsa *key = items[i].key;
+  pending[i] = key && key->mont_n.size &&
+   check_verify_sizes(vp, key->modulus.size, items[i].sig_size, items[i].data_size);
+  if (pending[i] && key->mont_n.size > max_size) max_size = key->mont_n.size;
+ }
+
+ // keys of the same size and exponent go through the SIMD lanes together
+ const mont_ctx_t *ctx[MONT_MB_MAX_LANES];
+ sys_word_t *x[MONT_MB_MAX_LANES];
+ size_t index[MONT_MB_MAX_LANES];
+ sys_word_t *words = new sys_word_t[max_size*MONT_MB_MAX_LANES];
+ uint8_t *out = new uint8_t[max_size*sizeof(sys_word_t)];
+ for (i = 0; i < count; i++)
+ {
+  if (!pending[i]) continue;
+  const pkc_rsa *key = items[i].key;
+  int size = key->mont_n.size;
+  int lanes = mont_pow_mb_lanes(size);
+  int group_count = 0;
+  index[group_count++] = i;
+  for (j = i + 1; j < count && group_count < lanes; j++)
+   if (pending[j] && items[j].key->mont_n.size == size && items[j].key->same_public_exponent(key))
+   {
+    index[group_count++] = j;
+    pending[j] = false;
+   }
+  if (group_count > 1)
+  {
+   uint8_t exp_buf[4];
+   size_t exp_size;
+   const uint8_t *exp = get_pub_exp_bytes(exp_buf, exp_size, key->pub_exp_small, key->pub_exp_large);
+   for (int k = 0; k < group_count; k++)
+   {
+    ctx[k] = &items[index[k]].key->mont_n;
+    x[k] = words + k*size;
+    mont_load(x[k], size, items[index[k]].sig, items[index[k]].sig_size);
+   }
+   mont_pow_mb(ctx, x, x, group_count, exp, exp_size);
+  }
+  for (int k = 0; k < group_count; k++)
+  {
+   const verify_item &item = items[index[k]];
+   const data_buffer &modulus = item.key->modulus;
+   size_t out_size = modulus.size;
+   bool ok = group_count > 1?
+    mont_store(out, out_size, x[k], size) != 0 :
+    key->power_public(out, out_size, item.sig, item.sig_size);
+   results[index[k]] = ok && check_encoded_signature(vp, modulus, out, item.sig_size, item.data, item.data_size);
+   if (results[index[k]]) valid++;
+  }
+ }
+ delete[] out;
+ delete[] words;
+ delete[] pending;
+ return valid;
+}
+
 int pkc_rsa::get_key_bits() const
 {
  return get_bits(modulus);
@@ -2,6 +2,8 @@
 #define __pkc_rsa_h__
 
 #include "pkc_base.h"
+#include "mont.h"
+#include <utils/mutex.h>
 
 class pkc_rsa : public pkc_base
 {
@@ -13,9 +15,24 @@ class pkc_rsa : public pkc_base
    PARAM_SALT,
    PARAM_RAW_SIGNATURE
   };
+
+  // RFC 8017 multi-prime keys, 4096-bit keys with 3 or 4 primes sign faster
+  enum
+  {
+   MAX_PRIMES = 5
+  };
+
+  struct verify_item
+  {
+   const pkc_rsa *key;
+   const void *sig;
+   size_t sig_size;
+   const void *data;
+   size_t data_size;
+  };
   
   pkc_rsa();
-  virtual ~pkc_rsa() {}
+  virtual ~pkc_rsa();
   virtual int  get_id() const;
   virtual bool set_public_key(const void *data, size_t size, const asn1::element *param);
   virtual bool set_private_key(const void *data, size_t size, const asn1::element *param);
@@ -35,15 +52,50 @@ class pkc_rsa : public pkc_base
   // in == out is allowed
   bool power_public(void *out, size_t &out_size, const void *in, size_t in_size) const;
   bool power_private(void *out, size_t &out_size, const void *in, size_t in_size) const;
+  // Base blinding of power_private. The pair (r^e, r^-1) is made once from rng and
+  // squared after every use, so blinding costs two multiplications and two squarings
+  // per operation.
+  // Setting a new key turns it off. Returns false if there is no private key.
+  bool enable_blinding(random_gen *rng);
+  void disable_blinding();
   size_t get_modulus_size() const { return modulus.size; }
   static int sign_oid_to_hash_oid(int id);
   static int hash_oid_to_sign_oid(int id);
+
+  // Verifies a batch of signatures with the same params, results[i] is set for every item.
+  // Keys of the same size and public exponent share the SIMD lanes of mont_pow_mb.
+  // Returns the number of valid signatures.
+  static size_t verify_signatures(bool *results, const verify_item *items, size_t count,
+                                  const param_data *params, int param_count);
  
  private:
   data_buffer modulus;
   data_buffer pub_exp_large;
   unsigned pub_exp_small;
   data_buffer priv_exp;  
+  // CRT components in the key order: p (with qInv), q, then the other primes
+  // with their coefficients (r_1*...*r_{i-1})^-1 mod r_i
+  struct crt_prime
+  {
+   data_buffer prime;
+   data_buffer exponent;
+   data_buffer coefficient; // empty for q
+   mont_ctx_t mont;
+   sys_word_t *coeff_mont;  // coefficient*R mod prime
+  };
+  crt_prime primes[MAX_PRIMES];
+  int prime_count; // 0 if the key has only the private exponent
+  // precomputed for the current key
+  mont_ctx_t mont_n;
+  // r^e*R and r^-1*R mod n, null if blinding is off
+  sys_word_t *blinding;
+  mutable mutex blinding_lock;
+
+  bool same_public_exponent(const pkc_rsa *other) const;
+  void clear_crt();
+  bool init_crt();
+  bool power_private_crt(sys_word_t *r, const sys_word_t *x) const;
+  bool get_blinding(sys_word_t *a, sys_word_t *ai, sys_word_t *tmp) const;
 };
 
 #endif // __pkc_rsa_h__
@@ -0,0 +1,84 @@
+#include "pkc_x25519.h"
+#include <crypto/asn1/decoder.h>
+#include <crypto/ec/ec_mont.h>
+#include <crypto/oid_const.h>
+#include <string.h>
+
+pkc_x25519::pkc_x25519()
+{
+ has_priv = has_pub = false;
+}
+
+pkc_x25519::~pkc_x25519()
+{
+ clear();
+}
+
+int pkc_x25519::get_id() const
+{
+ return oid::ID_X25519;
+}
+
+void pkc_x25519::clear()
+{
+ memset(priv, 0, sizeof(priv));
+ has_priv = has_pub = false;
+}
+
+bool pkc_x25519::set_public_key(const void *data, size_t size, const asn1::element *param)
+{
+ if (param || size != KEY_SIZE) return false;
+ clear();
+ memcpy(pub, data, KEY_SIZE);
+ has_pub = true;
+ return true;
+}
+
+bool pkc_x25519::set_private_key(const void *data, size_t size, const asn1::element *param)
+{
+ if (param) return false;
+ asn1::element *root = asn1::decode(data, size, 0, nullptr);
+ if (!root) return false;
+ bool result = false;
+ if (root->is_octet_string() && root->size == KEY_SIZE)
+ {
+  clear();
+  memcpy(priv, root->data, KEY_SIZE);
+  ec_x25519_base(pub, priv);
+  has_priv = has_pub = true;
+  result = true;
+ }
+ asn1::delete_tree(root);
+ return result;
+}
+
+bool pkc_x25519::generate_key(random_gen *rng)
+{
+ uint8_t new_priv[KEY_SIZE];
+ if (!rng->get_secure_random(new_priv, KEY_SIZE)) return false;
+ clear();
+ memcpy(priv, new_priv, KEY_SIZE);
+ memset(new_priv, 0, KEY_SIZE);
+ ec_x25519_base(pub, priv);
+ has_priv = has_pub = true;
+ return true;
+}
+
+bool pkc_x25519::get_public_key(void *out) const
+{
+ if (!has_pub) return false;
+ memcpy(out, pub, KEY_SIZE);
+ return true;
+}
+
+bool pkc_x25519::compute_shared_secret(void *out, const void *peer_key, size_t peer_key_size) const
+{
+ if (!has_priv || peer_key_size != KEY_SIZE) return false;
+ return ec_x25519(static_cast<uint8_t*>(out), priv, static_cast<const uint8_t*>(peer_key)) != 0;
+}
+
+bool pkc_x25519::compute_shared_secret(void *out, const pkc_x25519 &peer) const
+{
+ if (!peer.has_pub) return false;
+ return compute_shared_secret(out, peer.pub, KEY_SIZE);
+}
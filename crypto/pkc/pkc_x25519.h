@@ -0,0 +1,42 @@
+#ifndef __pkc_x25519_h__
+#define __pkc_x25519_h__
+
+#include <crypto/rng/random_gen.h>
+#include <crypto/asn1/element.h>
+#include <stdint.h>
+
+// X25519 key agreement (RFC 7748), keys are encoded as in RFC 8410
+class pkc_x25519
+{
+ public:
+  enum
+  {
+   KEY_SIZE = 32
+  };
+
+  pkc_x25519();
+  ~pkc_x25519();
+  int  get_id() const;
+  // subjectPublicKey contents, param must be absent
+  bool set_public_key(const void *data, size_t size, const asn1::element *param);
+  // PKCS #8 privateKey contents (CurvePrivateKey)
+  bool set_private_key(const void *data, size_t size, const asn1::element *param);
+  bool generate_key(random_gen *rng);
+  // KEY_SIZE bytes
+  bool get_public_key(void *out) const;
+  // Writes KEY_SIZE bytes to out. Fails if the peer key has small order.
+  bool compute_shared_secret(void *out, const void *peer_key, size_t peer_key_size) const;
+  bool compute_shared_secret(void *out, const pkc_x25519 &peer) const;
+
+ private:
+  uint8_t priv[KEY_SIZE];
+  uint8_t pub[KEY_SIZE];
+  bool has_priv;
+  bool has_pub;
+
+  void clear();
+  pkc_x25519(const pkc_x25519 &);
+  pkc_x25519& operator= (const pkc_x25519 &);
+};
+
+#endif // __pkc_x25519_h__
@@ -4,6 +4,7 @@
 #include <crypto/asn1/decoder.h>
 #include <crypto/pkc/pkc_rsa.h>
 #include <crypto/rng/std_random.h>
+#include <crypto/utils/gen_prime.h>
 #include <utils/str_int_cvt.h>
 #include <string.h>
 #include <stdio.h>
@@ -17,11 +18,16 @@ enum
  ACTION_POWER_PUB,
  ACTION_POWER_PRIV,
  ACTION_CERT_VERIFY,
- ACTION_CERT_SIGN
+ ACTION_CERT_SIGN,
+ ACTION_GEN_KEY
 };
 
 static const int MAX_SIGN_PARAMS = 10;
 
+static const unsigned MIN_KEY_BITS = 512;
+static const unsigned MAX_KEY_BITS = 16384;
+static const unsigned PUB_EXP = 65537;
+
 static bool verify_certificate(const void *data, size_t size, const pkc_base &pk, bool &verify_result)
 {
  verify_result = false;
@@ -39,9 +45,13 @@ static bool verify_certificate(const void *data, size_t size, const pkc_base &pk
     const asn1::element *sig = sig_alg->sibling;
     if (sig && sig->is_aligned_bit_string())
     {
+     pkc_base::param_data param;
+     param.type = pkc_base::PARAM_ALG_INFO;
+     param.data = sig_alg;
+     param.size = 0;
      result = true;
      verify_result = pk.verify_signature(sig->data + 1, sig->size - 1,
-      root->data, tbs_cert->size + (tbs_cert->data - root->data), sig_alg);
+      root->data, tbs_cert->size + (tbs_cert->data - root->data), &param, 1);
     }
    }
   }
@@ -65,7 +75,8 @@ static void *encode_asn1(asn1::element *el, size_t &size)
 }
 
 static bool sign_certificate(void* &out_data, size_t &out_size, const void *data, size_t size,
-                             const pkc_rsa &rsa, const pkc_base::param_data params[], int param_count)
+                             const pkc_rsa &rsa, const pkc_base::param_data params[], int param_count,
+                             random_gen *rng)
 {
  out_data = nullptr;
  out_size = 0;
@@ -123,7 +134,7 @@ static bool sign_certificate(void* &out_data, size_t &out_size, const void *data
  void *encoded_data = encode_asn1(tbs_cert, encoded_size);
  size_t sign_size = rsa.get_modulus_size();
  uint8_t *sign_data = static_cast<uint8_t*>(alloca(sign_size + 1));
- bool result = rsa.create_signature(sign_data + 1, sign_size, encoded_data, encoded_size, params, param_count);
+ bool result = rsa.create_signature(sign_data + 1, sign_size, encoded_data, encoded_size, params, param_count, rng);
  operator delete(encoded_data);
  if (!result)
  {
@@ -140,6 +151,135 @@ static bool sign_certificate(void* &out_data, size_t &out_size, const void *data
  return true;
 }
 
+// limits on the number of primes are the same as in OpenSSL
+static int get_max_primes(unsigned nbits)
+{
+ if (nbits < 1024) return 2;
+ if (nbits < 4096) return 3;
+ if (nbits < 8192) return 4;
+ return pkc_rsa::MAX_PRIMES;
+}
+
+static asn1::element *create_integer(const bigint_t val)
+{
+ // one more byte for the sign bit
+ size_t size = bigint_get_bit_count(val)/8 + 1;
+ size_t val_size = bigint_get_byte_count(val);
+ asn1::element *el = asn1::element::create_with_buf(asn1::TYPE_INTEGER, size);
+ uint8_t *data = const_cast<uint8_t*>(el->data);
+ memset(data, 0, size - val_size);
+ if (val_size) bigint_get_bytes_be(val, data + size - val_size, val_size);
+ return el;
+}
+
+static asn1::element *create_sequence(asn1::element *const items[], int count)
+{
+ asn1::element *el = asn1::element::create(asn1::TYPE_SEQUENCE);
+ el->child = items[0];
+ for (int i = 0; i + 1 < count; i++)
+  items[i]->sibling = items[i+1];
+ return el;
+}
+
+// RSAPrivateKey (RFC 8017 A.1.2), version 1 with otherPrimeInfos if nprimes > 2
+static void *generate_key(size_t &out_size, unsigned nbits, int nprimes, random_gen *rng)
+{
+ bigint_t primes[pkc_rsa::MAX_PRIMES];
+ bigint_t n = bigint_create_word(1);
+ bigint_t t = bigint_create(0);
+ int count = 0;
+ unsigned attempt = 0;
+ while (count < nprimes)
+ {
+  // the last prime brings the modulus to nbits, its size is off by one
+  // from the remaining bits depending on the top bits of the product
+  unsigned prime_bits = count + 1 < nprimes?
+   nbits/nprimes : nbits - bigint_get_bit_count(n) + (attempt++ & 1);
+  bigint_t p = gen_prime(prime_bits, rng, nullptr, nullptr);
+  if (!p) break;
+  // e must be coprime to p - 1
+  bool ok = bigint_modw(p, PUB_EXP) != 1;
+  for (int i = 0; ok && i < count; i++)
+   if (!bigint_cmp(p, primes[i])) ok = false;
+  if (ok)
+  {
+   bigint_mul(t, n, p);
+   if (count + 1 == nprimes && bigint_get_bit_count(t) != (int) nbits) ok = false;
+  }
+  if (!ok)
+  {
+   bigint_destroy(p);
+   continue;
+  }
+  bigint_copy(n, t);
+  primes[count++] = p;
+ }
+
+ void *out = nullptr;
+ if (count == nprimes)
+ {
+  bigint_t e = bigint_create_word(PUB_EXP);
+  bigint_t d = bigint_create(0);
+  bigint_t phi = bigint_create_word(1);
+  bigint_t prod = bigint_create(0);
+  bigint_t x = bigint_create(0);
+  for (int i = 0; i < count; i++)
+  {
+   bigint_subw(t, primes[i], 1);
+   bigint_mul(phi, phi, t);
+  }
+  bigint_minv(d, e, phi);
+  asn1::element *key[10];
+  asn1::element *other[pkc_rsa::MAX_PRIMES];
+  bigint_set_word(t, nprimes > 2? 1 : 0);
+  key[0] = create_integer(t);
+  key[1] = create_integer(n);
+  key[2] = create_integer(e);
+  key[3] = create_integer(d);
+  key[4] = create_integer(primes[0]);
+  key[5] = create_integer(primes[1]);
+  for (int i = 0; i < count; i++)
+  {
+   asn1::element *info[3];
+   bigint_subw(t, primes[i], 1);
+   bigint_mod(x, d, t);
+   info[1] = create_integer(x);
+   // qInv = q^-1 mod p, other coefficients are (r_1*...*r_{i-1})^-1 mod r_i
+   if (i != 1)
+   {
+    if (i == 0) bigint_copy(prod, primes[1]);
+    bigint_mod(t, prod, primes[i]);
+    bigint_minv(x, t, primes[i]);
+    info[2] = create_integer(x);
+    bigint_mul(prod, prod, primes[i]);
+   }
+   if (i < 2)
+   {
+    key[6 + i] = info[1];
+    if (i == 0) key[8] = info[2];
+    continue;
+   }
+   info[0] = create_integer(primes[i]);
+   other[i-2] = create_sequence(info, 3);
+  }
+  int key_count = 9;
+  if (count > 2) key[key_count++] = create_sequence(other, count - 2);
+  asn1::element *root = create_sequence(key, key_count);
+  out = encode_asn1(root, out_size);
+  asn1::delete_tree(root);
+  bigint_destroy(x);
+  bigint_destroy(prod);
+  bigint_destroy(phi);
+  bigint_destroy(d);
+  bigint_destroy(e);
+ }
+ for (int i = 0; i < count; i++)
+  bigint_destroy(primes[i]);
+ bigint_destroy(t);
+ bigint_destroy(n);
+ return out;
+}
+
 static const struct
 {
  const char *name;
@@ -310,6 +450,8 @@ int main(int argc, char *argv[])
          "  -cert-verify                     Verify RSA signature on X.509 certificate\n"
          "  -cert-sign                       Sign X.509 certificate\n"
          "  -sign-param <param>:<value>      Set signature parameters\n"
+         "  -gen-key <bits>                  Generate RSA private key\n"
+         "  -primes <count>                  Set number of primes for -gen-key (default is 2)\n"
          "  -in-file  { <file> | stdin  }    Read input from file\n"
          "  -out-file { <file> | stdout }    Write output to file (default is stdout)\n"
          "  -in-fmt  { bin | hex | base64 }  Set format of the input\n"
@@ -327,6 +469,8 @@ int main(int argc, char *argv[])
  const char *priv_file = nullptr;
  const char *in_file = nullptr;
  const char *out_file = nullptr;
+ unsigned key_bits = 0;
+ int key_primes = 0;
  int action = ACTION_NONE;
  int last_arg = argc-1;
  for (int i=1; i<=last_arg; i++)
@@ -381,6 +525,34 @@ int main(int argc, char *argv[])
    if (action != ACTION_NONE) goto error_inconsistent;
    action = ACTION_CERT_SIGN;
   } else
+  if (!strcmp(argv[i], "-gen-key"))
+  {
+   if (i == last_arg) goto error_arg_required;
+   if (action == ACTION_GEN_KEY) goto error_duplicate;
+   if (action != ACTION_NONE) goto error_inconsistent;
+   bool ok;
+   key_bits = str_to_uint32(argv[i+1], nullptr, &ok);
+   if (!ok || key_bits < MIN_KEY_BITS || key_bits > MAX_KEY_BITS)
+   {
+    fprintf(stderr, "%s: number of bits must be in range %u to %u\n", argv[i], MIN_KEY_BITS, MAX_KEY_BITS);
+    return 2;
+   }
+   action = ACTION_GEN_KEY;
+   i++;
+  } else
+  if (!strcmp(argv[i], "-primes"))
+  {
+   if (i == last_arg) goto error_arg_required;
+   if (key_primes) goto error_duplicate;
+   bool ok;
+   key_primes = str_to_uint32(argv[i+1], nullptr, &ok);
+   if (!ok || key_primes < 2 || key_primes > pkc_rsa::MAX_PRIMES)
+   {
+    fprintf(stderr, "%s: number of primes must be in range 2 to %d\n", argv[i], pkc_rsa::MAX_PRIMES);
+    return 2;
+   }
+   i++;
+  } else
   if (!strcmp(argv[i], "-sign-param"))
   {
    if (i == last_arg) goto error_arg_required;
@@ -426,9 +598,43 @@ int main(int argc, char *argv[])
 
  if (action == ACTION_NONE)
  {
-  fprintf(stderr, "Use -power-pub, -power-priv, -cert-verify or -cert-sign\n");
+  fprintf(stderr, "Use -power-pub, -power-priv, -cert-verify, -cert-sign or -gen-key\n");
   return 2;
  }
+ if (key_primes && action != ACTION_GEN_KEY)
+ {
+  fprintf(stderr, "-primes can only be used with -gen-key\n");
+  return 2;
+ }
+ if (action == ACTION_GEN_KEY)
+ {
+  if (!key_primes) key_primes = 2;
+  if (key_primes > get_max_primes(key_bits))
+  {
+   fprintf(stderr, "%u-bit key can have at most %d primes\n", key_bits, get_max_primes(key_bits));
+   return 2;
+  }
+  bool use_stdout = !out_file || strcmp(out_file, "stdout") == 0;
+  if (out_fmt == FORMAT_DEFAULT) out_fmt = FORMAT_BASE64;
+  printf("Generating %u-bit RSA key with %d primes\n", key_bits, key_primes);
+  size_t out_size;
+  void *out_data = generate_key(out_size, key_bits, key_primes, &rng);
+  if (!out_data)
+  {
+   fprintf(stderr, "Failed to generate RSA key\n");
+   return 7;
+  }
+  pkc_rsa rsa;
+  if (!rsa.set_private_key(out_data, out_size, nullptr))
+  {
+   fprintf(stderr, "Generated key is not valid\n");
+   return 7;
+  }
+  if (!save_output_file(out_file, out_data, out_size, use_stdout, out_fmt, "RSA PRIVATE KEY")) return 4;
+  operator delete(out_data);
+  puts("Done");
+  return 0;
+ }
  if (!in_file)
  {
   fprintf(stderr, "Use -in-file option to set input file\n");
@@ -499,7 +705,7 @@ int main(int argc, char *argv[])
    return 6;
   }
  }
- printf("Using %d-bit RSA key\n", rsa.get_modulus_bits());
+ printf("Using %d-bit RSA key\n", rsa.get_key_bits());
  std::string pem_type;
  void *in_data = load_input_file(in_file, size, use_stdin, in_fmt, &pem_type);
  if (!in_data) return 3;
@@ -536,7 +742,7 @@ int main(int argc, char *argv[])
    void *out_data;
    size_t out_size;
    init_sign_params(sign_params, sign_param_count, &rng);
-   bool result = sign_certificate(out_data, out_size, in_data, size, rsa, sign_params, sign_param_count);
+   bool result = sign_certificate(out_data, out_size, in_data, size, rsa, sign_params, sign_param_count, &rng);
    cleanup_sign_params(sign_params, sign_param_count);
    if (!result)
    {
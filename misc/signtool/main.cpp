@@ -5,7 +5,10 @@
 #include <crypto/asn1/decoder.h>
 #include <crypto/pkc/pkc_dsa.h>
 #include <crypto/pkc/pkc_ecdsa.h>
+#include <crypto/pkc/pkc_eddsa.h>
 #include <crypto/pkc/pkc_rsa.h>
+#include <crypto/pkc/pkc_x25519.h>
+#include <crypto/pkc/batch_sign.h>
 #include <crypto/rng/std_random.h>
 #include <utils/str_int_cvt.h>
 #include <string.h>
@@ -20,7 +23,8 @@ enum
  ACTION_VERIFY_CERT,
  ACTION_SIGN_CERT,
  ACTION_VERIFY_DATA,
- ACTION_SIGN_DATA
+ ACTION_SIGN_DATA,
+ ACTION_DERIVE
 };
 
 enum
@@ -192,9 +196,10 @@ static bool sign_certificate(void* &out_data, size_t &out_size, const void *data
  return true;
 }
 
-static bool sign_data(void* &out_data, size_t &out_size, const void *data, size_t size,
-                      const pkc_base &pk, const pkc_base::param_data params[], int param_count,
-                      random_gen *rng, int *error)
+// sign_data points to the signature with one spare byte in front of it
+static bool encode_data_signature(void* &out_data, size_t &out_size, uint8_t *sign_data, size_t sign_size,
+                                  const pkc_base &pk, const pkc_base::param_data params[], int param_count,
+                                  int *error)
 {
  asn1::element *el_params = pk.create_params_struct(params, param_count, pkc_base::WHERE_SIGNATURE);
  if (!el_params)
@@ -203,15 +208,6 @@ static bool sign_data(void* &out_data, size_t &out_size, const void *data, size_
   return false;
  }
 
- size_t sign_size = pk.get_max_signature_size();
- uint8_t *sign_data = static_cast<uint8_t*>(alloca(sign_size + 1));
- if (!pk.create_signature(sign_data + 1, sign_size, data, size, params, param_count, rng))
- {
-  asn1::delete_tree(el_params);
-  if (error) *error = ERR_SIGNING_FAILED;
-  return false;
- }
-
  asn1::element *root = asn1::element::create(asn1::TYPE_SEQUENCE);
  root->child = el_params;
  asn1::element *signature = asn1::element::create(asn1::TYPE_BIT_STRING);
@@ -225,6 +221,20 @@ static bool sign_data(void* &out_data, size_t &out_size, const void *data, size_
  return true;
 }
 
+static bool sign_data(void* &out_data, size_t &out_size, const void *data, size_t size,
+                      const pkc_base &pk, const pkc_base::param_data params[], int param_count,
+                      random_gen *rng, int *error)
+{
+ size_t sign_size = pk.get_max_signature_size();
+ uint8_t *sign_data = static_cast<uint8_t*>(alloca(sign_size + 1));
+ if (!pk.create_signature(sign_data + 1, sign_size, data, size, params, param_count, rng))
+ {
+  if (error) *error = ERR_SIGNING_FAILED;
+  return false;
+ }
+ return encode_data_signature(out_data, out_size, sign_data, sign_size, pk, params, param_count, error);
+}
+
 static const struct
 {
  const char *name;
@@ -426,6 +436,7 @@ static pkc_base *create_pkc(int alg)
   case oid::ID_RSA:   return new pkc_rsa;
   case oid::ID_DSA:   return new pkc_dsa;
   case oid::ID_ECDSA: return new pkc_ecdsa;
+  case oid::ID_ED25519: return new pkc_eddsa;
  }
  return nullptr;
 }
@@ -526,7 +537,7 @@ bool load_private_key(pkc_base* &pk, void* &data, const char *filename)
  const char *error = nullptr;
  if (type == "PRIVATE KEY")
  {
-  static const int req_alg_id[] = { oid::ID_RSA, oid::ID_DSA, oid::ID_ECDSA, 0 };
+  static const int req_alg_id[] = { oid::ID_RSA, oid::ID_DSA, oid::ID_ECDSA, oid::ID_ED25519, 0 };
   pkcs8_result pk_res;
   if (decode_pkcs8(pk_res, filename, data, size, req_alg_id))
   {
@@ -587,6 +598,108 @@ static int print_error(int error)
  return 255;
 }
 
+// Signs every file with a pool of threads, the signature of <file> is written to <file>.sig
+static int sign_data_batch(const std::vector<const char*> &files, const pkc_base &pk,
+                           const pkc_base::param_data params[], int param_count, int thread_count)
+{
+ std::vector<pkc_base::data_buffer> in(files.size());
+ for (size_t i = 0; i < files.size(); i++)
+ {
+  int raw_size;
+  void *raw_data = load_file(files[i], raw_size, false);
+  if (!raw_data) return 3;
+  in[i].data = raw_data;
+  in[i].size = raw_size;
+ }
+
+ batch_signer signer(&pk, thread_count);
+ signer.set_params(params, param_count);
+ std::vector<std::vector<uint8_t>> out;
+ signer.sign(out, in);
+ for (size_t i = 0; i < in.size(); i++)
+  operator delete(const_cast<void*>(in[i].data));
+
+ int result = 0;
+ for (size_t i = 0; i < files.size(); i++)
+ {
+  if (out[i].empty())
+  {
+   fprintf(stderr, "%s: ", files[i]);
+   result = print_error(ERR_SIGNING_FAILED);
+   continue;
+  }
+  int error;
+  void *out_data;
+  size_t out_size;
+  out[i].insert(out[i].begin(), 0);
+  if (!encode_data_signature(out_data, out_size, out[i].data(), out[i].size() - 1, pk, params, param_count, &error))
+   return print_error(error);
+  std::string out_file(files[i]);
+  out_file += ".sig";
+  bool saved = save_output_file(out_file.c_str(), out_data, out_size, false, FORMAT_BIN, nullptr);
+  operator delete(out_data);
+  if (!saved) return 4;
+ }
+ if (!result) printf("%d Signatures Created (threads: %d)\n", (int) files.size(), signer.get_thread_count());
+ return result;
+}
+
+static int derive_secret(const char *priv_file, const char *peer_file, const char *out_file)
+{
+ static const int req_alg_id[] = { oid::ID_X25519, 0 };
+ pkc_x25519 key, peer;
+ pkcs8_result pk_res;
+ int size;
+ bool result = false;
+ void *data = load_pem_file(priv_file, size, "PRIVATE KEY");
+ if (!data) return 6;
+ if (decode_pkcs8(pk_res, priv_file, data, size, req_alg_id))
+ {
+  result = key.set_private_key(pk_res.data, pk_res.size, pk_res.params);
+  asn1::delete_tree(pk_res.params);
+  if (!result) fprintf(stderr, "%s: Failed to set private key\n", priv_file);
+ }
+ operator delete(data);
+ if (!result) return 6;
+ printf("%s: Private key loaded\n", priv_file);
+
+ data = load_pem_file(peer_file, size, "PUBLIC KEY");
+ if (!data) return 3;
+ result = false;
+ asn1::element *root = asn1::decode(data, size, 0, nullptr);
+ if (root && root->is_sequence())
+ {
+  const asn1::element *alg_id = root->child;
+  const asn1::element *unknown_oid, *params;
+  int alg;
+  if (parse_alg_id(alg, params, alg_id, unknown_oid) && alg == oid::ID_X25519)
+  {
+   const asn1::element *key_data = alg_id->sibling;
+   if (key_data && key_data->is_aligned_bit_string())
+    result = peer.set_public_key(key_data->data + 1, key_data->size - 1, params);
+  }
+ }
+ asn1::delete_tree(root);
+ operator delete(data);
+ if (!result)
+ {
+  fprintf(stderr, "%s: Failed to load X25519 public key\n", peer_file);
+  return 5;
+ }
+
+ uint8_t secret[pkc_x25519::KEY_SIZE];
+ if (!key.compute_shared_secret(secret, peer))
+ {
+  fprintf(stderr, "Failed to derive shared secret\n");
+  return 7;
+ }
+ puts("Shared Secret Derived");
+ result = save_output_file(out_file, secret, sizeof(secret),
+  out_file == nullptr, out_file == nullptr? FORMAT_HEX : FORMAT_BIN, nullptr);
+ memset(secret, 0, sizeof(secret));
+ return result? 0 : 4;
+}
+
 int main(int argc, char *argv[])
 {
  if (argc < 2)
@@ -599,10 +712,13 @@ int main(int argc, char *argv[])
          "  -sign-cert              Sign X.509 certificate\n"
          "  -verify-data            Verify signature on raw file\n"
          "  -sign-data              Sign raw file\n"
+         "  -derive                 Derive X25519 shared secret with the public key in -in-file\n"
          "  -in-sign <file>         Signature file to use with -verify-data\n"
          "  -param <param>:<value>  Set signature parameters\n"
          "  -in-file  <file>        Read input from file\n"
          "  -out-file <file>        Write output to file (default is stdout)\n"
+         "  -threads <n>            Sign every -in-file with -sign-data using n threads\n"
+         "                          (0 = all CPUs), output goes to <file>.sig\n"
          "\n", argv[0]);
   return 1;
  }
@@ -613,6 +729,8 @@ int main(int argc, char *argv[])
  const char *pub_file = nullptr;
  const char *priv_file = nullptr;
  const char *in_file = nullptr;
+ std::vector<const char*> batch_files;
+ int thread_count = -1;
  const char *out_file = nullptr;
  const char *sign_file = nullptr;
  int action = ACTION_NONE;
@@ -669,6 +787,12 @@ int main(int argc, char *argv[])
    if (action != ACTION_NONE) goto error_inconsistent;
    action = ACTION_VERIFY_DATA;
   } else
+  if (!strcmp(argv[i], "-derive"))
+  {
+   if (action == ACTION_DERIVE) goto error_duplicate;
+   if (action != ACTION_NONE) goto error_inconsistent;
+   action = ACTION_DERIVE;
+  } else
   if (!strcmp(argv[i], "-param"))
   {
    if (i == last_arg) goto error_arg_required;
@@ -677,8 +801,22 @@ int main(int argc, char *argv[])
   if (!strcmp(argv[i], "-in-file"))
   {
    if (i == last_arg) goto error_arg_required;
-   if (in_file) goto error_duplicate;
    in_file = argv[++i];
+   batch_files.push_back(in_file);
+  } else
+  if (!strcmp(argv[i], "-threads"))
+  {
+   if (i == last_arg) goto error_arg_required;
+   if (thread_count >= 0) goto error_duplicate;
+   bool ok;
+   int pos = 0;
+   uint32_t value = str_to_uint32(argv[++i], &pos, &ok);
+   if (!ok || value > 1024)
+   {
+    fprintf(stderr, "%s: bad number of threads\n", argv[i-1]);
+    return 2;
+   }
+   thread_count = value;
   } else
   if (!strcmp(argv[i], "-out-file"))
   {
@@ -707,6 +845,29 @@ int main(int argc, char *argv[])
   fprintf(stderr, "Use -in-file option to set input file\n");
   return 2;
  }
+ if (thread_count >= 0)
+ {
+  if (action != ACTION_SIGN_DATA || out_file)
+  {
+   fprintf(stderr, "Option -threads can only be used with -sign-data and without -out-file\n");
+   return 2;
+  }
+ } else
+ if (batch_files.size() > 1)
+ {
+  fprintf(stderr, "Use -threads to sign several files\n");
+  return 2;
+ }
+
+ if (action == ACTION_DERIVE)
+ {
+  if (!priv_file || pub_file)
+  {
+   fprintf(stderr, "Use -load-priv to load X25519 private key\n");
+   return 2;
+  }
+  return derive_secret(priv_file, in_file, out_file);
+ }
 
  bool have_private_key = false;
  pkc_base *pk = nullptr;
@@ -752,6 +913,13 @@ int main(int argc, char *argv[])
   if (!save_output_file(out_file, out_data, out_size,
    out_file == nullptr, FORMAT_BASE64, "CERTIFICATE")) return 4;
  } else
+ if (action == ACTION_SIGN_DATA && thread_count >= 0)
+ {
+  init_sign_params(sign_params, sign_param_count, &rng);
+  int result = sign_data_batch(batch_files, *pk, sign_params, sign_param_count, thread_count);
+  cleanup_sign_params(sign_params, sign_param_count);
+  if (result) return result;
+ } else
  if (action == ACTION_SIGN_DATA)
  {
   int error, raw_size;
@@ -0,0 +1,83 @@
+#ifndef __platform_thread_h__
+#define __platform_thread_h__
+
+#ifdef _WIN32
+
+#include "win.h"
+
+#ifdef __cplusplus
+namespace platform
+{
+#endif
+
+typedef HANDLE thread_t;
+typedef DWORD thread_result_t;
+#define THREAD_CALL WINAPI
+
+typedef thread_result_t (THREAD_CALL *thread_func_t)(void *arg);
+
+static __inline int thread_create(thread_t *t, thread_func_t func, void *arg)
+{
+ *t = CreateThread(NULL, 0, func, arg, 0, NULL);
+ return *t? 0 : -1;
+}
+
+static __inline void thread_join(thread_t *t)
+{
+ WaitForSingleObject(*t, INFINITE);
+ CloseHandle(*t);
+}
+
+static __inline int get_cpu_count()
+{
+ SYSTEM_INFO si;
+ GetSystemInfo(&si);
+ return si.dwNumberOfProcessors;
+}
+
+#ifdef __cplusplus
+} /* end namespace */
+#endif
+
+#else
+
+#include <pthread.h>
+#include <unistd.h>
+#include <assert.h>
+
+#ifdef __cplusplus
+namespace platform
+{
+#endif
+
+typedef pthread_t thread_t;
+typedef void *thread_result_t;
+#define THREAD_CALL
+
+typedef thread_result_t (THREAD_CALL *thread_func_t)(void *arg);
+
+static __inline int thread_create(thread_t *t, thread_func_t func, void *arg)
+{
+ return pthread_create(t, 0, func, arg);
+}
+
+static __inline void thread_join(thread_t *t)
+{
+ int result = pthread_join(*t, 0);
+ assert(result == 0);
+ (void) result;
+}
+
+static __inline int get_cpu_count()
+{
+ long result = sysconf(_SC_NPROCESSORS_ONLN);
+ return result > 0? (int) result : 1;
+}
+
+#ifdef __cplusplus
+} /* end namespace */
+#endif
+
+#endif
+
+#endif /* __platform_thread_h__ */
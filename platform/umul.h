@@ -0,0 +1,45 @@
+#ifndef __platform_umul_h__
+#define __platform_umul_h__
+
+#include <stdint.h>
+#include "word.h"
+
+#if defined(_MSC_VER) && defined(ENV_64BIT)
+#include <intrin.h>
+#endif
+
+/* 64x64 -> 128 bit multiplication, returns the low part */
+static __inline uint64_t umul64(uint64_t *hi, uint64_t a, uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+ unsigned __int128 r = (unsigned __int128) a * b;
+ *hi = (uint64_t) (r >> 64);
+ return (uint64_t) r;
+#elif defined(_MSC_VER) && defined(ENV_64BIT)
+ return _umul128(a, b, hi);
+#else
+ uint64_t a0 = (uint32_t) a, a1 = a >> 32;
+ uint64_t b0 = (uint32_t) b, b1 = b >> 32;
+ uint64_t p00 = a0 * b0;
+ uint64_t p01 = a0 * b1;
+ uint64_t p10 = a1 * b0;
+ uint64_t p11 = a1 * b1;
+ uint64_t mid = (p00 >> 32) + (uint32_t) p01 + (uint32_t) p10;
+ *hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+ return (mid << 32) | (uint32_t) p00;
+#endif
+}
+
+/* word x word -> double word multiplication, returns the low part */
+static __inline sys_word_t umulw(sys_word_t *hi, sys_word_t a, sys_word_t b)
+{
+#ifdef ENV_64BIT
+ return umul64(hi, a, b);
+#else
+ uint64_t r = (uint64_t) a * b;
+ *hi = (sys_word_t) (r >> 32);
+ return (sys_word_t) r;
+#endif
+}
+
+#endif /* __platform_umul_h__ */